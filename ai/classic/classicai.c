@@ -151,6 +151,16 @@ static void cai_city_alloc(struct city *pcity)
   dai_city_alloc(deftype, pcity);
 }
 
+/**************************************************************************
+  Call default ai with classic ai type as parameter.
+**************************************************************************/
+static void cai_tile_changed(struct tile *ptile)
+{
+  struct ai_type *deftype = classic_ai_get_self();
+
+  dai_settler_tile_changed(deftype, ptile);
+}
+
 /**************************************************************************
   Call default ai with classic ai type as parameter.
 **************************************************************************/
@@ -533,6 +543,7 @@ bool fc_ai_classic_setup(struct ai_type *ai)
     ai->funcs.city_got = NULL;
     ai->funcs.city_lost = NULL;
   */
+  ai->funcs.tile_changed = cai_tile_changed;
   ai->funcs.city_save = cai_city_save;
   ai->funcs.city_load = cai_city_load;
   ai->funcs.choose_building = cai_build_adv_override;
@@ -59,8 +59,227 @@
 
 #include "advmilitary.h"
 
+/* struct threat_map_hash: the threats of the units of one player, keyed
+ * by THREAT_MAP_KEY(). Each entry holds the turns the unit needs to reach
+ * the destinations of the cache, -1 if it cannot get there. */
+#define SPECHASH_TAG threat_map
+#define SPECHASH_KEY_TYPE int
+#define SPECHASH_DATA_TYPE int *
+#define SPECHASH_KEY_TO_PTR FC_INT_TO_PTR
+#define SPECHASH_PTR_TO_KEY FC_PTR_TO_INT
+#define SPECHASH_DATA_FREE free
+#include "spechash.h"
+
+#define THREAT_MAP_KEY(ptype, ptile) \
+  (tile_index(ptile) * U_LAST + utype_index(ptype))
+
+/* How far enemy units get within a few turns. Units of the same type
+ * standing on the same tile share one path finding map, which is run once
+ * for all the cities assess_danger() looks at while the cache is alive. */
+struct dai_threat_cache {
+  int max_turns;
+  int num_dests;
+  struct tile **dests;                  /* Tiles of the cities. */
+  struct threat_map_hash **maps;        /* Indexed by player slot. */
+};
+
 static unsigned int assess_danger(struct ai_type *ait, struct city *pcity);
 
+/****************************************************************************
+  Move costs for the threat maps. Same rules as the reverse maps of
+  pf_reverse_map_new(), but iterated forward from the unit: the
+  destination tile must be native (or a city), unknown tiles cost a single
+  move and the maps are cut at 'max_turns' turns.
+****************************************************************************/
+static int threat_map_get_costs(const struct tile *from_tile,
+                                enum direction8 dir,
+                                const struct tile *to_tile,
+                                int from_cost, int from_extra,
+                                int *to_cost, int *to_extra,
+                                const struct pf_parameter *param)
+{
+  int cost;
+
+  if (!param->omniscience
+      && TILE_UNKNOWN == tile_get_known(to_tile, param->owner)) {
+    cost = SINGLE_MOVE;
+  } else if (!is_native_tile_to_class(param->uclass, to_tile)
+             && !tile_city(to_tile)) {
+    return -1;  /* Impossible move. */
+  } else if (BV_ISSET(param->unit_flags, UTYF_IGTER)) {
+    cost = MIN(map_move_cost(param->owner, param->uclass, from_tile, to_tile),
+               SINGLE_MOVE);
+  } else {
+    cost = map_move_cost(param->owner, param->uclass, from_tile, to_tile);
+  }
+
+  cost += from_cost;
+  if (cost > FC_PTR_TO_INT(param->data)) {
+    return -1;  /* We reached the maximum we wanted. */
+  } else if (*to_cost != PF_IMPOSSIBLE_MC && cost >= *to_cost) {
+    return -1;  /* No improvement. */
+  }
+
+  /* Ordering by the total cost makes the iteration a plain Dijkstra
+   * search, so the costs are exact. */
+  *to_cost = cost;
+  return cost;
+}
+
+/****************************************************************************
+  Create an empty cache of threats against the cities of 'pplayer', or
+  only against 'pcity' if it is not NULL. The maps are cut at 'max_turns'
+  turns.
+****************************************************************************/
+static struct dai_threat_cache *threat_cache_new(const struct player *pplayer,
+                                                 const struct city *pcity,
+                                                 int max_turns)
+{
+  struct dai_threat_cache *cache = fc_malloc(sizeof(*cache));
+
+  cache->max_turns = max_turns;
+  if (NULL != pcity) {
+    cache->num_dests = 1;
+    cache->dests = fc_malloc(sizeof(*cache->dests));
+    cache->dests[0] = city_tile(pcity);
+  } else {
+    int i = 0;
+
+    cache->num_dests = city_list_size(pplayer->cities);
+    cache->dests = fc_malloc(MAX(1, cache->num_dests)
+                             * sizeof(*cache->dests));
+    city_list_iterate(pplayer->cities, acity) {
+      cache->dests[i++] = city_tile(acity);
+    } city_list_iterate_end;
+  }
+  cache->maps = fc_calloc(player_slot_count(), sizeof(*cache->maps));
+
+  return cache;
+}
+
+/****************************************************************************
+  Return the index of 'ptile' among the destinations of the cache, or -1.
+****************************************************************************/
+static int threat_cache_dest(const struct dai_threat_cache *cache,
+                             const struct tile *ptile)
+{
+  int i;
+
+  for (i = 0; i < cache->num_dests; i++) {
+    if (cache->dests[i] == ptile) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+/****************************************************************************
+  Free a threat map cache.
+****************************************************************************/
+static void threat_cache_destroy(struct dai_threat_cache *cache)
+{
+  int i;
+
+  for (i = 0; i < player_slot_count(); i++) {
+    if (NULL != cache->maps[i]) {
+      threat_map_hash_destroy(cache->maps[i]);
+    }
+  }
+  free(cache->maps);
+  free(cache->dests);
+  free(cache);
+}
+
+/****************************************************************************
+  Return the number of turns a unit of 'ptype' owned by 'pplayer' standing
+  on 'src' needs to reach the destination 'dest_idx' of the cache, or -1
+  if it cannot get there within the turns of the cache.
+****************************************************************************/
+static int threat_cache_turns(struct dai_threat_cache *cache,
+                              const struct player *pplayer,
+                              const struct unit_type *ptype,
+                              struct tile *src, int dest_idx)
+{
+  struct threat_map_hash **phash = cache->maps + player_index(pplayer);
+  int key = THREAT_MAP_KEY(ptype, src);
+  int *turns;
+
+  if (NULL == *phash) {
+    *phash = threat_map_hash_new();
+  }
+
+  if (!threat_map_hash_lookup(*phash, key, &turns)) {
+    struct pf_parameter param;
+    struct pf_map *pfm;
+    struct pf_position pos;
+    int i;
+
+    memset(&param, 0, sizeof(param));
+    param.get_costs = threat_map_get_costs;
+    param.start_tile = src;
+    param.owner = pplayer;
+    param.omniscience = !ai_handicap(pplayer, H_MAP);
+    param.fuel = 1;
+    param.fuel_left_initially = 1;
+    param.uclass = utype_class(ptype);
+    param.unit_flags = ptype->flags;
+    param.move_rate = ptype->move_rate;
+    param.moves_left_initially = ptype->move_rate;
+    param.data = FC_INT_TO_PTR(0 <= cache->max_turns
+                               && FC_INFINITY > cache->max_turns
+                               ? cache->max_turns * ptype->move_rate
+                               : FC_INFINITY);
+    pfm = pf_map_new(&param);
+
+    /* The map is short lived, only the result for the cities is kept. */
+    turns = fc_malloc(MAX(1, cache->num_dests) * sizeof(*turns));
+    for (i = 0; i < cache->num_dests; i++) {
+      turns[i] = (pf_map_position(pfm, cache->dests[i], &pos)
+                  ? pos.turn : -1);
+    }
+    pf_map_destroy(pfm);
+    threat_map_hash_insert(*phash, key, turns);
+  }
+
+  return turns[dest_idx];
+}
+
+/****************************************************************************
+  Returns the number of turns assess_danger() looks ahead for the cities
+  of pplayer.
+****************************************************************************/
+static int assess_danger_turns(const struct player *pplayer)
+{
+  return player_is_cpuhog(pplayer) ? 6 : 3;
+}
+
+/****************************************************************************
+  Start a batch of assess_danger() calls for the cities of pplayer. Until
+  dai_assess_danger_end(), how far the enemy units get is computed only
+  once for all the cities. Enemy units must not move in between.
+****************************************************************************/
+void dai_assess_danger_begin(struct ai_type *ait, struct player *pplayer)
+{
+  struct ai_plr *ai = def_ai_player_data(pplayer, ait);
+
+  fc_assert_ret(NULL == ai->threats);
+  ai->threats = threat_cache_new(pplayer, NULL,
+                                 assess_danger_turns(pplayer));
+}
+
+/****************************************************************************
+  Finish the batch started by dai_assess_danger_begin().
+****************************************************************************/
+void dai_assess_danger_end(struct ai_type *ait, struct player *pplayer)
+{
+  struct ai_plr *ai = def_ai_player_data(pplayer, ait);
+
+  fc_assert_ret(NULL != ai->threats);
+  threat_cache_destroy(ai->threats);
+  ai->threats = NULL;
+}
+
 /**************************************************************************
   Choose the best unit the city can build to defend against attacker v.
 **************************************************************************/
@@ -326,16 +545,16 @@ static int assess_defense_igwall(struct ai_type *ait, struct city *pcity)
   How dangerous and far a unit is for a city?
 ****************************************************************************/
 static unsigned int assess_danger_unit(const struct city *pcity,
-                                       struct pf_reverse_map *pcity_map,
+                                       struct dai_threat_cache *cache,
+                                       int dest_idx,
                                        const struct unit *punit,
                                        int *move_time)
 {
-  struct pf_position pos;
   const struct unit_type *punittype = unit_type(punit);
   const struct tile *ptile = city_tile(pcity);
   const struct unit *ferry;
   unsigned int danger;
-  int mod;
+  int mod, turns;
 
   *move_time = PF_IMPOSSIBLE_MC;
 
@@ -345,18 +564,22 @@ static unsigned int assess_danger_unit(const struct city *pcity,
                   / punittype->paratroopers_range);
   }
 
-  if (pf_reverse_map_unit_position(pcity_map, punit, &pos)
+  turns = threat_cache_turns(cache, unit_owner(punit), punittype,
+                             unit_tile(punit), dest_idx);
+  if (0 <= turns
       && (PF_IMPOSSIBLE_MC == *move_time
-          || *move_time > pos.turn)) {
-    *move_time = pos.turn;
+          || *move_time > turns)) {
+    *move_time = turns;
   }
 
   if (unit_transported(punit)
       && (ferry = unit_transport_get(punit))
-      && pf_reverse_map_unit_position(pcity_map, ferry, &pos)) {
+      && 0 <= (turns = threat_cache_turns(cache, unit_owner(ferry),
+                                          unit_type(ferry),
+                                          unit_tile(ferry), dest_idx))) {
     if ((PF_IMPOSSIBLE_MC == *move_time
-         || *move_time > pos.turn)) {
-      *move_time = pos.turn;
+         || *move_time > turns)) {
+      *move_time = turns;
       if (!can_attack_from_non_native(punittype)) {
         (*move_time)++;
       }
@@ -389,9 +612,11 @@ void dai_assess_danger_player(struct ai_type *ait, struct player *pplayer)
 {
   /* Do nothing if game is not running */
   if (S_S_RUNNING == server_state()) {
+    dai_assess_danger_begin(ait, pplayer);
     city_list_iterate(pplayer->cities, pcity) {
       (void) assess_danger(ait, pcity);
     } city_list_iterate_end;
+    dai_assess_danger_end(ait, pplayer);
   }
 }
 
@@ -464,7 +689,9 @@ static unsigned int assess_danger(struct ai_type *ait, struct city *pcity)
   int total_danger = 0;
   int defense_bonuses[U_LAST];
   bool defender_type_handled[U_LAST];
-  int assess_turns;
+  struct dai_threat_cache *cache = def_ai_player_data(pplayer, ait)->threats;
+  bool own_cache = FALSE;
+  int dest_idx = -1;
 
   TIMING_LOG(AIT_DANGER, TIMER_START);
 
@@ -511,30 +738,31 @@ static unsigned int assess_danger(struct ai_type *ait, struct city *pcity)
     }
   } unit_list_iterate_end;
 
-  if (player_is_cpuhog(pplayer)) {
-    assess_turns = 6;
-  } else {
-    assess_turns = 3;
+  if (NULL != cache) {
+    dest_idx = threat_cache_dest(cache, city_tile(pcity));
+  }
+  if (0 > dest_idx) {
+    /* Not called between dai_assess_danger_begin() and _end(), or for a
+     * city the batch does not know about. */
+    cache = threat_cache_new(pplayer, pcity, assess_danger_turns(pplayer));
+    own_cache = TRUE;
+    dest_idx = 0;
   }
 
   /* Check. */
   players_iterate(aplayer) {
-    struct pf_reverse_map *pcity_map;
-
     if (!adv_is_player_dangerous(pplayer, aplayer)) {
       continue;
     }
     /* Note that we still consider the units of players we are not (yet)
      * at war with. */
 
-    pcity_map = pf_reverse_map_new_for_city(pcity, aplayer, assess_turns);
-
     unit_list_iterate(aplayer->units, punit) {
       int move_time;
       unsigned int vulnerability;
       int defbonus = defense_bonuses[utype_index(unit_type(punit))];
 
-      vulnerability = assess_danger_unit(pcity, pcity_map,
+      vulnerability = assess_danger_unit(pcity, cache, dest_idx,
                                          punit, &move_time);
 
       if (PF_IMPOSSIBLE_MC == move_time) {
@@ -601,11 +829,12 @@ static unsigned int assess_danger(struct ai_type *ait, struct city *pcity)
 
       total_danger += vulnerability;
     } unit_list_iterate_end;
-
-    pf_reverse_map_destroy(pcity_map);
-
   } players_iterate_end;
 
+  if (own_cache) {
+    threat_cache_destroy(cache);
+  }
+
   if (0 == igwall_threat) {
     city_data->wallvalue = 90;
   } else if (total_danger) {
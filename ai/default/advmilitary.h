@@ -24,6 +24,8 @@ void  military_advisor_choose_build(struct ai_type *ait,
                                     struct player *pplayer, struct city *pcity,
 				    struct adv_choice *choice);
 void dai_assess_danger_player(struct ai_type *ait, struct player *pplayer);
+void dai_assess_danger_begin(struct ai_type *ait, struct player *pplayer);
+void dai_assess_danger_end(struct ai_type *ait, struct player *pplayer);
 int assess_defense_quadratic(struct ai_type *ait, struct city *pcity);
 int assess_defense_unit(struct ai_type *ait, struct city *pcity,
                         struct unit *punit, bool igwall);
@@ -19,6 +19,7 @@
 #include <math.h> /* pow */
 
 /* utility */
+#include "mem.h"
 #include "rand.h"
 #include "registry.h"
 
@@ -98,6 +99,9 @@
  (pcity->surplus[O_SHIELD] < 0 || city_unhappy(pcity)			\
   || pcity->food_stock + pcity->surplus[O_FOOD] < 0)
 
+static struct fc_mem_pool ai_city_pool =
+  FC_MEM_POOL_INIT("ai_city", sizeof(struct ai_city));
+
 #ifdef NDEBUG
 #define ASSERT_CHOICE(c) /* Do nothing. */
 #else
@@ -767,6 +771,7 @@ void dai_manage_cities(struct ai_type *ait, struct player *pplayer)
 
   /* Initialize the infrastructure cache, which is used shortly. */
   initialize_infrastructure_cache(pplayer);
+  dai_assess_danger_begin(ait, pplayer);
   city_list_iterate(pplayer->cities, pcity) {
     struct ai_city *city_data = def_ai_city_data(pcity, ait);
     /* Note that this function mungs the seamap, but we don't care */
@@ -802,6 +807,7 @@ void dai_manage_cities(struct ai_type *ait, struct player *pplayer)
     TIMING_LOG(AIT_CITY_SETTLERS, TIMER_STOP);
     ASSERT_CHOICE(city_data->choice);
   } city_list_iterate_end;
+  dai_assess_danger_end(ait, pplayer);
   /* Reset auto settler state for the next run. */
   dai_auto_settler_reset(ait, pplayer);
 
@@ -940,7 +946,7 @@ static void resolve_city_emergency(struct ai_type *ait, struct player *pplayer,
 **************************************************************************/
 void dai_city_alloc(struct ai_type *ait, struct city *pcity)
 {
-  struct ai_city *city_data = fc_calloc(1, sizeof(struct ai_city));
+  struct ai_city *city_data = fc_mem_pool_alloc(&ai_city_pool);
 
   city_data->building_wait = BUILDING_WAIT_MINIMUM;
 
@@ -956,7 +962,7 @@ void dai_city_free(struct ai_type *ait, struct city *pcity)
 
   if (city_data != NULL) {
     city_set_ai_data(pcity, ait, NULL);
-    FC_FREE(city_data);
+    fc_mem_pool_free(&ai_city_pool, city_data);
   }
 }
 
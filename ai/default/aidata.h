@@ -90,6 +90,10 @@ struct ai_plr
 
   /* Cache map for AI settlers; defined in aisettler.c. */
   struct ai_settler *settler;
+
+  /* Threat maps of enemy units, valid between dai_assess_danger_begin()
+   * and dai_assess_danger_end(); defined in advmilitary.c. */
+  struct dai_threat_cache *threats;
 };
 
 void dai_data_init(struct ai_type *ait, struct player *pplayer);
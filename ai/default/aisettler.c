@@ -144,9 +144,28 @@ static void tile_data_cache_destroy(struct tile_data_cache *ptdc);
 #define SPECHASH_DATA_FREE tile_data_cache_destroy
 #include "spechash.h"
 
+/* Values of the site value raster. Anything >= 0 is the unit-independent
+ * want for a city at that tile (see site_value()). */
+#define SITE_UNKNOWN -2   /* not evaluated yet */
+#define SITE_NONE    -1   /* no city possible or wanted here */
+
+/* Number of the best sites of a settler search that are remembered, so
+ * that another one can be taken when the raster value of the best turns
+ * out to be stale. */
+#define SITE_CANDIDATES 4
+
 struct ai_settler {
   struct tile_data_cache_hash *tdc_hash;
 
+  /* Site value raster, indexed by tile index. It is rebuilt when the turn
+   * or the citymap (see citymap_get_serial()) changes, and cleared around
+   * tiles where reservations or cities change in between. */
+  struct {
+    int *value;
+    int turn;
+    int citymap_serial;
+  } sites;
+
 #ifdef DEBUG
   struct {
     int hit;
@@ -154,6 +173,11 @@ struct ai_settler {
     int miss;
     int save;
   } cache;
+
+  struct {
+    int hit;
+    int miss;
+  } sites_stats;
 #endif /* DEBUG */
 };
 
@@ -205,6 +229,13 @@ static int defense_bonus(struct player *pplayer,
 static int naval_bonus(const struct cityresult *result);
 static void print_cityresult(struct player *pplayer,
                              const struct cityresult *cr);
+static struct cityresult *cityresult_evaluate(struct ai_type *ait,
+                                              struct player *pplayer,
+                                              struct tile *ptile);
+static bool site_available(struct player *pplayer, struct unit *punit,
+                           struct tile *ptile);
+static int site_value(struct ai_type *ait, struct player *pplayer,
+                      struct tile *ptile);
 struct cityresult *city_desirability(struct ai_type *ait,
                                      struct player *pplayer,
                                      struct unit *punit, struct tile *ptile);
@@ -708,54 +739,60 @@ static void print_cityresult(struct player *pplayer,
 }
 
 /*****************************************************************************
-  Calculates the desire for founding a new city at 'ptile'. The citymap
-  ensures that we do not build cities too close to each other. Returns NULL
-  if no place was found.
+  Check the conditions for founding a city at 'ptile' that depend on the
+  unit or change while the settlers of a player are moved. These are not
+  part of the site value raster.
 *****************************************************************************/
-struct cityresult *city_desirability(struct ai_type *ait, struct player *pplayer,
-                                     struct unit *punit, struct tile *ptile)
+static bool site_available(struct player *pplayer, struct unit *punit,
+                           struct tile *ptile)
 {
   struct city *pcity = tile_city(ptile);
-  struct adv_data *ai = adv_data_get(pplayer, NULL);
-  struct cityresult *cr = NULL;
-
-  fc_assert_ret_val(punit, NULL);
-  fc_assert_ret_val(pplayer, NULL);
-  fc_assert_ret_val(ai, NULL);
 
   if (!city_can_be_built_here(ptile, punit)
       || (ai_handicap(pplayer, H_MAP)
           && !map_is_known(ptile, pplayer))) {
-    return NULL;
+    return FALSE;
   }
 
   /* Check if another settler has taken a spot within mindist */
   square_iterate(ptile, game.info.citymindist-1, tile1) {
     if (citymap_is_reserved(tile1)) {
-      return NULL;
+      return FALSE;
     }
   } square_iterate_end;
 
   if (adv_danger_at(punit, ptile)) {
-    return NULL;
+    return FALSE;
   }
 
   if (pcity && (city_size_get(pcity) + unit_pop_value(punit)
                 > game.info.add_to_size_limit)) {
     /* Can't exceed population limit. */
-    return NULL;
+    return FALSE;
   }
 
   if (!pcity && citymap_is_reserved(ptile)) {
-    return NULL; /* reserved, go away */
+    return FALSE; /* reserved, go away */
   }
 
   /* If (x, y) is an existing city, consider immigration */
   if (pcity && city_owner(pcity) == pplayer) {
-    return NULL;
+    return FALSE;
   }
 
-  cr = cityresult_fill(ait, pplayer, ptile); /* Burn CPU, burn! */
+  return TRUE;
+}
+
+/*****************************************************************************
+  Evaluate a city at 'ptile' regardless of which unit would found it.
+  Returns NULL if the spot would starve.
+*****************************************************************************/
+static struct cityresult *cityresult_evaluate(struct ai_type *ait,
+                                              struct player *pplayer,
+                                              struct tile *ptile)
+{
+  struct cityresult *cr = cityresult_fill(ait, pplayer, ptile); /* Burn CPU, burn! */
+
   if (!cr) {
     /* Failed to find a good spot */
     return NULL;
@@ -779,6 +816,126 @@ struct cityresult *city_desirability(struct ai_type *ait, struct player *pplayer
   return cr;
 }
 
+/*****************************************************************************
+  Return the value of 'ptile' in the player's site value raster, i.e. the
+  'total' of cityresult_evaluate(), or SITE_NONE. The raster is shared by
+  all settlers (real and virtual) of the player, so each tile is evaluated
+  at most once per turn unless something changes nearby.
+*****************************************************************************/
+static int site_value(struct ai_type *ait, struct player *pplayer,
+                      struct tile *ptile)
+{
+  struct ai_settler *settler = def_ai_player_data(pplayer, ait)->settler;
+  int tindex = tile_index(ptile);
+
+  if (settler->sites.value == NULL
+      || settler->sites.turn != game.info.turn
+      || settler->sites.citymap_serial != citymap_get_serial()) {
+    int i;
+
+    settler->sites.value = fc_realloc(settler->sites.value,
+                                      MAP_INDEX_SIZE
+                                      * sizeof(*settler->sites.value));
+    for (i = 0; i < MAP_INDEX_SIZE; i++) {
+      settler->sites.value[i] = SITE_UNKNOWN;
+    }
+    settler->sites.turn = game.info.turn;
+    settler->sites.citymap_serial = citymap_get_serial();
+  }
+
+  if (settler->sites.value[tindex] == SITE_UNKNOWN) {
+    struct cityresult *cr = cityresult_evaluate(ait, pplayer, ptile);
+
+    if (cr != NULL) {
+      settler->sites.value[tindex] = cr->total;
+      cityresult_destroy(cr);
+    } else {
+      settler->sites.value[tindex] = SITE_NONE;
+    }
+#ifdef DEBUG
+    settler->sites_stats.miss++;
+  } else {
+    settler->sites_stats.hit++;
+#endif /* DEBUG */
+  }
+
+  return settler->sites.value[tindex];
+}
+
+/*****************************************************************************
+  Forget the site values that may depend on 'ptile', because a reservation,
+  a worked tile or a city changed there. If 'ptile' is NULL the whole site
+  value raster is cleared.
+*****************************************************************************/
+void dai_settler_sites_invalidate(struct ai_type *ait, struct player *pplayer,
+                                  struct tile *ptile)
+{
+  struct ai_plr *ai = def_ai_player_data(pplayer, ait);
+  int *value;
+
+  fc_assert_ret(ai != NULL && ai->settler != NULL);
+
+  value = ai->settler->sites.value;
+  if (value == NULL
+      || ai->settler->sites.turn != game.info.turn
+      || ai->settler->sites.citymap_serial != citymap_get_serial()) {
+    /* Rebuilt on next use anyway. */
+    return;
+  }
+
+  if (ptile == NULL) {
+    /* Rebuild on next use. */
+    ai->settler->sites.turn = -1;
+    return;
+  }
+
+  /* A change at 'ptile' can affect the city map of every site within
+   * reach of a city radius, be it its own or the one of the
+   * reservation around it. */
+  square_iterate(ptile, 2 * CITY_MAP_MAX_RADIUS, ptile1) {
+    value[tile_index(ptile1)] = SITE_UNKNOWN;
+  } square_iterate_end;
+}
+
+/*****************************************************************************
+  Forget the site values of all players that may depend on 'ptile',
+  because its owner changed or a city was founded on it or removed from
+  it. This catches the changes made by other players, which
+  dai_settler_sites_invalidate() calls of the own settlers and cities
+  don't see.
+*****************************************************************************/
+void dai_settler_tile_changed(struct ai_type *ait, struct tile *ptile)
+{
+  players_iterate(pplayer) {
+    struct ai_plr *ai = def_ai_player_data(pplayer, ait);
+
+    if (ai != NULL && ai->settler != NULL) {
+      dai_settler_sites_invalidate(ait, pplayer, ptile);
+    }
+  } players_iterate_end;
+}
+
+/*****************************************************************************
+  Calculates the desire for founding a new city at 'ptile'. The citymap
+  ensures that we do not build cities too close to each other. Returns NULL
+  if no place was found.
+*****************************************************************************/
+struct cityresult *city_desirability(struct ai_type *ait, struct player *pplayer,
+                                     struct unit *punit, struct tile *ptile)
+{
+  struct adv_data *ai = adv_data_get(pplayer, NULL);
+
+  fc_assert_ret_val(punit, NULL);
+  fc_assert_ret_val(pplayer, NULL);
+  fc_assert_ret_val(ai, NULL);
+
+  if (!site_available(pplayer, punit, ptile)) {
+    return NULL;
+  }
+
+  return cityresult_evaluate(ait, pplayer, ptile);
+}
+
 /**************************************************************************
   Find nearest and best city placement in a PF iteration according to 
   "parameter".  The value in "boat_cost" is both the penalty to pay for 
@@ -788,6 +945,11 @@ struct cityresult *city_desirability(struct ai_type *ait, struct player *pplayer
   Return value is a 'struct cityresult' if found something better than what
   was originally in "best" was found; else NULL.
 
+  The tiles are rated with the site value raster, only the winner gets a
+  full city_desirability() evaluation. If that fails because its raster
+  value was stale, the value is forgotten and the next best of the
+  SITE_CANDIDATES best tiles is tried.
+
   TODO: Transparently check if we should add ourselves to an existing city.
 **************************************************************************/
 static struct cityresult *settler_map_iterate(struct ai_type *ait,
@@ -795,14 +957,23 @@ static struct cityresult *settler_map_iterate(struct ai_type *ait,
                                               struct unit *punit,
                                               int boat_cost)
 {
-  struct cityresult *cr = NULL, *best = NULL;
+  struct cityresult *best = NULL;
+  struct tile *best_tile = NULL;
+  int best_result = 0;
   int best_turn = 0; /* Which turn we found the best fit */
+  int cost = unit_build_shield_cost(punit) + boat_cost;
   struct player *pplayer = unit_owner(punit);
+  struct ai_settler *settler = def_ai_player_data(pplayer, ait)->settler;
+  struct {
+    struct tile *tile;
+    int result;
+  } candidates[SITE_CANDIDATES]; /* best first */
+  int num_candidates = 0, i;
   struct pf_map *pfm;
 
   pfm = pf_map_new(parameter);
   pf_map_move_costs_iterate(pfm, ptile, move_cost, FALSE) {
-    int turns;
+    int turns, value, result;
 
     if (boat_cost == 0 && unit_class(punit)->adv.sea_move == MOVE_NONE
         && tile_continent(ptile) != tile_continent(unit_tile(punit))) {
@@ -821,45 +992,55 @@ static struct cityresult *settler_map_iterate(struct ai_type *ait,
     }
 
     /* Calculate worth */
-    cr = city_desirability(ait, pplayer, punit, ptile);
+    if (!site_available(pplayer, punit, ptile)) {
+      continue;
+    }
+    value = site_value(ait, pplayer, ptile);
 
     /* Check if actually found something */
-    if (!cr) {
+    if (value == SITE_NONE) {
       continue;
     }
 
     /* This algorithm punishes long treks */
     turns = move_cost / parameter->move_rate;
-    cr->result = amortize(cr->total, PERFECTION * turns);
+    result = amortize(value, PERFECTION * turns);
 
     /* Reduce want by settler cost. Easier than amortize, but still
      * weeds out very small wants. ie we create a threshold here. */
     /* We also penalise here for using a boat (either virtual or real)
      * it's crude but what isn't? */
-    cr->result -= unit_build_shield_cost(punit) + boat_cost;
+    result -= cost;
+
+    /* Remember the best spots; of equal ones the first. */
+    if (result > 0
+        && (num_candidates < SITE_CANDIDATES
+            || result > candidates[SITE_CANDIDATES - 1].result)) {
+      if (num_candidates < SITE_CANDIDATES) {
+        num_candidates++;
+      }
+      for (i = num_candidates - 1;
+           i > 0 && result > candidates[i - 1].result; i--) {
+        candidates[i] = candidates[i - 1];
+      }
+      candidates[i].tile = ptile;
+      candidates[i].result = result;
+    }
 
     /* Find best spot */
-    if ((!best && cr->result > 0)
-        || (best && cr->result > best->result)) {
-      /* Destroy the old 'best' value. */
-      cityresult_destroy(best);
-      /* save the new 'best' value. */
-      best = cr;
-      cr = NULL;
+    if (result > best_result) {
+      best_tile = ptile;
+      best_result = result;
       best_turn = turns;
 
       log_debug("settler map search (search): (%d,%d) %d",
-                TILE_XY(best->tile), best->result);
-    } else {
-      /* Destroy the unused result. */
-      cityresult_destroy(cr);
-      cr = NULL;
+                TILE_XY(best_tile), best_result);
     }
 
     /* Can we terminate early? We have a 'good enough' spot, and
      * we don't block the establishment of a better city just one
      * further step away. */
-    if (best && best->result > RESULT_IS_ENOUGH
+    if (best_tile && best_result > RESULT_IS_ENOUGH
         && turns > parameter->move_rate /* sic -- yeah what an explanation! */
         && best_turn < turns /*+ game.info.min_dist_bw_cities*/) {
       break;
@@ -868,6 +1049,20 @@ static struct cityresult *settler_map_iterate(struct ai_type *ait,
 
   pf_map_destroy(pfm);
 
+  fc_assert(NULL == best_tile || candidates[0].tile == best_tile);
+  for (i = 0; i < num_candidates && NULL == best; i++) {
+    /* The site values come from the raster, which may be older than
+     * the tile; then the site can turn out to be unusable now. */
+    best = city_desirability(ait, pplayer, punit, candidates[i].tile);
+    if (best) {
+      best->result = candidates[i].result;
+    } else {
+      log_debug("settler map search: stale site (%d,%d)",
+                TILE_XY(candidates[i].tile));
+      settler->sites.value[tile_index(candidates[i].tile)] = SITE_UNKNOWN;
+    }
+  }
+
   if (best) {
     log_debug("settler map search (final): (%d,%d) %d", TILE_XY(best->tile),
               best->result);
@@ -1010,12 +1205,17 @@ void dai_auto_settler_init(struct ai_plr *ai)
 
   ai->settler = fc_calloc(1, sizeof(*ai->settler));
   ai->settler->tdc_hash = tile_data_cache_hash_new();
+  ai->settler->sites.value = NULL;
+  ai->settler->sites.turn = -1;
+  ai->settler->sites.citymap_serial = -1;
 
 #ifdef DEBUG
   ai->settler->cache.hit = 0;
   ai->settler->cache.old = 0;
   ai->settler->cache.miss = 0;
   ai->settler->cache.save = 0;
+  ai->settler->sites_stats.hit = 0;
+  ai->settler->sites_stats.miss = 0;
 #endif /* DEBUG */
 }
 
@@ -1025,13 +1225,13 @@ void random_settler(struct ai_type *ait, struct player *pplayer,
 		return;
 	}
 
-	struct genlist* actionList = genlist_new();
+	struct genvec* actionList = genvec_new();
 	collect_settler_moves(punit, actionList, pplayer);
-	int rand_no = rand() % genlist_size(actionList);
+	int rand_no = rand() % genvec_size(actionList);
 	// printf("RandNo:%d \n", rand_no);
-	struct potentialMove *chosen_action = genlist_get(actionList, rand_no);
+	struct potentialMove *chosen_action = genvec_get(actionList, rand_no);
 	make_settler_move(ait, pplayer, punit, state, chosen_action);
-	// Clear the genlist
+	// Clear the genvec
 	free_settler_moves(actionList);
 	return;
 }
@@ -1181,6 +1381,7 @@ BUILD_CITY:
         /* Reserve best other tile (if there is one). It is the tile where the
          * first citizen of the city is working. */
         citymap_reserve_tile(result->best_other.tile, punit->id);
+        dai_settler_sites_invalidate(ait, pplayer, result->best_other.tile);
       }
       punit->goto_tile = result->tile; /* TMP */
 
@@ -1229,7 +1430,7 @@ struct potentialImprovement{
 /**************************************************************************
   Settler collect all possible moves/actions.
 **************************************************************************/
-void collect_settler_moves(struct unit *punit, struct genlist *moveList,
+void collect_settler_moves(struct unit *punit, struct genvec *moveList,
 		struct player *pplayer){
 	CHECK_UNIT(punit);
 
@@ -1242,7 +1443,7 @@ void collect_settler_moves(struct unit *punit, struct genlist *moveList,
 		struct potentialMove *pMove = malloc(sizeof(struct potentialMove));
 		pMove->type = continue_move;
 		pMove->moveInfo = NULL;
-		genlist_append(moveList, pMove);
+		genvec_append(moveList, pMove);
 
 	} else {
 
@@ -1251,7 +1452,7 @@ void collect_settler_moves(struct unit *punit, struct genlist *moveList,
 				struct potentialMove *pMove = malloc(sizeof(struct potentialMove));
 				pMove->type = build_city;
 				pMove->moveInfo = NULL;
-				genlist_append(moveList, pMove);
+				genvec_append(moveList, pMove);
 			}
 		}
 
@@ -1290,7 +1491,7 @@ void collect_settler_moves(struct unit *punit, struct genlist *moveList,
 						action->target = target;
 
 						pMove->moveInfo = action;
-						genlist_append(moveList, pMove);
+						genvec_append(moveList, pMove);
 					}
 				}
 			} activity_type_iterate_end;
@@ -1307,7 +1508,7 @@ void collect_settler_moves(struct unit *punit, struct genlist *moveList,
 					action->target = target;
 
 					pMove->moveInfo = action;
-					genlist_append(moveList, pMove);
+					genvec_append(moveList, pMove);
 				}
 				else {
 					road_deps_iterate(&(proad->reqs), pdep) {
@@ -1323,7 +1524,7 @@ void collect_settler_moves(struct unit *punit, struct genlist *moveList,
 							action->target = target;
 
 							pMove->moveInfo = action;
-							genlist_append(moveList, pMove);
+							genvec_append(moveList, pMove);
 						}
 					} road_deps_iterate_end;
 				}
@@ -1343,7 +1544,7 @@ void collect_settler_moves(struct unit *punit, struct genlist *moveList,
 					action->target = target;
 
 					pMove->moveInfo = action;
-					genlist_append(moveList, pMove);
+					genvec_append(moveList, pMove);
 				} else {
 					base_deps_iterate(&(pbase->reqs), pdep) {
 						struct act_tgt dep_tgt = { .type = ATT_BASE, .obj.base = base_number(pdep) };
@@ -1358,7 +1559,7 @@ void collect_settler_moves(struct unit *punit, struct genlist *moveList,
 							action->target = target;
 
 							pMove->moveInfo = action;
-							genlist_append(moveList, pMove);
+							genvec_append(moveList, pMove);
 						}
 					} base_deps_iterate_end;
 				}
@@ -1390,7 +1591,7 @@ void collect_settler_moves(struct unit *punit, struct genlist *moveList,
 					ptask_save->tgt = ptask->tgt;
 					index_to_native_pos(&ptask_save->ptile_x,&ptask_save->ptile_y, tile_index(ptask->ptile));
 					pMove->moveInfo = ptask_save;
-					genlist_append(moveList, pMove);
+					genvec_append(moveList, pMove);
 				}
 			}
 		} city_list_iterate_end;
@@ -1457,17 +1658,17 @@ void make_settler_move(struct ai_type *ait, struct player *pplayer,
 /**************************************************************************
   Free given moves list
 **************************************************************************/
-void free_settler_moves(struct genlist *moveList){
-	for(int i = 0; i < genlist_size(moveList); i++ ){
-		struct potentialMove *toRemove = genlist_back(moveList);
+void free_settler_moves(struct genvec *moveList){
+	while (genvec_size(moveList) > 0) {
+		struct potentialMove *toRemove = genvec_back(moveList);
 		if((toRemove->type == explore) || (toRemove->type == improvement)
 				|| (toRemove->type == request)){
 			free(toRemove->moveInfo);
 		}
-		genlist_pop_back(moveList);
+		genvec_pop_back(moveList);
 		free(toRemove);
 	}
-	genlist_destroy(moveList);
+	genvec_destroy(moveList);
 }
 
 
@@ -1499,11 +1700,16 @@ void dai_auto_settler_reset(struct ai_type *ait, struct player *pplayer)
             player_name(pplayer), ai->settler->cache.save,
             ai->settler->cache.miss, ai->settler->cache.old,
             ai->settler->cache.hit);
+  log_debug("[aisettler sites for %s] miss: %d, hit: %d",
+            player_name(pplayer), ai->settler->sites_stats.miss,
+            ai->settler->sites_stats.hit);
 
   ai->settler->cache.hit = 0;
   ai->settler->cache.old = 0;
   ai->settler->cache.miss = 0;
   ai->settler->cache.save = 0;
+  ai->settler->sites_stats.hit = 0;
+  ai->settler->sites_stats.miss = 0;
 #endif /* DEBUG */
 
   tile_data_cache_hash_clear(ai->settler->tdc_hash);
@@ -1524,6 +1730,9 @@ void dai_auto_settler_free(struct ai_plr *ai)
     if (ai->settler->tdc_hash) {
       tile_data_cache_hash_destroy(ai->settler->tdc_hash);
     }
+    if (ai->settler->sites.value) {
+      free(ai->settler->sites.value);
+    }
     free(ai->settler);
   }
   ai->settler = NULL;
@@ -1572,6 +1781,8 @@ static bool dai_do_build_city(struct ai_type *ait, struct player *pplayer,
    * else might be cached in the future? */
   fc_assert_ret_val(pplayer == city_owner(pcity), FALSE);
   initialize_infrastructure_cache(pplayer);
+  /* The new city works tiles around it. */
+  dai_settler_sites_invalidate(ait, pplayer, ptile);
 
   /* Init ai.choice. Handling ferryboats might use it. */
   init_choice(&def_ai_city_data(pcity, ait)->choice);
@@ -19,7 +19,7 @@
 /* common */
 #include "city.h"
 #include "fc_types.h"
-#include "genlist.h"
+#include "genvec.h"
 
 /* server */
 #include "autoexplorer.h"
@@ -32,14 +32,17 @@ void dai_auto_settler_init(struct ai_plr *ai);
 void dai_auto_settler_free(struct ai_plr *ai);
 
 void dai_auto_settler_reset(struct ai_type *ait, struct player *pplayer);
+void dai_settler_sites_invalidate(struct ai_type *ait, struct player *pplayer,
+                                  struct tile *ptile);
+void dai_settler_tile_changed(struct ai_type *ait, struct tile *ptile);
 void dai_auto_settler_run(struct ai_type *ait, struct player *pplayer,
                           struct unit *punit, struct settlermap *state);
 
-void collect_settler_moves(struct unit *punit, struct genlist *moveList,
+void collect_settler_moves(struct unit *punit, struct genvec *moveList,
 		struct player *pplayer);
 void make_settler_move(struct ai_type *ait, struct player *pplayer,
         struct unit *punit, struct settlermap *state, struct potentialMove *chosen_action);
-void free_settler_moves(struct genlist *moveList);
+void free_settler_moves(struct genvec *moveList);
 
 void dai_auto_settler_cont(struct ai_type *ait, struct player *pplayer,
                            struct unit *punit, struct settlermap *state);
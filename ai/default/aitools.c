@@ -62,6 +62,7 @@
 #include "aiguard.h"
 #include "ailog.h"
 #include "aiplayer.h"
+#include "aisettler.h"
 #include "aitech.h"
 #include "aiunit.h"
 
@@ -756,6 +757,7 @@ void dai_unit_new_task(struct ai_type *ait, struct unit *punit,
   if (unit_data->task == AIUNIT_BUILD_CITY) {
     if (punit->goto_tile) {
       citymap_free_city_spot(punit->goto_tile, punit->id);
+      dai_settler_sites_invalidate(ait, unit_owner(punit), punit->goto_tile);
     } else {
       /* Print error message instead of crashing in citymap_free_city_spot()
        * This probably means that some city spot reservation has not been
@@ -797,6 +799,7 @@ void dai_unit_new_task(struct ai_type *ait, struct unit *punit,
   /* Reserve city spot, _unless_ we want to add ourselves to a city. */
   if (unit_data->task == AIUNIT_BUILD_CITY && !tile_city(ptile)) {
     citymap_reserve_city_spot(ptile, punit->id);
+    dai_settler_sites_invalidate(ait, unit_owner(punit), ptile);
   }
   if (unit_data->task == AIUNIT_HUNTER) {
     /* Set victim's hunted bit - the hunt is on! */
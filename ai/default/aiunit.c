@@ -88,6 +88,9 @@
 #define LOG_CARAVAN2      LOG_DEBUG
 #define LOG_CARAVAN3      LOG_DEBUG
 
+static struct fc_mem_pool unit_ai_pool =
+  FC_MEM_POOL_INIT("unit_ai", sizeof(struct unit_ai));
+
 static bool dai_find_boat_for_unit(struct ai_type *ait, struct unit *punit);
 static bool dai_caravan_can_trade_cities_diff_cont(struct player *pplayer, 
                                                    struct unit *punit);
@@ -2279,12 +2282,12 @@ static void dai_manage_hitpoint_recovery(struct ai_type *ait,
 
 void random_military(struct ai_type *ait, struct player *pplayer,
                          struct unit *punit){
-	struct genlist* actionList = genlist_new();
+	struct genvec* actionList = genvec_new();
 	collect_military_moves(punit, actionList);
-	int rand_index = rand() % genlist_size(actionList);
-	struct potentialMove *chosen_action = genlist_get(actionList, rand_index);
+	int rand_index = rand() % genvec_size(actionList);
+	struct potentialMove *chosen_action = genvec_get(actionList, rand_index);
 	make_military_move(ait, pplayer, punit, chosen_action);
-	// Clear the genlist
+	// Clear the genvec
 	free_military_moves(actionList);
 	return;
 }
@@ -2449,7 +2452,7 @@ void dai_manage_military(struct ai_type *ait, struct player *pplayer,
   Only considers moves that can made as if were playing on the GUI
   client. Add moves to the provided list.
 **************************************************************************/
-void collect_military_moves(struct unit *punit, struct genlist *moveList){
+void collect_military_moves(struct unit *punit, struct genvec *moveList){
 	CHECK_UNIT(punit);
 	collect_explorer_moves(punit, moveList);
 
@@ -2458,7 +2461,7 @@ void collect_military_moves(struct unit *punit, struct genlist *moveList){
 		struct potentialMove *pMove = malloc(sizeof(struct potentialMove));
 		pMove->type = fortify;
 		pMove->moveInfo = NULL;
-		genlist_append(moveList, pMove);
+		genvec_append(moveList, pMove);
 	}
 
 	if(punit->activity!=ACTIVITY_SENTRY &&
@@ -2467,14 +2470,14 @@ void collect_military_moves(struct unit *punit, struct genlist *moveList){
 		struct potentialMove *pMove = malloc(sizeof(struct potentialMove));
 		pMove->type = sentry;
 		pMove->moveInfo = NULL;
-		genlist_append(moveList, pMove);
+		genvec_append(moveList, pMove);
 	}
 
 	if (can_unit_do_activity(punit, ACTIVITY_PILLAGE)) {
 		struct potentialMove *pMove = malloc(sizeof(struct potentialMove));
 		pMove->type = pillage;
 		pMove->moveInfo = NULL;
-		genlist_append(moveList, pMove);
+		genvec_append(moveList, pMove);
 	}
 	return;
 }
@@ -2522,16 +2525,16 @@ void make_military_move(struct ai_type *ait, struct player *pplayer,
 /**************************************************************************
   Destroy the military move list
 **************************************************************************/
-void free_military_moves(struct genlist *moveList){
-	for(int i = 0; i < genlist_size(moveList); i++ ){
-		struct potentialMove *toRemove = genlist_back(moveList);
+void free_military_moves(struct genvec *moveList){
+	while (genvec_size(moveList) > 0) {
+		struct potentialMove *toRemove = genvec_back(moveList);
 		if(toRemove->type == explore){
 			free(toRemove->moveInfo);
 		}
 		free(toRemove);
-		genlist_pop_back(moveList);
+		genvec_pop_back(moveList);
 	}
-	genlist_destroy(moveList);
+	genvec_destroy(moveList);
 	return;
 }
 
@@ -3186,8 +3189,8 @@ void dai_units_ruleset_close(struct ai_type *ait)
 void dai_unit_init(struct ai_type *ait, struct unit *punit)
 {
   /* Make sure that contents of unit_ai structure are correctly initialized,
-   * if you ever allocate it by some other mean than fc_calloc() */
-  struct unit_ai *unit_data = fc_calloc(1, sizeof(struct unit_ai));
+   * if you ever allocate it by some other mean than a zeroing allocator */
+  struct unit_ai *unit_data = fc_mem_pool_alloc(&unit_ai_pool);
 
   unit_data->done = FALSE;
   unit_data->cur_pos = NULL;
@@ -3228,7 +3231,7 @@ void dai_unit_close(struct ai_type *ait, struct unit *punit)
 
   if (unit_data != NULL) {
     unit_set_ai_data(punit, ait, NULL);
-    FC_FREE(unit_data);
+    fc_mem_pool_free(&unit_ai_pool, unit_data);
   }
 }
 
@@ -3327,21 +3330,21 @@ struct unit_type *dai_role_utype_for_move_type(struct city *pcity, int role,
 }
 
 /**************************************************************************
-  Calculate all available moves for a player (stored in a genlist)
+  Calculate all available moves for a player (stored in a genvec)
 **************************************************************************/
-struct genlist* player_available_moves(struct player *pplayer){
+struct genvec* player_available_moves(struct player *pplayer){
 	// Create a list
 //	printf("%s\n", pplayer->name);
-	struct genlist *player_moves = genlist_new();
+	struct genvec *player_moves = genvec_new();
 
 	unit_list_iterate_safe(pplayer->units, punit) {
 		if (unit_has_type_flag(punit, UTYF_SETTLERS) || unit_has_type_flag(punit, UTYF_CITIES)){
 			struct unit_moves *umoves = malloc(sizeof(struct unit_moves));
 			umoves->id = punit->id;
-			struct genlist *moves = genlist_new();
+			struct genvec *moves = genvec_new();
 			umoves->type = settler;
 			collect_settler_moves(punit, moves, pplayer);
-			printf("\tCheck settler possible moves: %d\n", genlist_size(moves));
+			printf("\tCheck settler possible moves: %d\n", genvec_size(moves));
 			umoves->moves = moves;
 
 			bool free = TRUE;
@@ -3362,15 +3365,15 @@ struct genlist* player_available_moves(struct player *pplayer){
 					break;
 			}
 			// Add list to main list, along with this units ID
-			printf("\tAfter pruning ... %d\n", genlist_size(umoves->moves));
-			genlist_append(player_moves, umoves);
+			printf("\tAfter pruning ... %d\n", genvec_size(umoves->moves));
+			genvec_append(player_moves, umoves);
 		} else if (is_military_unit(punit)){
 			struct unit_moves *umoves = malloc(sizeof(struct unit_moves));
 			umoves->id = punit->id;
-			struct genlist *moves = genlist_new();
+			struct genvec *moves = genvec_new();
 			umoves->type = military;
 			collect_military_moves(punit, moves);
-			printf("\tCheck military possible moves: %d\n", genlist_size(moves));
+			printf("\tCheck military possible moves: %d\n", genvec_size(moves));
 			umoves->moves = moves;
 
 			bool free = TRUE;
@@ -3390,16 +3393,16 @@ struct genlist* player_available_moves(struct player *pplayer){
 				default:
 					break;
 			}
-			printf("\tAfter pruning ... %d\n", genlist_size(umoves->moves));
+			printf("\tAfter pruning ... %d\n", genvec_size(umoves->moves));
 			// Add list to main list, along with this units ID
-			genlist_append(player_moves, umoves);
+			genvec_append(player_moves, umoves);
 		} else if (unit_has_type_role(punit, L_EXPLORER)){
 			struct unit_moves *umoves = malloc(sizeof(struct unit_moves));
 			umoves->id = punit->id;
-			struct genlist *moves = genlist_new();
+			struct genvec *moves = genvec_new();
 			umoves->type = explorer;
 			collect_explorer_moves(punit, moves);
-			printf("\tCheck explorer possible moves: %d\n", genlist_size(moves));
+			printf("\tCheck explorer possible moves: %d\n", genvec_size(moves));
 			umoves->moves = moves;
 
 			bool free = TRUE;
@@ -3419,14 +3422,14 @@ struct genlist* player_available_moves(struct player *pplayer){
 				default:
 					break;
 			}
-			printf("\tAfter pruning ... %d\n", genlist_size(umoves->moves));
+			printf("\tAfter pruning ... %d\n", genvec_size(umoves->moves));
 			// Add list to main list, along with this units ID
-			genlist_append(player_moves, umoves);
+			genvec_append(player_moves, umoves);
 		}
 
 	} unit_list_iterate_safe_end;
 
-	printf("\t No of Units: %d\n", genlist_size(player_moves));
+	printf("\t No of Units: %d\n", genvec_size(player_moves));
 	return player_moves;
 }
 
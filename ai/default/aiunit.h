@@ -18,7 +18,7 @@
 #include "fc_types.h"
 #include "unittype.h"
 
-#include "genlist.h"
+#include "genvec.h"
 
 /* server */
 #include "autoexplorer.h"
@@ -97,10 +97,10 @@ void dai_manage_unit(struct ai_type *ait, struct player *pplayer,
 void dai_manage_military(struct ai_type *ait, struct player *pplayer,
                          struct unit *punit);
 
-void collect_military_moves(struct unit *punit, struct genlist *moveList);
+void collect_military_moves(struct unit *punit, struct genvec *moveList);
 void make_military_move(struct ai_type *ait, struct player *pplayer,
 		struct unit *punit, struct potentialMove *chosen_action);
-void free_military_moves(struct genlist *moveList);
+void free_military_moves(struct genvec *moveList);
 
 struct city *find_nearest_safe_city(struct unit *punit);
 int look_for_charge(struct ai_type *ait, struct player *pplayer,
@@ -169,10 +169,10 @@ enum mcts_unit_type {
 struct unit_moves{
 	int id;
 	enum mcts_unit_type type;
-	struct genlist* moves;
+	struct genvec* moves;
 };
 
-struct genlist* player_available_moves(struct player *pplayer);
+struct genvec* player_available_moves(struct player *pplayer);
 void attach_chosen_move(struct player *pplayer);
 
 #endif  /* FC__AIUNIT_H */
@@ -118,7 +118,7 @@ void mcts_init(struct player *pplayer) {
 	}
 
 	// Collect all available moves for player
-	struct genlist *all_unit_moves = player_available_moves(pplayer);
+	struct genvec *all_unit_moves = player_available_moves(pplayer);
 	mcts_root = create_root_node(player_index(pplayer), all_unit_moves);
 	mcts_root->uninitialised = FALSE;
 	current_mcts_node = mcts_root;
@@ -135,14 +135,13 @@ void mcts_expansion(struct player *pplayer) {
 	current_mcts_stage = expansion;
 
 	// Lookup size of untried moves list
-	int untried_size = genlist_size(current_mcts_node->untried_moves);
+	int untried_size = genvec_size(current_mcts_node->untried_moves);
 	printf("\tuntried_size: %d", untried_size);
 
 	// Retrieve move number + remove from untried list
 	int random_index = rand() % untried_size;
-	int move_no = (int) genlist_get(current_mcts_node->untried_moves,
-			random_index);
-	genlist_remove(current_mcts_node->untried_moves, (void *) move_no);
+	int move_no = FC_PTR_TO_INT(genvec_remove_index(
+			current_mcts_node->untried_moves, random_index));
 
 	printf("\tRandNo: %d\n", random_index);
 
@@ -174,10 +173,7 @@ void mcts_best_move(struct player *pplayer) {
 
 	// If the current node is uninitalised - need to populate its move information
 	if(current_mcts_node->uninitialised){
-		struct genlist *all_unit_moves = player_available_moves(pplayer);
-		current_mcts_node->all_moves = all_unit_moves;
-		current_mcts_node->total_no_moves = calc_number_moves(all_unit_moves);
-		current_mcts_node->untried_moves = init_untried_moves(current_mcts_node->total_no_moves);
+		set_node_moves(current_mcts_node, player_available_moves(pplayer));
 		current_mcts_node->uninitialised = FALSE;
 	}
 
@@ -220,15 +216,15 @@ void mcts_best_move(struct player *pplayer) {
 			backpropagate(TRUE);
 	} else {
 		//Selection - no untried moves, need to navigate to children
-		if(((genlist_size(current_mcts_node->untried_moves) == 0) &&
-				(genlist_size(current_mcts_node->children) != 0)) || current_mcts_node->uninitialised){
+		if(((genvec_size(current_mcts_node->untried_moves) == 0) &&
+				(genvec_size(current_mcts_node->children) != 0)) || current_mcts_node->uninitialised){
 			printf("SELECTION\n");
 			return mcts_selection(pplayer);
 		}
 
-		printf("\t\t%d\n", genlist_size(current_mcts_node->untried_moves));
+		printf("\t\t%d\n", genvec_size(current_mcts_node->untried_moves));
 		//Expansion - If we have untried moves then need to expand
-		if(genlist_size(current_mcts_node->untried_moves) != 0){
+		if(genvec_size(current_mcts_node->untried_moves) != 0){
 			printf("EXPANSION\n");
 			mcts_expansion(pplayer);
 		}
@@ -242,13 +238,13 @@ void mcts_best_move(struct player *pplayer) {
 static mcts_node* UCT_select_child(mcts_node* root){
 	int self_visits = root->visits;
 
-	int no_children = genlist_size(root->children);
+	int no_children = genvec_size(root->children);
 
-	mcts_node *best_node = genlist_get(root->children, 0);
+	mcts_node *best_node = genvec_get(root->children, 0);
 	double best_weight = UCT(best_node, self_visits);
 
 	for(int i = 1; i < no_children; i++){
-		mcts_node *tmp = genlist_get(root->children, i);
+		mcts_node *tmp = genvec_get(root->children, i);
 		double tmp_weight = UCT(tmp, self_visits);
 		if (tmp_weight > best_weight){
 			best_node = tmp;
@@ -268,11 +264,11 @@ static double UCT(mcts_node *child_node, int rootPlays){
 }
 
 static void free_mcts_tree(mcts_node *node){
-	int no_children = genlist_size(node->children);
+	int no_children = genvec_size(node->children);
 
 	// Free all child nodes recursively
 	for(int i = 0; i < no_children; i++){
-		mcts_node *child = genlist_get(node->children, i);
+		mcts_node *child = genvec_get(node->children, i);
 		free_mcts_tree(child);
 	}
 
@@ -282,60 +278,42 @@ static void free_mcts_tree(mcts_node *node){
 	return;
 }
 
-int find_index_of_unit(struct unit *punit, struct genlist *player_moves) {
-	int target_id = punit->id;
-	for (int i = 0; i < genlist_size(player_moves); i++) {
-		struct unit_moves *tmp = genlist_get(player_moves, i);
+int find_index_of_unit(struct unit *punit, const mcts_node *node) {
+	int index = node_unit_index(node, punit->id);
 
-		fc_assert(tmp != NULL);
-		if (tmp->id == target_id) {
-			return i;
-		}
+	if (index < 0) {
+		printf("No ID found\n");
 	}
 
-	printf("No ID found\n");
-
-	return -1;
+	return index;
 }
 
 struct potentialMove* return_unit_index_move(int move_no, int unit_list_index,
-		struct genlist *player_moves){
-	int no_of_moves_higher_in_list = 1;
-
-	for(int i=unit_list_index+1; i<genlist_size(player_moves); i++){
-		no_of_moves_higher_in_list *= genlist_size(genlist_get(player_moves,i));
-	}
+		const mcts_node *node){
+	struct unit_moves *unit = genvec_get(node->all_moves, unit_list_index);
+	int move_index = (move_no / node->moves_higher[unit_list_index])
+			% genvec_size(unit->moves);
 
-	int move_index = (move_no/no_of_moves_higher_in_list) % genlist_size(genlist_get(player_moves,unit_list_index));
-
-	return genlist_get(genlist_get(player_moves, unit_list_index), move_index);
+	return genvec_get(unit->moves, move_index);
 }
 
 struct potentialMove* return_punit_move(struct unit *punit){
-	struct genlist *player_moves;
+	const mcts_node *node;
 	int unit_list_index;
 	int move_no;
 
 	if(move_chosen){ //Should this also check that it is the MCTS player?
-		player_moves = mcts_root->all_moves;
-		unit_list_index = find_index_of_unit(punit, player_moves);
+		node = mcts_root;
 		move_no = chosen_move_set;
 	} else {
-		player_moves = current_mcts_node->parent->all_moves;
-		unit_list_index = find_index_of_unit(punit, player_moves);
+		node = current_mcts_node->parent;
 		move_no = current_mcts_node->move_no;
 	}
+	unit_list_index = find_index_of_unit(punit, node);
 
-	int no_of_moves_higher_in_list = 1;
-
-	for(int i=unit_list_index+1; i<genlist_size(player_moves); i++){
-		struct unit_moves * tmp_unit = genlist_get(player_moves,i);
-		no_of_moves_higher_in_list *= genlist_size(tmp_unit->moves);
-		printf("Unit moves:%d -- %d\n", genlist_size(tmp_unit->moves), no_of_moves_higher_in_list);
-	}
-
-	struct unit_moves * unit = genlist_get(player_moves, unit_list_index);
-	int no_unit_moves = genlist_size(unit->moves);
+	struct unit_moves * unit = genvec_get(node->all_moves, unit_list_index);
+	int no_unit_moves = genvec_size(unit->moves);
+	int no_of_moves_higher_in_list = node->moves_higher[unit_list_index];
 
 	int move_index = (move_no/no_of_moves_higher_in_list) % no_unit_moves;
 
@@ -344,9 +322,9 @@ struct potentialMove* return_punit_move(struct unit *punit){
 	printf("\thigher_moves: %d\n", no_of_moves_higher_in_list);
 	printf("\tmove_index: %d\n", move_index);
 	printf("\tmodulo: %d\n", no_unit_moves);
-	printf("\tMove mem: %d\n", (int) genlist_get(unit->moves, move_index));
+	printf("\tMove mem: %d\n", (int) genvec_get(unit->moves, move_index));
 
-	return genlist_get(unit->moves, move_index);
+	return genvec_get(unit->moves, move_index);
 }
 
 void backpropagate(bool interrupt){
@@ -390,8 +368,8 @@ static int mcts_choose_final_move(){
 	int most_visits = 0;
 	int chosen_move;
 
-	for(int i = 0; i < genlist_size(mcts_root->children); i++){
-		mcts_node *child_node = genlist_get(mcts_root->children, i);
+	for(int i = 0; i < genvec_size(mcts_root->children); i++){
+		mcts_node *child_node = genvec_get(mcts_root->children, i);
 		if (child_node->visits > most_visits){
 			most_visits = child_node->visits;
 			chosen_move = child_node->move_no;
@@ -408,8 +386,8 @@ bool at_root_of_tree(){
 void print_mcts_tree_layer1(){
 	printf("-------------------------\n");
 	printf("# Visits: %d \t Score: %d\n", mcts_root->visits, mcts_root->wins);
-	for(int i=0; i < genlist_size(mcts_root->children); i++){
-		mcts_node *child_node = genlist_get(mcts_root->children, i);
+	for(int i=0; i < genvec_size(mcts_root->children); i++){
+		mcts_node *child_node = genvec_get(mcts_root->children, i);
 		printf("\t# Visits: %d \t Score: %d\n", child_node->visits, child_node->wins);
 	}
 	printf("-------------------------\n");
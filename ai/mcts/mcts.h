@@ -11,6 +11,8 @@
 #include <stdbool.h>
 #include "score.h"
 
+struct mcts_node;
+
 extern bool game_over;
 extern bool mcts_mode;
 extern int rollout_depth;
@@ -40,12 +42,12 @@ void mcts_best_move(struct player *pplayer);
  * enabling the moves for that unit to be found
  *
  * @param punit the unit we wish to find the index for
- * @param player_moves the move list which we wish to find the index in
+ * @param node the node whose move list we wish to find the index in
  * @return Integer index where that units moves are stored
  */
-int find_index_of_unit(struct unit *punit, struct genlist *player_moves);
+int find_index_of_unit(struct unit *punit, const struct mcts_node *node);
 struct potentialMove* return_unit_index_move(int move_no, int unit_list_index,
-		struct genlist *player_moves);
+		const struct mcts_node *node);
 
 /**
  * Returns a move for a unit based on the current position in
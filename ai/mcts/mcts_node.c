@@ -6,7 +6,7 @@
 #define BRANCH_LIMITED	1
 #define BRANCH_LIMIT	30
 
-mcts_node* create_node(int p_index, struct genlist *possible_moves, int move,
+mcts_node* create_node(int p_index, struct genvec *possible_moves, int move,
 		mcts_node *parent) {
 	mcts_node* node = (mcts_node*) malloc(sizeof(mcts_node));
 
@@ -18,22 +18,58 @@ mcts_node* create_node(int p_index, struct genlist *possible_moves, int move,
 	node->visits = 0;
 
 	node->parent = parent;
-	node->children = genlist_new();
+	node->children = genvec_new();
 
-	node->all_moves = possible_moves;
-	node->total_no_moves = calc_number_moves(possible_moves);
-	node->untried_moves = init_untried_moves(node->total_no_moves);
+	node->unit_index = NULL;
+	node->moves_higher = NULL;
+	set_node_moves(node, possible_moves);
 
 	return node;
 }
 
-mcts_node* create_root_node(int p_index, struct genlist *all_possible_moves) {
+void set_node_moves(mcts_node *node, struct genvec *all_moves) {
+	int no_of_units = genvec_size(all_moves);
+
+	node->all_moves = all_moves;
+	node->total_no_moves = calc_number_moves(all_moves);
+	node->untried_moves = init_untried_moves(node->total_no_moves);
+
+	if (all_moves == NULL) {
+		return;
+	}
+
+	node->unit_index = genhash_new_nentries(NULL, NULL, no_of_units);
+	node->moves_higher = fc_malloc(MAX(no_of_units, 1) * sizeof(int));
+
+	int no_of_moves_higher = 1;
+	for (int i = no_of_units - 1; i >= 0; i--) {
+		struct unit_moves *tmp = genvec_get(all_moves, i);
+
+		genhash_insert(node->unit_index, FC_INT_TO_PTR(tmp->id),
+				FC_INT_TO_PTR(i));
+		node->moves_higher[i] = no_of_moves_higher;
+		no_of_moves_higher *= genvec_size(tmp->moves);
+	}
+}
+
+int node_unit_index(const mcts_node *node, int unit_id) {
+	void *index;
+
+	if (node->unit_index != NULL
+			&& genhash_lookup(node->unit_index, FC_INT_TO_PTR(unit_id), &index)) {
+		return FC_PTR_TO_INT(index);
+	}
+
+	return -1;
+}
+
+mcts_node* create_root_node(int p_index, struct genvec *all_possible_moves) {
 	return create_node(p_index, all_possible_moves, 0, NULL);
 }
 
 mcts_node* add_child_node(mcts_node* parent, int p_index, int move_no) {
 	mcts_node *child_node = create_node(p_index, NULL,move_no, parent);
-	genlist_append(parent->children, child_node);
+	genvec_append(parent->children, child_node);
 	return child_node;
 }
 
@@ -43,12 +79,12 @@ void free_node(mcts_node *node) {
 	// Then clear yourself
 
 	//Child nodes:
-	genlist_destroy(node->children);
+	genvec_destroy(node->children);
 
 	//All_Moves
-	int no_of_units = genlist_size(node->all_moves);
+	int no_of_units = genvec_size(node->all_moves);
 	for(int i = 0; i < no_of_units; i++){
-		struct unit_moves *tmp = genlist_get(node->all_moves,i);
+		struct unit_moves *tmp = genvec_get(node->all_moves,i);
 		struct unit *punit = idex_lookup_unit(tmp->id);
 		if(tmp->type == settler){
 			free_settler_moves(tmp->moves);
@@ -60,10 +96,14 @@ void free_node(mcts_node *node) {
 		free(tmp);
 	}
 
-	genlist_destroy(node->all_moves);
+	genvec_destroy(node->all_moves);
+	if (node->unit_index != NULL) {
+		genhash_destroy(node->unit_index);
+	}
+	free(node->moves_higher);
 
 	// Untried moves
-	genlist_destroy(node->untried_moves);
+	genvec_destroy(node->untried_moves);
 
 	//This node
 	free(node);
@@ -75,30 +115,30 @@ void update_node(int32_t result, mcts_node* node) {
 	node->wins += result;
 }
 
-int calc_number_moves(struct genlist* all_moves){
+int calc_number_moves(struct genvec* all_moves){
 	if(all_moves == NULL){
 		return 0;
 	} else {
-		int no_of_units = genlist_size(all_moves);
+		int no_of_units = genvec_size(all_moves);
 		int no_of_moves = 1;
 		for(int i = 0; i < no_of_units; i++){
-			struct unit_moves *tmp = genlist_get(all_moves,i);
-			no_of_moves *= genlist_size(tmp->moves);
+			struct unit_moves *tmp = genvec_get(all_moves,i);
+			no_of_moves *= genvec_size(tmp->moves);
 		}
 		return no_of_moves;
 	}
 
 }
 
-struct genlist* init_untried_moves(int total_no_moves){
-	struct genlist* available_moves = NULL;
+struct genvec* init_untried_moves(int total_no_moves){
+	struct genvec* available_moves = NULL;
 
 	if(total_no_moves != 0){
-		available_moves = genlist_new();
+		available_moves = genvec_new();
 		for (int i = 0; i < total_no_moves; i++) {
 			//TODO: Could improve this - potential issue with overflow
 			// (although should never have large enough moves due to pruning)
-			genlist_append(available_moves, (void*) i);
+			genvec_append(available_moves, (void*) i);
 		}
 	}
 
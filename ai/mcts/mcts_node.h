@@ -7,7 +7,8 @@
 
 /* utility */
 #include "fcintl.h"
-#include "genlist.h"
+#include "genhash.h"
+#include "genvec.h"
 #include "log.h"
 #include "mem.h"
 #include "support.h"
@@ -25,11 +26,17 @@ typedef struct mcts_node {
 	int visits;
 
 	struct mcts_node *parent;
-	struct genlist *children;
+	struct genvec *children;
 
-	struct genlist *all_moves;
+	struct genvec *all_moves;
 	int total_no_moves;
-	struct genlist *untried_moves;
+	struct genvec *untried_moves;
+
+	// Unit id -> index of its entry in all_moves
+	struct genhash *unit_index;
+	// For each index of all_moves, the product of the number of moves of
+	// the units after it, to decode a move number in O(1)
+	int *moves_higher;
 } mcts_node;
 
 
@@ -42,9 +49,27 @@ typedef struct mcts_node {
  * @param parent the node that created this node
  * @return a pointer to a new mcts node
  */
-mcts_node* create_node(int p_index, struct genlist *all_possible_moves,
+mcts_node* create_node(int p_index, struct genvec *all_possible_moves,
 		int move, mcts_node *parent);
 
+/**
+ * Sets the moves of a node: the list of moves of every unit, the untried
+ * moves and the lookup tables used to decode a move number.
+ *
+ * @param node the node to set the moves of
+ * @param all_moves the list of moves that can be performed for each unit
+ */
+void set_node_moves(mcts_node *node, struct genvec *all_moves);
+
+/**
+ * Returns the index of the moves of the unit in the moves list of the node.
+ *
+ * @param node the node whose moves list is searched
+ * @param unit_id the id of the unit
+ * @return the index of the unit's moves, or -1 if it has none
+ */
+int node_unit_index(const mcts_node *node, int unit_id);
+
 /**
  * Creates a new root node. parent and move set to NULL.
  *
@@ -52,7 +77,7 @@ mcts_node* create_node(int p_index, struct genlist *all_possible_moves,
  * @param all_possible_moves the list of moves the node can perform
  * @return a pointer to a new root mcts_node
  */
-mcts_node* create_root_node(int p_index, struct genlist *all_possible_moves);
+mcts_node* create_root_node(int p_index, struct genvec *all_possible_moves);
 
 
 /**
@@ -90,7 +115,7 @@ void update_node(int32_t result, mcts_node* node);
  * @param all_moves the list of moves that can be performed for each unit
  * @return total number of moves that can be performed
  */
-int calc_number_moves(struct genlist* all_moves);
+int calc_number_moves(struct genvec* all_moves);
 
 /**
  * Creates a list of the untried moves
@@ -98,6 +123,6 @@ int calc_number_moves(struct genlist* all_moves);
  * @param the number of possible moves for that node
  * @return a list of all possible moves
  */
-struct genlist* init_untried_moves(int total_no_moves);
+struct genvec* init_untried_moves(int total_no_moves);
 
 #endif
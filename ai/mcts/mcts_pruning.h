@@ -7,7 +7,7 @@
 
 /* utility */
 #include "fcintl.h"
-#include "genlist.h"
+#include "genvec.h"
 #include "log.h"
 #include "mem.h"
 #include "support.h"
@@ -24,7 +24,7 @@
  * @param need_to_free whether on return the origional move list needs to be freed
  * @return a pointer to the new list of pruned moves
  */
-struct genlist* random_mcts_general_pruning(struct genlist *all_moves, bool *need_to_free);
+struct genvec* random_mcts_general_pruning(struct genvec *all_moves, bool *need_to_free);
 
 /**
  * Returns a new list of pruned moves for a unit. Basic pruning by randomly
@@ -36,7 +36,7 @@ struct genlist* random_mcts_general_pruning(struct genlist *all_moves, bool *nee
  * @param punit the unit on which we are pruning moves for
  * @return a pointer to the new list of pruned moves
  */
-struct genlist* random_mcts_settler_pruning(struct genlist* all_moves, bool * need_to_free,
+struct genvec* random_mcts_settler_pruning(struct genvec* all_moves, bool * need_to_free,
 		struct unit * punit);
 
 #endif
@@ -19,6 +19,7 @@
 #include <string.h>
 
 /* utility */
+#include "genvec.h"
 #include "mem.h"
 #include "log.h"
 #include "support.h" 
@@ -214,14 +215,14 @@ void rai_settler_run(struct ai_type *ait, struct player *pplayer,
 	struct tile *init_tile = unit_tile(punit);
 	struct potentialImprovement *action;
 
-	struct genlist* actionList = genlist_new();
+	struct genvec* actionList = genvec_new();
 
 	if (unit_has_type_flag(punit, UTYF_CITIES)) {
 		if (city_can_be_built_here(init_tile, punit)) {
 			struct potentialMove *pMove = malloc(sizeof(struct potentialMove));
 			pMove->type = build_city;
 			pMove->moveInfo = NULL;
-			genlist_append(actionList, pMove);
+			genvec_append(actionList, pMove);
 		}
 	}
 
@@ -260,7 +261,7 @@ void rai_settler_run(struct ai_type *ait, struct player *pplayer,
 					action->target = target;
 
 					pMove->moveInfo = action;
-					genlist_append(actionList, pMove);
+					genvec_append(actionList, pMove);
 				}
 			}
 		} activity_type_iterate_end;
@@ -277,7 +278,7 @@ void rai_settler_run(struct ai_type *ait, struct player *pplayer,
 				action->target = target;
 
 				pMove->moveInfo = action;
-				genlist_append(actionList, pMove);
+				genvec_append(actionList, pMove);
 			}
 			else {
 				road_deps_iterate(&(proad->reqs), pdep) {
@@ -293,7 +294,7 @@ void rai_settler_run(struct ai_type *ait, struct player *pplayer,
 						action->target = target;
 
 						pMove->moveInfo = action;
-						genlist_append(actionList, pMove);
+						genvec_append(actionList, pMove);
 					}
 				} road_deps_iterate_end;
 			}
@@ -313,7 +314,7 @@ void rai_settler_run(struct ai_type *ait, struct player *pplayer,
 				action->target = target;
 
 				pMove->moveInfo = action;
-				genlist_append(actionList, pMove);
+				genvec_append(actionList, pMove);
 			} else {
 				base_deps_iterate(&(pbase->reqs), pdep) {
 					struct act_tgt dep_tgt = { .type = ATT_BASE, .obj.base = base_number(pdep) };
@@ -328,7 +329,7 @@ void rai_settler_run(struct ai_type *ait, struct player *pplayer,
 						action->target = target;
 
 						pMove->moveInfo = action;
-						genlist_append(actionList, pMove);
+						genvec_append(actionList, pMove);
 					}
 				} base_deps_iterate_end;
 			}
@@ -360,14 +361,14 @@ void rai_settler_run(struct ai_type *ait, struct player *pplayer,
 				ptask_save->tgt = ptask->tgt;
 				index_to_native_pos(&ptask_save->ptile_x,&ptask_save->ptile_y, tile_index(ptask->ptile));
 				pMove->moveInfo = ptask_save;
-				genlist_append(actionList, pMove);
+				genvec_append(actionList, pMove);
 			}
 		}
 	} city_list_iterate_end;
 
 
 
-	struct potentialMove *chosen_action = genlist_get(actionList, fc_rand(genlist_size(actionList)));
+	struct potentialMove *chosen_action = genvec_get(actionList, fc_rand(genvec_size(actionList)));
 	struct worker_task_load_compatible *chosen_req_task;
 	switch(chosen_action->type){
 	case explore:
@@ -415,8 +416,8 @@ void rai_settler_run(struct ai_type *ait, struct player *pplayer,
 		break;
 	}
 
-	for(int i = 0; i < genlist_size(actionList); i++ ){
-		struct potentialMove *toRemove = genlist_back(actionList);
+	while (genvec_size(actionList) > 0) {
+		struct potentialMove *toRemove = genvec_back(actionList);
 		if(toRemove->type == explore){
 			free(toRemove->moveInfo);
 		}
@@ -426,10 +427,10 @@ void rai_settler_run(struct ai_type *ait, struct player *pplayer,
 		if(toRemove->type == request){
 			free(toRemove->moveInfo);
 		}
-		genlist_pop_back(actionList);
+		genvec_pop_back(actionList);
 		free(toRemove);
 	}
-	genlist_destroy(actionList);
+	genvec_destroy(actionList);
 
 	return;
 }
@@ -19,6 +19,7 @@
 
 /* utility */
 #include "bitvector.h"
+#include "genvec.h"
 #include "log.h"
 #include "mem.h"
 #include "rand.h"
@@ -1474,7 +1475,7 @@ void rai_manage_military(struct ai_type *ait, struct player *pplayer,
 
 	CHECK_UNIT(punit);
 
-	struct genlist* actionList = genlist_new();
+	struct genvec* actionList = genvec_new();
 
 	//unit_activity_handling(punit, ACTIVITY_IDLE);
 
@@ -1485,7 +1486,7 @@ void rai_manage_military(struct ai_type *ait, struct player *pplayer,
 		struct potentialMove *pMove = malloc(sizeof(struct potentialMove));
 		pMove->type = fortify;
 		pMove->moveInfo = NULL;
-		genlist_append(actionList, pMove);
+		genvec_append(actionList, pMove);
 	}
 
 	if(punit->activity!=ACTIVITY_SENTRY &&
@@ -1494,14 +1495,14 @@ void rai_manage_military(struct ai_type *ait, struct player *pplayer,
 		struct potentialMove *pMove = malloc(sizeof(struct potentialMove));
 		pMove->type = sentry;
 		pMove->moveInfo = NULL;
-		genlist_append(actionList, pMove);
+		genvec_append(actionList, pMove);
 	}
 
 	if (can_unit_do_activity(punit, ACTIVITY_PILLAGE)) {
 		struct potentialMove *pMove = malloc(sizeof(struct potentialMove));
 		pMove->type = pillage;
 		pMove->moveInfo = NULL;
-		genlist_append(actionList, pMove);
+		genvec_append(actionList, pMove);
 	}
 
 	//find_all_rampage_targets(punit, RAMPAGE_ANYTHING, RAMPAGE_ANYTHING, actionList);
@@ -1513,7 +1514,7 @@ void rai_manage_military(struct ai_type *ait, struct player *pplayer,
 	// Defend city? Probably not needed also
 	// Should be achieved by random moves
 
-	struct potentialMove *chosen_action = genlist_get(actionList, fc_rand(genlist_size(actionList)));
+	struct potentialMove *chosen_action = genvec_get(actionList, fc_rand(genvec_size(actionList)));
 
 	switch(chosen_action->type){
 	case explore:
@@ -1546,15 +1547,15 @@ void rai_manage_military(struct ai_type *ait, struct player *pplayer,
 
 
 	// Destroy the list and elements within
-	for(int i = 0; i < genlist_size(actionList); i++ ){
-		struct potentialMove *toRemove = genlist_back(actionList);
+	while (genvec_size(actionList) > 0) {
+		struct potentialMove *toRemove = genvec_back(actionList);
 		if(toRemove->type == explore){
 			free(toRemove->moveInfo);
 		}
-		genlist_pop_back(actionList);
+		genvec_pop_back(actionList);
 		free(toRemove);
 	}
-	genlist_destroy(actionList);
+	genvec_destroy(actionList);
 
 	//dai_unit_new_task(ait, punit, AIUNIT_NONE, NULL);
 
@@ -158,6 +158,16 @@ static void rai_city_alloc(struct city *pcity)
   dai_city_alloc(deftype, pcity);
 }
 
+/**************************************************************************
+  Call default ai with random ai type as parameter.
+**************************************************************************/
+static void rai_tile_changed(struct tile *ptile)
+{
+  struct ai_type *deftype = random_ai_get_self();
+
+  dai_settler_tile_changed(deftype, ptile);
+}
+
 /**************************************************************************
   Call default ai with random ai type as parameter.
 **************************************************************************/
@@ -558,6 +568,7 @@ bool fc_ai_random_setup(struct ai_type *ai)
     ai->funcs.city_got = NULL;
     ai->funcs.city_lost = NULL;
   */
+  ai->funcs.tile_changed = rai_tile_changed;
   ai->funcs.city_save = rai_city_save;
   ai->funcs.city_load = rai_city_load;
   ai->funcs.choose_building = rai_build_adv_override;
@@ -162,6 +162,15 @@ static void twai_city_alloc(struct city *pcity)
   TAI_DFUNC(dai_city_alloc, pcity);
 }
 
+/**************************************************************************
+  Call default ai with threaded ai type as parameter.
+**************************************************************************/
+static void twai_tile_changed(struct tile *ptile)
+{
+  TAI_AIT;
+  TAI_DFUNC(dai_settler_tile_changed, ptile);
+}
+
 /**************************************************************************
   Call default ai with threaded ai type as parameter.
 **************************************************************************/
@@ -528,6 +537,7 @@ bool fc_ai_threaded_setup(struct ai_type *ai)
 
   ai->funcs.city_alloc = twai_city_alloc;
   ai->funcs.city_free = twai_city_free;
+  ai->funcs.tile_changed = twai_tile_changed;
   ai->funcs.city_save = twai_city_save;
   ai->funcs.city_load = twai_city_load;
   ai->funcs.choose_building = twai_build_adv_override;
@@ -437,7 +437,6 @@ static void city_changed(int city_id)
   struct city *pcity = game_city_by_number(city_id);
 
   if (pcity) {
-    cm_clear_cache(pcity);
     handle_city(pcity);
   }
 }
@@ -270,7 +270,9 @@ static void client_game_free(void)
   game_free();
   /* update_queue_init() is correct at this point. The queue is reset to
      a clean state which is also needed if the client is not connected to
-     the server! */
+     the server! The connection may have been lost while the server had
+     frozen the client. */
+  update_queue_force_thaw();
   update_queue_init();
 
   client.conn.playing = NULL;
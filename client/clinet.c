@@ -16,6 +16,9 @@
 #endif
 
 #include <errno.h>
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -108,6 +111,10 @@
 static struct fc_sockaddr_list *list = NULL;
 static int name_count;
 
+/* Set while the connection reads a captured packet stream instead of a
+ * server; see connect_to_packet_stream(). */
+static bool packet_stream_replay = FALSE;
+
 /*************************************************************************
   Close socket and cleanup.  This one doesn't print a message, so should
   do so before-hand if necessary.
@@ -275,12 +282,10 @@ int connect_to_server(const char *username, const char *hostname, int port,
 }
 
 /**************************************************************************
-  Called after a connection is completed (e.g., in try_to_connect).
+  Set up the client connection on the given socket.
 **************************************************************************/
-void make_connection(int socket, const char *username)
+static void client_conn_init(int socket)
 {
-  struct packet_server_join_req req;
-
   connection_common_init(&client.conn);
   client.conn.sock = socket;
   client.conn.client.last_request_id_used = 0;
@@ -291,6 +296,17 @@ void make_connection(int socket, const char *username)
 
   /* call gui-dependent stuff in gui_main.c */
   add_net_input(client.conn.sock);
+}
+
+/**************************************************************************
+  Called after a connection is completed (e.g., in try_to_connect).
+**************************************************************************/
+void make_connection(int socket, const char *username)
+{
+  struct packet_server_join_req req;
+
+  packet_stream_replay = FALSE;
+  client_conn_init(socket);
 
   /* now send join_request package */
 
@@ -304,6 +320,32 @@ void make_connection(int socket, const char *username)
   send_packet_server_join_req(&client.conn, &req);
 }
 
+/**************************************************************************
+  Use the file 'filename', holding everything a server sent to one client
+  (as captured by tests/loadtest.sh), as the connection to the server.
+  input_from_server() then handles the packets in it as if the server
+  had just sent them, which allows to time the packet handlers without a
+  server. The packets the client sends are dropped, and the end of the
+  file closes the connection. Returns FALSE if the file can't be opened.
+**************************************************************************/
+bool connect_to_packet_stream(const char *filename)
+{
+  int fd = open(filename, O_RDONLY);
+
+  if (-1 == fd) {
+    log_error("Can't open \"%s\": %s", filename,
+              fc_strerror(fc_get_errno()));
+    return FALSE;
+  }
+
+  packet_stream_replay = TRUE;
+  client_conn_init(fd);
+  /* Keep the answers in the send buffer, where they are dropped. */
+  connection_do_buffer(&client.conn);
+
+  return TRUE;
+}
+
 /**************************************************************************
   Get rid of server connection. This also kills internal server if it's
   used.
@@ -424,6 +466,9 @@ void input_from_server(int fd)
       if (NULL != packet) {
 	client_packet_input(packet, type);
 	free(packet);
+	if (packet_stream_replay && client.conn.used) {
+	  client.conn.send_buffer->ndata = 0;
+	}
       } else {
 	break;
       }
@@ -431,6 +476,10 @@ void input_from_server(int fd)
     if (client.conn.used) {
       agents_thaw_hint();
     }
+  } else if (-2 == nb && packet_stream_replay) {
+    /* The whole stream was replayed. */
+    packet_stream_replay = FALSE;
+    close_socket_nomessage(&client.conn);
   } else if (-2 == nb) {
     connection_close(&client.conn, _("server disconnected"));
   } else {
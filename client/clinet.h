@@ -17,10 +17,14 @@
 extern "C" {
 #endif /* __cplusplus */
 
+/* utility */
+#include "support.h"            /* bool type */
+
 int connect_to_server(const char *username, const char *hostname, int port,
 		      char *errbuf, int errbufsize);
 
 void make_connection(int socket, const char *username);
+bool connect_to_packet_stream(const char *filename);
 
 void input_from_server(int fd);
 void input_from_server_till_request_got_processed(int fd,
@@ -2329,7 +2329,7 @@ void do_move_unit(struct unit *punit, struct unit *target_unit)
     update_unit_info_label(get_units_in_focus());
   }
 
-  unit_list_remove(src_tile->units, punit);
+  tile_remove_unit(src_tile, punit);
 
   if (!unit_transported(punit)) {
     /* Mark the unit as moving unit, then find_visible_unit() won't return
@@ -2352,7 +2352,7 @@ void do_move_unit(struct unit *punit, struct unit *target_unit)
   }
 
   unit_tile_set(punit, dst_tile);
-  unit_list_prepend(dst_tile->units, punit);
+  tile_add_unit(dst_tile, punit);
 
   if (!unit_transported(punit)) {
     /* For find_visible_unit(), see above. */
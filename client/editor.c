@@ -1601,10 +1601,10 @@ static void fill_tile_edit_packet(struct packet_edit_tile *packet,
                     ? terrain_number(pterrain)
                     : terrain_count();
 
-  if (ptile->label == NULL) {
+  if (tile_label(ptile) == NULL) {
     packet->label[0] = '\0';
   } else {
-    strncpy(packet->label, ptile->label, sizeof(packet->label));
+    strncpy(packet->label, tile_label(ptile), sizeof(packet->label));
   }
 }
 
@@ -1538,8 +1538,8 @@ static struct propval *objbind_get_value_from_object(struct objbind *ob,
         pv->must_free = TRUE;
         break;
       case OPID_TILE_LABEL:
-        if (ptile->label != NULL) {
-          pv->data.v_const_string = ptile->label;
+        if (tile_label(ptile) != NULL) {
+          pv->data.v_const_string = tile_label(ptile);
         } else {
           pv->data.v_const_string = "";
         }
@@ -20,6 +20,8 @@
 
 #include "canvas.h"
 
+unsigned long canvas_sprites_drawn = 0;
+
 /****************************************************************************
   Create a canvas of the given size.
 ****************************************************************************/
@@ -57,6 +59,7 @@ void gui_canvas_put_sprite(struct canvas *pcanvas,
                            int offset_x, int offset_y, int width, int height)
 {
   /* PORTME */
+  canvas_sprites_drawn++;
 }
 
 /****************************************************************************
@@ -67,6 +70,7 @@ void gui_canvas_put_sprite_full(struct canvas *pcanvas,
                                 struct sprite *sprite)
 {
   /* PORTME */
+  canvas_sprites_drawn++;
 }
 
 /****************************************************************************
@@ -79,6 +83,7 @@ void gui_canvas_put_sprite_fogged(struct canvas *pcanvas,
                                   bool fog, int fog_x, int fog_y)
 {
   /* PORTME */
+  canvas_sprites_drawn++;
 }
 
 /****************************************************************************
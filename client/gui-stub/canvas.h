@@ -16,5 +16,8 @@
 
 #include "canvas_g.h"
 
+/* The number of sprites drawn, shown by the --replay option. */
+extern unsigned long canvas_sprites_drawn;
+
 
 #endif				/* FC__CANVAS_H */
@@ -34,7 +34,8 @@ struct sprite *radar_gfx_sprite;
 bool gui_isometric_view_supported(void)
 {
   /* PORTME */
-  return FALSE;
+  /* Nothing is drawn, so any tileset will do. */
+  return TRUE;
 }
 
 /****************************************************************************
@@ -43,7 +44,7 @@ bool gui_isometric_view_supported(void)
 bool gui_overhead_view_supported(void)
 {
   /* PORTME */
-  return FALSE;
+  return TRUE;
 }
 
 /****************************************************************************
@@ -16,10 +16,13 @@
 #endif
 
 #include <stdio.h>
+#include <sys/stat.h>
 
 /* utility */
 #include "fciconv.h"
 #include "log.h"
+#include "mem.h"
+#include "timing.h"
 
 /* gui main header */
 #include "gui_stub.h"
@@ -27,9 +30,15 @@
 /* client */
 #include "gui_cbsetter.h"
 #include "client_main.h"
+#include "clinet.h"
 #include "editgui_g.h"
 #include "ggz_g.h"
+#include "mapview_common.h"
 #include "options.h"
+#include "tilespec.h"
+
+/* client/gui-stub */
+#include "canvas.h"
 
 #include "gui_main.h"
 
@@ -38,6 +47,25 @@ const char *client_string = "gui-stub";
 const char * const gui_character_encoding = "UTF-8";
 const bool gui_use_transliteration = FALSE;
 
+struct callback {
+  void (*callback)(void *data);
+  void *data;
+};
+
+#define SPECLIST_TAG callback
+#define SPECLIST_TYPE struct callback
+#include "speclist.h"
+
+/* Only used while replaying a packet stream, see replay_packet_stream(). */
+static struct callback_list *callbacks = NULL;
+static int net_input = -1;
+
+static const char *replay_file = NULL;
+
+/* The size of the map view drawn while replaying. */
+#define REPLAY_MAPVIEW_WIDTH 1600
+#define REPLAY_MAPVIEW_HEIGHT 1000
+
 /****************************************************************************
   Called by the tileset code to set the font size that should be used to
   draw the city names and productions.
@@ -75,7 +103,9 @@ static void print_usage(const char *argv0)
   /* PORTME */
   /* add client-specific usage information here */
   fc_fprintf(stderr,
-             _("This client has no special command line options\n\n"));
+             _("This client accepts these command line options:\n\n"));
+  fc_fprintf(stderr, _("  --replay FILE\tHandle the packets a server "
+                       "sent, as captured in FILE, time it and quit\n\n"));
 
   /* TRANS: No full stop after the URL, could cause confusion. */
   fc_fprintf(stderr, _("Report bugs at %s\n"), BUG_URL);
@@ -89,9 +119,13 @@ static void parse_options(int argc, char **argv)
   int i = 1;
 
   while (i < argc) {
+    char *option = NULL;
+
     if (is_option("--help", argv[i])) {
       print_usage(argv[0]);
       exit(EXIT_SUCCESS);
+    } else if ((option = get_option_malloc("--replay", argv, &i, argc))) {
+      replay_file = option;
     } else {
       fc_fprintf(stderr, _("Unrecognized option: \"%s\"\n"), argv[i]);
       exit(EXIT_FAILURE);
@@ -101,6 +135,54 @@ static void parse_options(int argc, char **argv)
   }
 }
 
+/**************************************************************************
+  Handle the packets of the captured packet stream 'filename', with the
+  idle callbacks run after each read like in the main loop of a real
+  client, and print how long it took. The map view is drawn (to no
+  canvas) as if it was REPLAY_MAPVIEW_WIDTH x REPLAY_MAPVIEW_HEIGHT
+  pixels big.
+**************************************************************************/
+static void replay_packet_stream(const char *filename)
+{
+  struct timer *t = timer_new(TIMER_CPU, TIMER_ACTIVE);
+  unsigned long counters[PERF_LAST];
+  struct stat buf;
+
+  callbacks = callback_list_new();
+  map_canvas_resized(REPLAY_MAPVIEW_WIDTH, REPLAY_MAPVIEW_HEIGHT);
+  if (!connect_to_packet_stream(filename)) {
+    exit(EXIT_FAILURE);
+  }
+
+  perf_counters_enable(TRUE);
+  timer_start(t);
+  while (-1 != net_input || 0 < callback_list_size(callbacks)) {
+    if (-1 != net_input) {
+      input_from_server(net_input);
+    }
+    while (0 < callback_list_size(callbacks)) {
+      struct callback *cb = callback_list_front(callbacks);
+
+      callback_list_pop_front(callbacks);
+      (cb->callback)(cb->data);
+      free(cb);
+    }
+  }
+  timer_stop(t);
+  perf_counters_enable(FALSE);
+  perf_counters_read(counters);
+
+  fc_stat(filename, &buf);
+  fc_printf("%s: %ld bytes in %.3f seconds, %lu allocations, "
+            "%lu sprites drawn\n",
+            filename, (long) buf.st_size, timer_read_seconds(t),
+            counters[PERF_ALLOCS], canvas_sprites_drawn);
+
+  timer_destroy(t);
+  callback_list_destroy(callbacks);
+  callbacks = NULL;
+}
+
 /**************************************************************************
   The main loop for the UI.  This is called from main(), and when it
   exits the client will exit.
@@ -112,7 +194,14 @@ void gui_ui_main(int argc, char *argv[])
   /* PORTME */
   fc_fprintf(stderr, "Freeciv rules!\n");
 
+  tileset_init(tileset);
+  tileset_load_tiles(tileset);
+  init_mapcanvas_and_overview();
+
   /* Main loop here */
+  if (NULL != replay_file) {
+    replay_packet_stream(replay_file);
+  }
 
   start_quitting();
 }
@@ -168,6 +257,7 @@ void gui_sound_bell(void)
 void gui_add_net_input(int sock)
 {
   /* PORTME */
+  net_input = sock;
 }
 
 /**************************************************************************
@@ -178,6 +268,7 @@ void gui_add_net_input(int sock)
 void gui_remove_net_input(void)
 {
   /* PORTME */
+  net_input = -1;
 }
 
 /**************************************************************************
@@ -243,6 +334,14 @@ void gui_real_focus_units_changed(void)
 void gui_add_idle_callback(void (callback)(void *), void *data)
 {
   /* PORTME */
+  if (NULL != callbacks) {
+    struct callback *cb = fc_malloc(sizeof(*cb));
+
+    cb->callback = callback;
+    cb->data = data;
+    callback_list_append(callbacks, cb);
+    return;
+  }
 
   /* This is a reasonable fallback if it's not ported. */
   log_error("Unimplemented add_idle_callback.");
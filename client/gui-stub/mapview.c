@@ -41,6 +41,11 @@ void update_info_label(void)
   /* PORTME */
   char buffer[512];
 
+  if (NULL == client.conn.playing) {
+    /* Observing. */
+    return;
+  }
+
   fc_snprintf(buffer, sizeof(buffer),
               _("Population: %s\n"
                 "Year: %s\n"
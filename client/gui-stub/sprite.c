@@ -15,7 +15,13 @@
 #include <fc_config.h>
 #endif
 
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+/* utility */
+#include "mem.h"
+#include "support.h"
 
 /* gui main header */
 #include "gui_stub.h"
@@ -49,7 +55,29 @@ const char **gfx_fileextensions(void)
 struct sprite *gui_load_gfxfile(const char *filename)
 {
   /* PORTME */
-  return NULL;
+  /* Only the size is read, from the IHDR chunk of the png file. */
+  unsigned char header[24];
+  struct sprite *s;
+  FILE *fp = fc_fopen(filename, "rb");
+
+  if (NULL == fp) {
+    return NULL;
+  }
+  if (1 != fread(header, sizeof(header), 1, fp)
+      || 0 != memcmp(header, "\x89PNG\r\n\x1a\n", 8)
+      || 0 != memcmp(header + 12, "IHDR", 4)) {
+    fclose(fp);
+    return NULL;
+  }
+  fclose(fp);
+
+  s = fc_malloc(sizeof(*s));
+  s->width = (header[16] << 24) | (header[17] << 16)
+             | (header[18] << 8) | header[19];
+  s->height = (header[20] << 24) | (header[21] << 16)
+              | (header[22] << 8) | header[23];
+
+  return s;
 }
 
 /****************************************************************************
@@ -79,7 +107,7 @@ struct sprite *gui_crop_sprite(struct sprite *source,
                                int mask_offset_x, int mask_offset_y)
 {
   /* PORTME */
-  return NULL;
+  return gui_create_sprite(width, height, NULL);
 }
 
 /****************************************************************************
@@ -88,7 +116,12 @@ struct sprite *gui_crop_sprite(struct sprite *source,
 struct sprite *gui_create_sprite(int width, int height, struct color *pcolor)
 {
   /* PORTME */
-  return NULL;
+  struct sprite *s = fc_malloc(sizeof(*s));
+
+  s->width = width;
+  s->height = height;
+
+  return s;
 }
 
 /****************************************************************************
@@ -97,10 +130,8 @@ struct sprite *gui_create_sprite(int width, int height, struct color *pcolor)
 void gui_get_sprite_dimensions(struct sprite *sprite, int *width, int *height)
 {
   /* PORTME */
-#if 0
   *width = sprite->width;
   *height = sprite->height;
-#endif
 }
 
 /****************************************************************************
@@ -109,4 +140,5 @@ void gui_get_sprite_dimensions(struct sprite *sprite, int *width, int *height)
 void gui_free_sprite(struct sprite *s)
 {
   /* PORTME */
+  free(s);
 }
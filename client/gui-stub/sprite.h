@@ -16,5 +16,10 @@
 
 #include "sprite_g.h"
 
+/* The stub draws nothing, so its sprites only have a size. */
+struct sprite {
+  int width, height;
+};
+
 
 #endif				/* FC__SPRITE_H */
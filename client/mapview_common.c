@@ -1861,11 +1861,12 @@ static void show_tile_label(struct canvas *pcanvas,
   canvas_x += tileset_tile_width(tileset) / 2;
   canvas_y += tileset_tilelabel_offset_y(tileset);
 
-  get_text_size(width, height, FONT_TILE_LABEL, ptile->label);
+  get_text_size(width, height, FONT_TILE_LABEL, tile_label(ptile));
 
   canvas_put_text(pcanvas, canvas_x - *width / 2, canvas_y,
                   FONT_TILE_LABEL,
-                  get_color(tileset, COLOR_MAPVIEW_TILELABEL), ptile->label);
+                  get_color(tileset, COLOR_MAPVIEW_TILELABEL),
+                  tile_label(ptile));
 #undef COLOR_MAPVIEW_TILELABEL
 }
 
@@ -1958,19 +1959,20 @@ void show_tile_labels(int canvas_x, int canvas_y,
     const int canvas_x = gui_x - mapview.gui_x0;
     const int canvas_y = gui_y - mapview.gui_y0;
 
-    if (ptile && ptile->label != NULL) {
+    if (ptile && tile_label(ptile) != NULL) {
       int width = 0, height = 0;
 
       show_tile_label(mapview.store, canvas_x, canvas_y,
                       ptile, &width, &height);
-      log_debug("Drawing label %s.", ptile->label);
+      log_debug("Drawing label %s.", tile_label(ptile));
 
       if (width > max_label_width || height > max_label_height) {
         /* The update was incomplete! We queue a new update. Note that
          * this is recursively queueing an update within a dequeuing of an
          * update. This is allowed specifically because of the code in
          * unqueue_mapview_updates. See that function for more. */
-        log_debug("Re-queuing tile label %s drawing.", ptile->label);
+        log_debug("Re-queuing tile label %s drawing.",
+                  tile_label(ptile));
         update_tile_label(ptile);
       }
       new_max_width = MAX(width, new_max_width);
@@ -2444,6 +2446,17 @@ static bool callback_queued = FALSE;
  * area.  A tile update covers the base tile plus half a tile in each
  * direction. */
 struct tile_list *tile_updates[TILE_UPDATE_COUNT];
+/* The tiles already in tile_updates[], indexed by tile index, so that each
+ * tile is queued only once per update type. */
+static struct dbv tile_updates_queued[TILE_UPDATE_COUNT];
+
+/* The areas covered by the tile updates are merged into at most this many
+ * rectangles, each redrawn by one call to update_map_canvas(). */
+#define MAX_DIRTY_RECTS 16
+
+struct dirty_rect {
+  int x0, y0, x1, y1;
+};
 
 /****************************************************************************
   This callback is called during an idle moment to unqueue any pending
@@ -2503,6 +2516,16 @@ void queue_mapview_tile_update(struct tile *ptile,
 			       enum tile_update_type type)
 {
   if (can_client_change_view()) {
+    struct dbv *pqueued = &tile_updates_queued[type];
+
+    if (dbv_bits(pqueued) != MAP_INDEX_SIZE) {
+      dbv_resize(pqueued, MAP_INDEX_SIZE);
+    } else if (dbv_isset(pqueued, tile_index(ptile))) {
+      /* Already queued. */
+      return;
+    }
+    dbv_set(pqueued, tile_index(ptile));
+
     if (!tile_updates[type]) {
       tile_updates[type] = tile_list_new();
     }
@@ -2511,6 +2534,51 @@ void queue_mapview_tile_update(struct tile *ptile,
   }
 }
 
+/**************************************************************************
+  Add the canvas area (x0, y0) - (x1, y1) to the dirty rectangles. It is
+  merged into an existing rectangle if their union is no bigger than the
+  two areas together; when all rectangles are used it is merged into the
+  one which grows the least.
+**************************************************************************/
+static void dirty_rect_add(struct dirty_rect *rects, int *count,
+                           int x0, int y0, int x1, int y1)
+{
+  int best = -1, best_growth = 0, i;
+
+  for (i = 0; i < *count; i++) {
+    struct dirty_rect *prect = &rects[i];
+    int ux0 = MIN(prect->x0, x0), uy0 = MIN(prect->y0, y0);
+    int ux1 = MAX(prect->x1, x1), uy1 = MAX(prect->y1, y1);
+    int growth = (ux1 - ux0) * (uy1 - uy0)
+                 - (prect->x1 - prect->x0) * (prect->y1 - prect->y0);
+
+    if (growth <= (x1 - x0) * (y1 - y0)) {
+      /* No more to redraw than the two areas apart. */
+      best = i;
+      break;
+    }
+    if (best == -1 || growth < best_growth) {
+      best = i;
+      best_growth = growth;
+    }
+  }
+
+  if (i == *count && *count < MAX_DIRTY_RECTS) {
+    rects[*count].x0 = x0;
+    rects[*count].y0 = y0;
+    rects[*count].x1 = x1;
+    rects[*count].y1 = y1;
+    (*count)++;
+  } else {
+    struct dirty_rect *prect = &rects[best];
+
+    prect->x0 = MIN(prect->x0, x0);
+    prect->y0 = MIN(prect->y0, y0);
+    prect->x1 = MAX(prect->x1, x1);
+    prect->y1 = MAX(prect->y1, y1);
+  }
+}
+
 /**************************************************************************
   See comment for queue_mapview_update().
 **************************************************************************/
@@ -2564,6 +2632,9 @@ void unqueue_mapview_updates(bool write_to_screen)
   for (i = 0; i < TILE_UPDATE_COUNT; i++) {
     my_tile_updates[i] = tile_updates[i];
     tile_updates[i] = NULL;
+    if (my_tile_updates[i]) {
+      dbv_clr_all(&tile_updates_queued[i]);
+    }
   }
 
   if (map_exists()) {
@@ -2576,8 +2647,8 @@ void unqueue_mapview_updates(bool write_to_screen)
       /* Have to update the overview too, since some tiles may have changed. */
       refresh_overview_canvas();
     } else {
-      int min_x = mapview.width, min_y = mapview.height;
-      int max_x = 0, max_y = 0;
+      struct dirty_rect rects[MAX_DIRTY_RECTS];
+      int nrects = 0;
       int i;
 
       for (i = 0; i < TILE_UPDATE_COUNT; i++) {
@@ -2594,10 +2665,7 @@ void unqueue_mapview_updates(bool write_to_screen)
 
 	    if (x1 > 0 && x0 < mapview.width
 		&& y1 > 0 && y0 < mapview.height) {
-	      min_x = MIN(min_x, x0);
-	      min_y = MIN(min_y, y0);
-	      max_x = MAX(max_x, x1);
-	      max_y = MAX(max_y, y1);
+	      dirty_rect_add(rects, &nrects, x0, y0, x1, y1);
 	    }
 
 	    /* FIXME: These overview updates should be batched as well.
@@ -2608,8 +2676,31 @@ void unqueue_mapview_updates(bool write_to_screen)
 	}
       }
 
-      if (min_x < max_x && min_y < max_y) {
-	update_map_canvas(min_x, min_y, max_x - min_x, max_y - min_y);
+      if (0 < nrects) {
+        struct dirty_rect bounds = rects[0];
+        int sum = 0;
+
+        for (i = 0; i < nrects; i++) {
+          bounds.x0 = MIN(bounds.x0, rects[i].x0);
+          bounds.y0 = MIN(bounds.y0, rects[i].y0);
+          bounds.x1 = MAX(bounds.x1, rects[i].x1);
+          bounds.y1 = MAX(bounds.y1, rects[i].y1);
+          sum += (rects[i].x1 - rects[i].x0) * (rects[i].y1 - rects[i].y0);
+        }
+
+        if (sum >= (bounds.x1 - bounds.x0) * (bounds.y1 - bounds.y0)) {
+          /* The rectangles overlap so much that drawing them apart would
+           * cost more than the one rectangle around them all. */
+          rects[0] = bounds;
+          nrects = 1;
+        }
+      }
+
+      /* Redraw the scattered changed areas apart instead of the whole
+       * rectangle around them. */
+      for (i = 0; i < nrects; i++) {
+	update_map_canvas(rects[i].x0, rects[i].y0,
+			  rects[i].x1 - rects[i].x0, rects[i].y1 - rects[i].y0);
       }
     }
   }
@@ -3109,8 +3200,14 @@ void init_mapcanvas_and_overview(void)
 **************************************************************************/
 void free_mapcanvas_and_overview(void)
 {
+  int i;
+
   canvas_free(mapview.store);
   canvas_free(mapview.tmp_store);
+
+  for (i = 0; i < TILE_UPDATE_COUNT; i++) {
+    dbv_free(&tile_updates_queued[i]);
+  }
 }
 
 /****************************************************************************
@@ -120,6 +120,11 @@ static struct {
   int parts;
 } page_msg_report = { .parts = 0 };
 
+/* Set when a unit packet needed the focus unit to be checked while the
+ * server had frozen the client; the check is then done once at the thaw
+ * instead of for every unit. */
+static bool unit_focus_update_pending = FALSE;
+
 /****************************************************************************
   Called below, and by client/client_main.c client_game_free()
 ****************************************************************************/
@@ -135,6 +140,8 @@ void packhand_free(void)
     invisible.cities = NULL;
   }
 
+  unit_focus_update_pending = FALSE;
+
   if (NULL != invisible.placeholder) {
     free(invisible.placeholder);
     invisible.placeholder = NULL;
@@ -1677,7 +1684,7 @@ static bool handle_unit_packet_common(struct unit *packet_unit)
     idex_register_unit(punit);
 
     unit_list_prepend(unit_owner(punit)->units, punit);
-    unit_list_prepend(unit_tile(punit)->units, punit);
+    tile_add_unit(unit_tile(punit), punit);
 
     unit_register_battlegroup(punit);
 
@@ -1762,7 +1769,11 @@ static bool handle_unit_packet_common(struct unit *packet_unit)
       && NULL != client.conn.playing
       && !client.conn.playing->ai_controlled
       && is_player_phase(client.conn.playing, game.info.phase)) {
-    unit_focus_update();
+    if (update_queue_is_frozen()) {
+      unit_focus_update_pending = TRUE;
+    } else {
+      unit_focus_update();
+    }
   }
 
   if (need_menus_update) {
@@ -2812,18 +2823,14 @@ void handle_tile_info(const struct packet_tile_info *packet)
   new_known = client_tile_get_known(ptile);
 
   if (packet->spec_sprite[0] != '\0') {
-    if (!ptile->spec_sprite
-	|| strcmp(ptile->spec_sprite, packet->spec_sprite) != 0) {
-      if (ptile->spec_sprite) {
-	free(ptile->spec_sprite);
-      }
-      ptile->spec_sprite = fc_strdup(packet->spec_sprite);
+    if (!tile_spec_sprite(ptile)
+	|| strcmp(tile_spec_sprite(ptile), packet->spec_sprite) != 0) {
+      tile_set_spec_sprite(ptile, packet->spec_sprite);
       tile_changed = TRUE;
     }
   } else {
-    if (ptile->spec_sprite) {
-      free(ptile->spec_sprite);
-      ptile->spec_sprite = NULL;
+    if (tile_spec_sprite(ptile)) {
+      tile_set_spec_sprite(ptile, NULL);
       tile_changed = TRUE;
     }
   }
@@ -2838,19 +2845,19 @@ void handle_tile_info(const struct packet_tile_info *packet)
     } unit_list_iterate_end;
     fc_assert_msg(0 == unit_list_size(ptile->units), "Ghost units seen");
     /* Repairing... */
-    unit_list_clear(ptile->units);
+    tile_units_clear(ptile);
   }
 
   ptile->continent = packet->continent;
   map.num_continents = MAX(ptile->continent, map.num_continents);
 
   if (packet->label[0] == '\0') {
-    if (ptile->label != NULL) {
-      FC_FREE(ptile->label);
-      ptile->label = NULL;
+    if (tile_label(ptile) != NULL) {
+      tile_set_label(ptile, NULL);
       tile_changed = TRUE;
     }
-  } else if (ptile->label == NULL || strcmp(packet->label, ptile->label)) {
+  } else if (tile_label(ptile) == NULL
+             || strcmp(packet->label, tile_label(ptile))) {
       tile_set_label(ptile, packet->label);
       tile_changed = TRUE;
   }
@@ -3976,6 +3983,10 @@ void handle_freeze_client(void)
   log_debug("handle_freeze_client");
 
   agents_freeze_hint();
+  /* The server is about to send many packets at once (e.g. at turn
+   * change). Hold back the refreshes of the reports, dialogs and menus
+   * until it is done, so that each is refreshed only once. */
+  update_queue_freeze();
 }
 
 /**************************************************************************
@@ -3986,6 +3997,16 @@ void handle_thaw_client(void)
   log_debug("handle_thaw_client");
 
   agents_thaw_hint();
+  update_queue_thaw();
+  if (unit_focus_update_pending && !update_queue_is_frozen()) {
+    unit_focus_update_pending = FALSE;
+    /* Check again, the player or the phase may have changed meanwhile. */
+    if (NULL != client.conn.playing
+        && !client.conn.playing->ai_controlled
+        && is_player_phase(client.conn.playing, game.info.phase)) {
+      unit_focus_update();
+    }
+  }
   update_turn_done_button_state();
 }
 
@@ -4577,7 +4577,8 @@ static int fill_terrain_sprite_layer(struct tileset *t,
   /* Skip the normal drawing process. */
   /* FIXME: this should avoid calling load_sprite since it's slow and
    * increases the refcount without limit. */
-  if (ptile->spec_sprite && (sprite = load_sprite(t, ptile->spec_sprite))) {
+  if (tile_spec_sprite(ptile)
+      && (sprite = load_sprite(t, tile_spec_sprite(ptile)))) {
     if (l == 0) {
       ADD_SPRITE_SIMPLE(sprite);
       return 1;
@@ -22,7 +22,7 @@ extern "C" {
 
 /* Update this capability string when ever there is changes to ai_type
    structure below */
-#define FC_AI_MOD_CAPSTR "+Freeciv-2.5a-ai-module"
+#define FC_AI_MOD_CAPSTR "+Freeciv-2.5a-ai-module-2"
 
 /* Timers for all AI activities. Define it to get statistics about the AI. */
 #ifdef DEBUG
@@ -99,6 +99,10 @@ struct ai_type
     /* Called for player AI type when player loses control of city. */
     void (*city_lost)(struct player *pplayer, struct city *pcity);
 
+    /* Called for every AI type when the owner of a tile changes, or when
+     * a city is founded on it or removed from it. */
+    void (*tile_changed)(struct tile *ptile);
+
     /* Called for every AI type for each city in game when game saved. */
     void (*city_save)(struct section_file *file, const struct city *pcity,
                       const char *citystr);
@@ -52,6 +52,9 @@
 
 static int *citymap = NULL;
 
+/* Incremented every time the citymap is rebuilt from scratch. */
+static int citymap_serial = 0;
+
 #define log_citymap log_debug
 
 /**************************************************************************
@@ -65,6 +68,7 @@ void citymap_turn_init(struct player *pplayer)
    * of the game (but it's easier than a separate function to do this). */
   citymap = fc_realloc(citymap, MAP_INDEX_SIZE * sizeof(*citymap));
   memset(citymap, 0, MAP_INDEX_SIZE * sizeof(*citymap));
+  citymap_serial++;
 
   players_iterate(pother) {
     city_list_iterate(pother->cities, pcity) {
@@ -102,6 +106,16 @@ void citymap_turn_init(struct player *pplayer)
   } unit_list_iterate_end;
 }
 
+/**************************************************************************
+  Return the number of times the citymap has been rebuilt. Data derived
+  from the citymap is stale once this changes; incremental changes made
+  through citymap_reserve_*() and citymap_free_city_spot() do not count.
+**************************************************************************/
+int citymap_get_serial(void)
+{
+  return citymap_serial;
+}
+
 /**************************************************************************
   Free resources allocated for citymap.
 **************************************************************************/
@@ -30,6 +30,7 @@ void citymap_free_city_spot(struct tile *ptile, int id);
 void citymap_reserve_tile(struct tile *ptile, int id);
 int citymap_read(struct tile *ptile);
 bool citymap_is_reserved(struct tile *ptile);
+int citymap_get_serial(void);
 
 void citymap_free(void);
 
@@ -27,11 +27,14 @@
 #include "timing.h"
 
 /* common */
+#include "citizens.h"
 #include "city.h"
+#include "effects.h"
 #include "game.h"
 #include "government.h"
 #include "map.h"
 #include "specialist.h"
+#include "unitlist.h"
 
 #include "cm.h"
 
@@ -276,6 +279,59 @@ static void real_print_partial_solution(enum log_level level,
 static void cm_result_copy(struct cm_result *result,
                            const struct city *pcity, bool *workers_map);
 
+/*
+ * The result store. The results of the last queries for each city are
+ * kept together with a hash of the inputs of the search: the parameter,
+ * the tile lattice, the tax rates and the refreshed city. A query with
+ * the same inputs reuses the stored result once the stored arrangement
+ * is checked to still give the same surplus, instead of running the
+ * search again. So callers don't need to call cm_clear_cache() before
+ * each query.
+ *
+ * The check only confirms that the stored arrangement is still valid and
+ * gives what it gave before. It doesn't prove that no better arrangement
+ * exists: an input which isn't part of the hash could have made another
+ * arrangement better. So a reused result may be non-optimal, though it
+ * always satisfies the parameter. Searches which found no arrangement
+ * have nothing to check and are not stored.
+ */
+
+/* Number of results remembered per city. The AI governor queries each
+ * city once for every tax rate it tries. */
+#define CM_CACHE_SLOTS 16
+
+/* Output for which the waste of a city is hashed into the key. */
+#define CM_CACHE_WASTE_PROBE 1000
+
+struct cm_cache_entry {
+  struct cm_parameter parameter;
+  unsigned int key;             /* see cm_cache_key() */
+  struct cm_result *result;     /* NULL for an unused slot */
+};
+
+struct cm_cache_city {
+  struct cm_cache_entry slots[CM_CACHE_SLOTS];
+  int next;                     /* next slot to replace */
+};
+
+static void cm_cache_city_destroy(struct cm_cache_city *pcache);
+
+#define SPECHASH_TAG cm_cache
+#define SPECHASH_KEY_TYPE int
+#define SPECHASH_DATA_TYPE struct cm_cache_city *
+#define SPECHASH_KEY_TO_PTR FC_INT_TO_PTR
+#define SPECHASH_PTR_TO_KEY FC_PTR_TO_INT
+#define SPECHASH_DATA_FREE cm_cache_city_destroy
+#include "spechash.h"
+
+static struct cm_cache_hash *cm_cache = NULL;
+
+static struct {
+  int queries;
+  int hits;
+  int rejected;                 /* same inputs, but the check failed */
+} cm_cache_stats;
+
 static double estimate_fitness(const struct cm_state *state,
 			       const int production[]);
 static bool choice_is_promising(struct cm_state *state, int newchoice);
@@ -314,7 +370,9 @@ void cm_init_citymap(void)
 ****************************************************************************/
 void cm_clear_cache(struct city *pcity)
 {
-  /* The B&B algorithm doesn't have city caches so there's nothing to do. */
+  if (NULL != cm_cache) {
+    cm_cache_hash_remove(cm_cache, pcity->id);
+  }
 }
 
 /****************************************************************************
@@ -322,6 +380,19 @@ void cm_clear_cache(struct city *pcity)
 ****************************************************************************/
 void cm_free(void)
 {
+  if (0 < cm_cache_stats.queries) {
+    log_verbose("CM result store: %d queries, %d hits (%.1f%%), "
+                "%d rejected.", cm_cache_stats.queries, cm_cache_stats.hits,
+                100.0 * cm_cache_stats.hits / cm_cache_stats.queries,
+                cm_cache_stats.rejected);
+  }
+  memset(&cm_cache_stats, 0, sizeof(cm_cache_stats));
+
+  if (NULL != cm_cache) {
+    cm_cache_hash_destroy(cm_cache);
+    cm_cache = NULL;
+  }
+
 #ifdef GATHER_TIME_STATS
   print_performance(&performance.greedy);
   print_performance(&performance.opt);
@@ -1975,22 +2046,258 @@ static void cm_find_best_solution(struct cm_state *state,
   end_search(state);
 }
 
+/****************************************************************************
+  Free the stored results of a city.
+****************************************************************************/
+static void cm_cache_city_destroy(struct cm_cache_city *pcache)
+{
+  int i;
+
+  for (i = 0; i < CM_CACHE_SLOTS; i++) {
+    cm_result_destroy(pcache->slots[i].result);
+  }
+  free(pcache);
+}
+
+/****************************************************************************
+  Hash the inputs of a search other than the parameter: the tile lattice,
+  the tax rates and everything of the refreshed city which doesn't depend
+  on its arrangement but changes its outputs, waste or happiness. The
+  latter includes the state of the effects from other cities (wonders),
+  the empire size and the units of the city (see city_support()).
+****************************************************************************/
+static unsigned int cm_cache_key(const struct cm_state *state)
+{
+  const struct city *pcity = state->pcity;
+  const struct player *pplayer = city_owner(pcity);
+  const enum effect_type happy_effects[] = {
+    EFT_MAKE_CONTENT, EFT_FORCE_CONTENT, EFT_MAKE_HAPPY, EFT_NO_UNHAPPY,
+    EFT_HAPPINESS_TO_GOLD, EFT_ENEMY_CITIZEN_UNHAPPY_PCT
+  };
+  unsigned int key = 2166136261u;
+  int rates[3], i;
+
+#define CM_KEY_ADD(value) key = (key ^ (unsigned int) (value)) * 16777619u
+
+  CM_KEY_ADD(city_size_get(pcity));
+  CM_KEY_ADD(city_map_radius_sq_get(pcity));
+  CM_KEY_ADD(government_number(government_of_player(pplayer)));
+  CM_KEY_ADD(player_is_cpuhog(pplayer));
+  get_tax_rates(pplayer, rates);
+  for (i = 0; i < ARRAY_SIZE(rates); i++) {
+    CM_KEY_ADD(rates[i]);
+  }
+
+  output_type_iterate(o) {
+    CM_KEY_ADD(pcity->usage[o]);
+    CM_KEY_ADD(pcity->bonus[o]);
+    /* The waste rate, including the distance to the government center. */
+    CM_KEY_ADD(city_waste(pcity, o, CM_CACHE_WASTE_PROBE, NULL));
+  } output_type_iterate_end;
+  city_built_iterate(pcity, pimprove) {
+    CM_KEY_ADD(improvement_number(pimprove));
+  } city_built_iterate_end;
+
+  /* Happiness: see citizen_base_mood() and the following functions. */
+  CM_KEY_ADD(player_content_citizens(pplayer));
+  CM_KEY_ADD(player_angry_citizens(pplayer));
+  for (i = 0; i < ARRAY_SIZE(happy_effects); i++) {
+    CM_KEY_ADD(get_city_bonus(pcity, happy_effects[i]));
+  }
+  if (game.info.citizen_nationality
+      && 0 < get_city_bonus(pcity, EFT_ENEMY_CITIZEN_UNHAPPY_PCT)) {
+    citizens_foreign_iterate(pcity, pslot, nationality) {
+      if (pplayers_at_war(pplayer, player_slot_get_player(pslot))) {
+        CM_KEY_ADD(player_slot_index(pslot));
+        CM_KEY_ADD(nationality);
+      }
+    } citizens_foreign_iterate_end;
+  }
+  /* Set by city_support() from the type, place and activity of the
+   * units in the city and of the units supported by it. */
+  CM_KEY_ADD(pcity->martial_law);
+  CM_KEY_ADD(pcity->unit_happy_upkeep);
+
+  tile_type_vector_iterate(&state->lattice, ptype) {
+    output_type_iterate(o) {
+      CM_KEY_ADD(ptype->production[o]);
+    } output_type_iterate_end;
+    if (ptype->is_specialist) {
+      CM_KEY_ADD(-1 - ptype->spec);
+    } else {
+      CM_KEY_ADD(tile_vector_size(&ptype->tiles));
+      for (i = 0; i < tile_vector_size(&ptype->tiles); i++) {
+        CM_KEY_ADD(ptype->tiles.p[i].index);
+      }
+    }
+  } tile_type_vector_iterate_end;
+
+#undef CM_KEY_ADD
+
+  return key;
+}
+
+/****************************************************************************
+  Check that the stored arrangement still gives the stored surplus and
+  happiness for the city. The city is restored afterwards.
+****************************************************************************/
+static bool cm_cache_result_holds(struct cm_state *state,
+                                  const struct cm_result *stored)
+{
+  struct city *pcity = state->pcity;
+  struct city backup;
+  int surplus[O_LAST];
+  bool disorder, happy, holds = TRUE;
+
+  memcpy(&backup, pcity, sizeof(backup));
+
+  memcpy(pcity->specialists, stored->specialists,
+         sizeof(pcity->specialists));
+  memcpy(state->workers_map, stored->worker_positions,
+         city_map_tiles(stored->city_radius_sq)
+         * sizeof(*state->workers_map));
+  city_refresh_from_main_map(pcity, state->workers_map);
+  get_city_surplus(pcity, surplus, &disorder, &happy);
+
+  output_type_iterate(o) {
+    if (surplus[o] != stored->surplus[o]) {
+      holds = FALSE;
+    }
+  } output_type_iterate_end;
+  if (disorder != stored->disorder || happy != stored->happy) {
+    holds = FALSE;
+  }
+
+  memcpy(pcity, &backup, sizeof(backup));
+
+  return holds;
+}
+
+/****************************************************************************
+  Copy a stored result into the caller's result.
+****************************************************************************/
+static void cm_cache_result_get(const struct cm_cache_entry *pentry,
+                                struct cm_result *result)
+{
+  const struct cm_result *stored = pentry->result;
+
+  result->found_a_valid = stored->found_a_valid;
+  result->disorder = stored->disorder;
+  result->happy = stored->happy;
+  memcpy(result->surplus, stored->surplus, sizeof(result->surplus));
+  memcpy(result->specialists, stored->specialists,
+         sizeof(result->specialists));
+  memcpy(result->worker_positions, stored->worker_positions,
+         city_map_tiles(stored->city_radius_sq)
+         * sizeof(*result->worker_positions));
+}
+
+/****************************************************************************
+  Store the result of a search into the slot 'pentry'.
+****************************************************************************/
+static void cm_cache_result_set(struct cm_cache_entry *pentry,
+                                const struct cm_parameter *param,
+                                unsigned int key,
+                                const struct cm_result *result)
+{
+  if (NULL != pentry->result
+      && pentry->result->city_radius_sq != result->city_radius_sq) {
+    cm_result_destroy(pentry->result);
+    pentry->result = NULL;
+  }
+  if (NULL == pentry->result) {
+    pentry->result = fc_calloc(1, sizeof(*pentry->result));
+    pentry->result->city_radius_sq = result->city_radius_sq;
+    pentry->result->worker_positions
+      = fc_calloc(city_map_tiles(result->city_radius_sq),
+                  sizeof(*pentry->result->worker_positions));
+  }
+
+  cm_copy_parameter(&pentry->parameter, param);
+  pentry->key = key;
+  pentry->result->found_a_valid = result->found_a_valid;
+  pentry->result->disorder = result->disorder;
+  pentry->result->happy = result->happy;
+  memcpy(pentry->result->surplus, result->surplus,
+         sizeof(pentry->result->surplus));
+  memcpy(pentry->result->specialists, result->specialists,
+         sizeof(pentry->result->specialists));
+  memcpy(pentry->result->worker_positions, result->worker_positions,
+         city_map_tiles(result->city_radius_sq)
+         * sizeof(*pentry->result->worker_positions));
+}
+
 /***************************************************************************
   Wrapper that actually runs the branch & bound, and returns the best
-  solution.
+  solution. The result of an earlier query with the same inputs is reused
+  if its arrangement still gives the stored surplus. As this check
+  doesn't repeat the search, a reused result may be non-optimal; see
+  the comment on the result store above.
  ***************************************************************************/
 void cm_query_result(struct city *pcity,
 		     const struct cm_parameter *param,
 		     struct cm_result *result)
 {
   struct cm_state *state = cm_state_init(pcity);
+  struct cm_cache_city *pcache = NULL;
+  struct cm_cache_entry *pentry = NULL;
+  unsigned int key;
+  int i;
+
+  PERF_COUNT(PERF_CM_QUERIES, 1);
+  cm_cache_stats.queries++;
 
   /* Refresh the city.  Otherwise the CM can give wrong results or just be
    * slower than necessary.  Note that cities are often passed in in an
    * unrefreshed state (which should probably be fixed). */
   city_refresh_from_main_map(pcity, NULL);
 
-  cm_find_best_solution(state, param, result);
+  key = cm_cache_key(state);
+  if (NULL == cm_cache) {
+    cm_cache = cm_cache_hash_new();
+  }
+  if (!cm_cache_hash_lookup(cm_cache, pcity->id, &pcache)) {
+    pcache = fc_calloc(1, sizeof(*pcache));
+    cm_cache_hash_insert(cm_cache, pcity->id, pcache);
+  }
+
+  for (i = 0; i < CM_CACHE_SLOTS; i++) {
+    struct cm_cache_entry *pslot = &pcache->slots[i];
+
+    if (NULL != pslot->result && pslot->key == key
+        && pslot->result->city_radius_sq == result->city_radius_sq
+        && cm_are_parameter_equal(&pslot->parameter, param)) {
+      pentry = pslot;
+      break;
+    }
+  }
+
+  if (NULL != pentry && cm_cache_result_holds(state, pentry->result)) {
+    PERF_COUNT(PERF_CM_CACHE_HITS, 1);
+    cm_cache_stats.hits++;
+    cm_cache_result_get(pentry, result);
+  } else {
+    if (NULL != pentry) {
+      cm_cache_stats.rejected++;
+    }
+
+    cm_find_best_solution(state, param, result);
+    if (0 != state->best.idle) {
+      /* No arrangement was found; there is nothing to check later.
+       * Drop the stale result of the same inputs. */
+      if (NULL != pentry) {
+        cm_result_destroy(pentry->result);
+        pentry->result = NULL;
+      }
+    } else {
+      if (NULL == pentry) {
+        pentry = &pcache->slots[pcache->next];
+        pcache->next = (pcache->next + 1) % CM_CACHE_SLOTS;
+      }
+      cm_cache_result_set(pentry, param, key, result);
+    }
+  }
+
   cm_state_free(state);
 }
 
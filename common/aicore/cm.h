@@ -76,8 +76,10 @@ void cm_query_result(struct city *pcity,
 		     struct cm_result *result);
 
 /*
- * Call this function if the city has changed. To be safe call it
- * everytime before you call cm_query_result.
+ * Forget the results stored for the city. cm_query_result() checks
+ * that the inputs of a stored result are unchanged before reusing it,
+ * so this is only needed if the city arrangement was rejected (e.g.
+ * by the server) or when the city is destroyed.
  */
 void cm_clear_cache(struct city *pcity);
 
@@ -20,6 +20,7 @@
 #include "log.h"
 #include "mem.h"
 #include "support.h"
+#include "timing.h"
 
 /* common */
 #include "game.h"
@@ -2814,6 +2815,7 @@ static struct pf_map *pf_fuel_map_new(const struct pf_parameter *parameter)
 ****************************************************************************/
 struct pf_map *pf_map_new(const struct pf_parameter *parameter)
 {
+  PERF_COUNT(PERF_PF_MAPS, 1);
   if (parameter->is_pos_dangerous) {
     if (parameter->get_moves_left_req) {
       log_error("path finding code cannot deal with dangers "
@@ -65,6 +65,9 @@ static int city_map_xy[CITY_MAP_MAX_SIZE][CITY_MAP_MAX_SIZE];
 /* number of tiles of a city; depends on the squared city radius */
 static int city_map_numtiles[CITY_MAP_MAX_RADIUS_SQ + 1];
 
+static struct fc_mem_pool city_pool =
+  FC_MEM_POOL_INIT("city", sizeof(struct city));
+
 /* definitions and functions for the tile_cache */
 struct tile_cache {
   int output[O_LAST];
@@ -3108,8 +3111,8 @@ struct city *create_city_virtual(struct player *pplayer,
   int i;
 
   /* Make sure that contents of city structure are correctly initialized,
-   * if you ever allocate it by some other mean than fc_calloc() */
-  struct city *pcity = fc_calloc(1, sizeof(*pcity));
+   * if you ever allocate it by some other mean than a zeroing allocator */
+  struct city *pcity = fc_mem_pool_alloc(&city_pool);
 
   fc_assert_ret_val(NULL != name, NULL);        /* No unnamed cities! */
   sz_strlcpy(pcity->name, name);
@@ -3119,7 +3122,7 @@ struct city *create_city_virtual(struct player *pplayer,
   pcity->owner = pplayer;
   pcity->original = pplayer;
 
-  /* City structure was allocated with fc_calloc(), so contents are initially
+  /* City structure was allocated zeroed, so contents are initially
    * zero. There is no need to initialize it a second time. */
 
   /* Now set some usefull default values. */
@@ -3179,6 +3182,7 @@ void destroy_city_virtual(struct city *pcity)
   CALL_FUNC_EACH_AI(city_free, pcity);
 
   citizens_free(pcity);
+  cm_clear_cache(pcity);
 
   unit_list_destroy(pcity->units_supported);
   if (pcity->tile_cache != NULL) {
@@ -3199,7 +3203,7 @@ void destroy_city_virtual(struct city *pcity)
   }
 
   memset(pcity, 0, sizeof(*pcity)); /* ensure no pointers remain */
-  free(pcity);
+  fc_mem_pool_free(&city_pool, pcity);
 }
 
 /**************************************************************************
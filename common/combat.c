@@ -19,8 +19,10 @@
 
 /* utility */
 #include "bitvector.h"
+#include "fcthread.h"
 #include "rand.h"
 #include "log.h"
+#include "mem.h"
 
 /* common */
 #include "base.h"
@@ -225,23 +227,64 @@ bool can_unit_attack_tile(const struct unit *punit,
           && unit_attack_units_at_tile_result(punit, dest_tile) == ATT_OK);
 }
 
+/* Memo of win_chance() results. The odds only depend on the strengths
+ * and on the number of rounds each unit can lose, so units with different
+ * hit points or firepower often share an entry. The AI asks for the same
+ * matchups many times while it evaluates its targets. Each thread has a
+ * memo of its own, so no entry is ever seen half written; without
+ * pthreads there is no memo. */
+#define WIN_CHANCE_CACHE_SIZE 1024
+
+struct win_chance_entry {
+  int as, ds;
+  int att_N_lose, def_N_lose;   /* 0 for unused entries */
+  double chance;
+};
+
+#ifdef HAVE_PTHREAD
+static pthread_once_t win_chance_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t win_chance_key;
+
 /***********************************************************************
-Returns the chance of the attacker winning, a number between 0 and 1.
-If you want the chance that the defender wins just use 1-chance(...)
+  Create the key used to find the win_chance() memo of the running
+  thread. The memo is freed when its thread ends.
+***********************************************************************/
+static void win_chance_key_init(void)
+{
+  pthread_key_create(&win_chance_key, free);
+}
+#endif /* HAVE_PTHREAD */
 
-NOTE: this number can be _very_ small, fx in a battle between an
-ironclad and a battleship the ironclad has less than 1/100000 chance of
-winning.
+/***********************************************************************
+  Return the win_chance() memo of the running thread, creating it if
+  needed, or NULL if there is none.
+***********************************************************************/
+static struct win_chance_entry *win_chance_cache_get(void)
+{
+#ifdef HAVE_PTHREAD
+  struct win_chance_entry *cache;
+
+  pthread_once(&win_chance_key_once, win_chance_key_init);
+  cache = pthread_getspecific(win_chance_key);
+  if (NULL == cache) {
+    cache = fc_calloc(WIN_CHANCE_CACHE_SIZE, sizeof(*cache));
+    pthread_setspecific(win_chance_key, cache);
+  }
 
-The algoritm calculates the probability of each possible number of HP's
-the attacker has left. Maybe that info should be preserved for use in
-the AI.
+  return cache;
+#else  /* HAVE_PTHREAD */
+  return NULL;
+#endif /* HAVE_PTHREAD */
+}
+
+/***********************************************************************
+  Returns the chance of the attacker winning a fight in which it can
+  lose att_N_lose rounds and the defender def_N_lose rounds. See
+  win_chance().
 ***********************************************************************/
-double win_chance(int as, int ahp, int afp, int ds, int dhp, int dfp)
+static double win_chance_calc(int as, int ds, int att_N_lose,
+                              int def_N_lose)
 {
-  /* number of rounds a unit can fight without dying */
-  int att_N_lose = (ahp + dfp - 1) / dfp;
-  int def_N_lose = (dhp + afp - 1) / afp;
   /* Probability of losing one round */
   double att_P_lose1 = (as + ds == 0) ? 0.5 : (double) ds / (as + ds);
   double def_P_lose1 = 1 - att_P_lose1;
@@ -311,6 +354,54 @@ double win_chance(int as, int ahp, int afp, int ds, int dhp, int dfp)
   return accum_prob;
 }
 
+/***********************************************************************
+Returns the chance of the attacker winning, a number between 0 and 1.
+If you want the chance that the defender wins just use 1-chance(...)
+
+NOTE: this number can be _very_ small, fx in a battle between an
+ironclad and a battleship the ironclad has less than 1/100000 chance of
+winning.
+
+The algoritm calculates the probability of each possible number of HP's
+the attacker has left. Maybe that info should be preserved for use in
+the AI.
+
+Results are remembered in a memo of the running thread, as the same
+matchups are evaluated over and over by the AI.
+***********************************************************************/
+double win_chance(int as, int ahp, int afp, int ds, int dhp, int dfp)
+{
+  /* number of rounds a unit can fight without dying */
+  int att_N_lose = (ahp + dfp - 1) / dfp;
+  int def_N_lose = (dhp + afp - 1) / afp;
+  struct win_chance_entry *cache, *pentry;
+  unsigned int idx;
+
+  if (att_N_lose <= 0 || def_N_lose <= 0
+      || NULL == (cache = win_chance_cache_get())) {
+    /* Not a real fight (don't let it look like an unused entry), or no
+     * memo. */
+    return win_chance_calc(as, ds, att_N_lose, def_N_lose);
+  }
+
+  idx = ((unsigned int) as * 0x9e3779b1u) ^ ((unsigned int) ds * 0x85ebca6bu)
+        ^ ((unsigned int) att_N_lose << 8) ^ (unsigned int) def_N_lose;
+  idx = (idx ^ (idx >> 16)) & (WIN_CHANCE_CACHE_SIZE - 1);
+  pentry = &cache[idx];
+
+  if (pentry->as != as || pentry->ds != ds
+      || pentry->att_N_lose != att_N_lose
+      || pentry->def_N_lose != def_N_lose) {
+    pentry->as = as;
+    pentry->ds = ds;
+    pentry->att_N_lose = att_N_lose;
+    pentry->def_N_lose = def_N_lose;
+    pentry->chance = win_chance_calc(as, ds, att_N_lose, def_N_lose);
+  }
+
+  return pentry->chance;
+}
+
 /**************************************************************************
 A unit's effective firepower depend on the situation.
 **************************************************************************/
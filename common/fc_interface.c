@@ -16,7 +16,9 @@
 #endif
 
 /* utility */
+#include "mem.h"
 #include "shared.h"
+#include "timing.h"
 
 /* common */
 #include "player.h"
@@ -61,6 +63,8 @@ void fc_interface_init(void)
 
   fc_funcs_defined = TRUE;
 
+  fc_mem_pools_init();
+  perf_counters_init();
   setup_real_activities_array();
 }
 
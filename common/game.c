@@ -195,7 +195,7 @@ void game_remove_unit(struct unit *punit)
               punit->homecity);
   }
 
-  unit_list_remove(unit_tile(punit)->units, punit);
+  tile_remove_unit(unit_tile(punit), punit);
   unit_list_remove(unit_owner(punit)->units, punit);
 
   idex_unregister_unit(punit);
@@ -401,6 +401,7 @@ static void game_defaults(void)
     game.server.save_options.save_starts = TRUE;
     game.server.savepalace        = GAME_DEFAULT_SAVEPALACE;
     game.server.scorelog          = GAME_DEFAULT_SCORELOG;
+    game.server.perflog           = GAME_DEFAULT_PERFLOG;
     game.server.scoreturn         = GAME_DEFAULT_SCORETURN - 1;
     game.server.seed              = GAME_DEFAULT_SEED;
     sz_strlcpy(game.server.start_units, GAME_DEFAULT_START_UNITS);
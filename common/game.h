@@ -192,6 +192,8 @@ struct civ_game {
       char save_name[MAX_LEN_NAME];
       bool scorelog;
       char scorefile[MAX_LEN_NAME];
+      bool perflog;
+      char perffile[MAX_LEN_NAME];
       int scoreturn;    /* next make_history_report() */
       int seed;
 
@@ -459,6 +461,9 @@ extern struct civ_game game;
 #define GAME_DEFAULT_SCORELOG        FALSE
 #define GAME_DEFAULT_SCOREFILE       "freeciv-score.log"
 
+#define GAME_DEFAULT_PERFLOG         FALSE
+#define GAME_DEFAULT_PERFFILE        "freeciv-perf.csv"
+
 /* Turns between reports is random between SCORETURN and (2 x SCORETURN).
  * First report is shown at SCORETURN. As report is generated in the end of the turn,
  * first report is already generated at (SCORETURN - 1) */
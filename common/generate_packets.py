@@ -605,6 +605,7 @@ class Variant:
         self.want_post_recv=packet.want_post_recv
         self.want_pre_send=packet.want_pre_send
         self.want_post_send=packet.want_post_send
+        self.want_share=packet.want_share
         self.type=packet.type
         self.delta=packet.delta
         self.is_info=packet.is_info
@@ -817,7 +818,7 @@ static char *stats_%(name)s_names[] = {%(names)s};
   int different = %(diff)s;
 '''
             else:
-                body="\n"
+                body="\n"+self.get_share_lookup("NULL", "0", "0", "")
                 for field in self.fields:
                     body=body+field.get_put()+"\n"
                 body=body+"\n"
@@ -860,7 +861,19 @@ static char *stats_%(name)s_names[] = {%(names)s};
   }
 
 '''
-        body=""
+        # Cancel some is-info packets.
+        cancel=""
+        for i in self.cancel:
+            cancel=cancel+'''
+  hash = pc->phs.sent + %s;
+  if (NULL != *hash) {
+    genhash_remove(*hash, real_packet);
+  }
+'''%i
+
+        body=self.get_share_lookup("old", "sizeof(*old)", "different",
+                                   "    *old = *real_packet;\n"
+                                   +cancel.replace("\n  ", "\n    "))
         for i in range(len(self.other_fields)):
             field=self.other_fields[i]
             body=body+field.get_cmp_wrapper(i)
@@ -872,6 +885,8 @@ static char *stats_%(name)s_names[] = {%(names)s};
             s='    stats_%(name)s_discarded++;\n'
         else:
             s=""
+        if self.want_share:
+            s=s+'    packet_broadcast_store(pc, %(type)s, NULL, 0);\n'%self.__dict__
 
         if self.is_info != "no":
             body=body+'''
@@ -893,18 +908,25 @@ static char *stats_%(name)s_names[] = {%(names)s};
             body=body+field.get_put_wrapper(self,i)
         body=body+'''
   *old = *real_packet;
-'''
+'''+cancel
 
-        # Cancel some is-info packets.
-        for i in self.cancel:
-            body=body+'''
-  hash = pc->phs.sent + %s;
-  if (NULL != *hash) {
-    genhash_remove(*hash, real_packet);
+        return intro+body
+
+    # Helper for get_send(). Returns the code which reuses the bytes
+    # already encoded for another connection of the same lsend call.
+    def get_share_lookup(self, old, old_size, different, update):
+        if not self.want_share:
+            return ""
+        return '''  if (packet_broadcast_lookup(pc, %(type)s, %(no)s,
+                              real_packet, sizeof(*real_packet),
+                              %(old)s, %(old_size)s, %(different)s)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+%(update)s    return packet_broadcast_send(pc, %(type)s);
   }
-'''%i
 
-        return intro+body
+'''%self.get_dict(vars())
 
     # Returns a code fragment which is the implementation of the receive
     # function. This is one of the two real functions. So it is rather
@@ -1122,6 +1144,12 @@ class Packet:
         if len(self.fields)>5 or self.name.split("_")[1]=="ruleset":
             self.handle_via_packet=1
 
+        # lsend may encode once and share the bytes between connections
+        # only if the encoding doesn't depend on per-connection hooks.
+        self.want_share=(self.want_lsend and not self.no_packet
+                         and not self.want_pre_send
+                         and not self.want_post_send)
+
         self.extra_send_args=""
         self.extra_send_args2=""
         self.extra_send_args3=", ".join(
@@ -1351,14 +1379,20 @@ class Packet:
     # lsend function.
     def get_lsend(self):
         if not self.want_lsend: return ""
+        if self.want_share:
+            begin="  packet_broadcast_begin(dest);\n"
+            end="  packet_broadcast_end();\n"
+        else:
+            begin=""
+            end=""
         return '''%(lsend_prototype)s
 {
-  conn_list_iterate(dest, pconn) {
+%(begin)s  conn_list_iterate(dest, pconn) {
     send_%(name)s(pconn%(extra_send_args2)s);
   } conn_list_iterate_end;
-}
+%(end)s}
 
-'''%self.__dict__
+'''%self.get_dict(vars())
 
     # Returns a code fragment which is the implementation of the
     # dsend function.
@@ -204,8 +204,10 @@ void map_init(void)
   map.num_continents = 0;
   map.num_oceans = 0;
   map.tiles = NULL;
+  map.tiles_cold = NULL;
   map.startpos_table = NULL;
   map.iterate_outwards_indices = NULL;
+  map.adjc_indices = NULL;
 
   /* The [xy]size values are set in map_init_topology.  It is initialized
    * to a non-zero value because some places erronously use these values
@@ -332,6 +334,33 @@ static void generate_map_indices(void)
   map.num_iterate_outwards_indices = tiles;
 }
 
+/**************************************************************************
+  Fill the adjc_indices array with the neighbours of every tile, so that
+  the adjc_*iterate() macros and mapstep() don't have to wrap and check
+  the positions themselves. This depends on the topology.
+***************************************************************************/
+static void generate_map_adjc_indices(void)
+{
+  int tile_x, tile_y, i;
+  enum direction8 dir;
+
+  fc_assert(NULL == map.adjc_indices);
+  map.adjc_indices = fc_malloc(8 * MAP_INDEX_SIZE
+                               * sizeof(*map.adjc_indices));
+
+  for (i = 0; i < MAP_INDEX_SIZE; i++) {
+    int *adjc = MAP_ADJC_INDICES(i);
+
+    index_to_map_pos(&tile_x, &tile_y, i);
+    for (dir = 0; dir < 8; dir++) {
+      struct tile *ptile = map_pos_to_tile(tile_x + DIR_DX[dir],
+                                           tile_y + DIR_DY[dir]);
+
+      adjc[dir] = (NULL != ptile ? tile_index(ptile) : -1);
+    }
+  }
+}
+
 /****************************************************************************
   map_init_topology needs to be called after map.topology_id is changed.
 
@@ -396,11 +425,10 @@ static void tile_init(struct tile *ptile)
   BV_CLR_ALL(ptile->roads);
   ptile->resource = NULL;
   ptile->terrain  = T_UNKNOWN;
-  ptile->units    = unit_list_new();
+  ptile->units    = tile_units_empty();
   ptile->owner    = NULL; /* Not claimed by any player. */
   ptile->claimer  = NULL;
   ptile->worked   = NULL; /* No city working here. */
-  ptile->spec_sprite = NULL;
 }
 
 /****************************************************************************
@@ -409,19 +437,15 @@ static void tile_init(struct tile *ptile)
 ****************************************************************************/
 struct tile *mapstep(const struct tile *ptile, enum direction8 dir)
 {
-  int dx, dy, tile_x, tile_y;
+  int adjc;
 
   if (!is_valid_dir(dir)) {
     return NULL;
   }
 
-  index_to_map_pos(&tile_x, &tile_y, tile_index(ptile)); 
-  DIRSTEP(dx, dy, dir);
-
-  tile_x += dx;
-  tile_y += dy;
+  adjc = MAP_ADJC_INDICES(tile_index(ptile))[dir];
 
-  return map_pos_to_tile(tile_x, tile_y);
+  return (0 <= adjc ? map.tiles + adjc : NULL);
 }
 
 /****************************************************************************
@@ -500,17 +524,10 @@ struct tile *index_to_tile(int index)
 ***************************************************************/
 static void tile_free(struct tile *ptile)
 {
-  unit_list_destroy(ptile->units);
-
-  if (ptile->spec_sprite) {
-    free(ptile->spec_sprite);
-    ptile->spec_sprite = NULL;
-  }
+  tile_units_clear(ptile);
 
-  if (ptile->label) {
-    FC_FREE(ptile->label);
-    ptile->label = NULL;
-  }
+  tile_set_spec_sprite(ptile, NULL);
+  tile_set_label(ptile, NULL);
 }
 
 /**************************************************************************
@@ -536,6 +553,7 @@ void map_allocate(void)
 
   generate_city_map_indices();
   generate_map_indices();
+  generate_map_adjc_indices();
 
   if (map.startpos_table != NULL) {
     startpos_hash_destroy(map.startpos_table);
@@ -557,6 +575,8 @@ void map_free(void)
 
     free(map.tiles);
     map.tiles = NULL;
+    FC_FREE(map.tiles_cold);
+    tile_units_pool_free();
 
     if (map.startpos_table) {
       startpos_hash_destroy(map.startpos_table);
@@ -564,6 +584,7 @@ void map_free(void)
     }
 
     FC_FREE(map.iterate_outwards_indices);
+    FC_FREE(map.adjc_indices);
     free_city_map_index();
   }
 }
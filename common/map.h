@@ -79,10 +79,12 @@ struct civ_map {
   int num_valid_dirs, num_cardinal_dirs;
   struct iter_index *iterate_outwards_indices;
   int num_iterate_outwards_indices;
+  int *adjc_indices; /* 8 neighbour indices per tile, -1 if not real */
   int xsize, ysize; /* native dimensions */
   int num_continents;
   int num_oceans;               /* not updated at the client */
   struct tile *tiles;
+  struct tile_cold *tiles_cold; /* parallel to tiles, or NULL; tile.h */
   struct startpos_hash *startpos_table;
 
   union {
@@ -217,6 +219,11 @@ struct iterator *map_startpos_iter_init(struct map_startpos_iter *iter);
 /* Number of index coordinates (for sanity checks and allocations) */
 #define MAP_INDEX_SIZE (map.xsize * map.ysize)
 
+/* The indices of the tiles adjacent to the tile with index 'idx', by
+ * direction8; -1 where the position is not real. Built by
+ * map_allocate(). */
+#define MAP_ADJC_INDICES(idx) (map.adjc_indices + 8 * (idx))
+
 #ifdef DEBUG
 #define CHECK_MAP_POS(x,y) \
   fc_assert(is_normal_map_pos((x),(y)))
@@ -563,22 +570,18 @@ extern struct terrain_misc terrain_control;
 			     dirlist, dircount)				    \
 {									    \
   enum direction8 _dir;							    \
-  int _tile##_x, _tile##_y, _tile##_cx, _tile##_cy;                         \
   struct tile *_tile;							    \
   const struct tile *_tile##_center = (center_tile);			    \
+  const int *_tile##_adjc = MAP_ADJC_INDICES(tile_index(_tile##_center));   \
   int _tile##_index = 0;						    \
-  index_to_map_pos(&_tile##_cx, &_tile##_cy, tile_index(_tile##_center));   \
   for (;								    \
        _tile##_index < (dircount);					    \
        _tile##_index++) {						    \
     _dir = dirlist[_tile##_index];					    \
-    DIRSTEP(_tile##_x, _tile##_y, _dir);				    \
-    _tile##_x += _tile##_cx;                                                \
-    _tile##_y += _tile##_cy;                                                \
-    _tile = map_pos_to_tile(_tile##_x, _tile##_y);                          \
-    if (NULL == _tile) {                                                    \
+    if (0 > _tile##_adjc[_dir]) {                                           \
       continue;                                                             \
-    }
+    }                                                                       \
+    _tile = map.tiles + _tile##_adjc[_dir];
 
 #define adjc_dirlist_iterate_end					    \
     }									    \
@@ -588,19 +591,14 @@ extern struct terrain_misc terrain_control;
 #define adjc_dirlist_base_iterate(center_tile, _dir, dirlist, dircount)        \
 {                                                                              \
   enum direction8 _dir;                                                        \
-  int _tile##_x, _tile##_y, _center##_x, _center##_y;                          \
   const struct tile *_tile##_center = (center_tile);                           \
-  bool _tile##_is_border = is_border_tile(_tile##_center, 1);                  \
+  const int *_tile##_adjc = MAP_ADJC_INDICES(tile_index(_tile##_center));      \
   int _tile##_index = 0;                                                       \
-  index_to_map_pos(&_center##_x, &_center##_y, tile_index(_tile##_center));    \
   for (;                                                                       \
        _tile##_index < (dircount);                                             \
        _tile##_index++) {                                                      \
     _dir = dirlist[_tile##_index];                                             \
-    DIRSTEP(_tile##_x, _tile##_y, _dir);                                       \
-    _tile##_x += _center##_x;                                                  \
-    _tile##_y += _center##_y;                                                  \
-    if (_tile##_is_border && !normalize_map_pos(&_tile##_x, &_tile##_y)) {     \
+    if (0 > _tile##_adjc[_dir]) {                                              \
       continue;                                                                \
     }
 
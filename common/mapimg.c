@@ -25,6 +25,7 @@
 #include "astring.h"
 #include "bitvector.h"
 #include "fcintl.h"
+#include "fcthread.h"
 #include "log.h"
 #include "mem.h"
 #include "shared.h"
@@ -264,6 +265,8 @@ BV_DEFINE(bv_mapdef_arg, MAPDEF_COUNT);
 #define SPECENUM_VALUE0NAME "ppm"
 #define SPECENUM_VALUE1     IMGTOOL_MAGICKWAND
 #define SPECENUM_VALUE1NAME "magick"
+#define SPECENUM_VALUE2     IMGTOOL_STREAM
+#define SPECENUM_VALUE2NAME "stream"
 #include "specenum_gen.h"
 
 /* player definitions */
@@ -313,6 +316,8 @@ static bool mapimg_checkplayers(struct mapdef *pmapdef, bool recheck);
 static char *mapimg_generate_name(struct mapdef *pmapdef);
 
 /* == map definition == */
+struct img_frame;
+
 struct mapdef {
   char maparg[MAX_LEN_MAPARG];
   char error[MAX_LEN_MAPDEF];
@@ -335,6 +340,10 @@ struct mapdef {
 
   bv_mapdef_arg args;
   bool colortest;
+
+  /* The last image drawn; [0] if one image is created per turn, else
+   * [player_index() + 1] for each player (see img_frame_draw()). */
+  struct img_frame *frames[MAX_NUM_PLAYER_SLOTS + 1];
 };
 
 static struct mapdef *mapdef_new(bool colortest);
@@ -383,6 +392,47 @@ struct img {
     int y;
   } imgsize; /* image size */
   const struct rgbcolor **map;
+
+  struct img_frame *frame; /* the frame the image is kept in or NULL */
+};
+
+/* What one tile was drawn from: the knowledge and the terrain index, and
+ * the player indices of the owners of the tile, city and unit, or -1. */
+struct img_tile_state {
+  short known;
+  short terrain;
+  short owner;
+  short city;
+  short unit;
+};
+
+/* The image last drawn for a map definition (and player), kept to draw
+ * only the tiles which changed for the next one. */
+struct img_frame {
+  struct img *pimg;
+  struct img_tile_state *tiles; /* indexed by tile_index() */
+
+  /* Everything is drawn again if one of these changes. */
+  int topo;
+  bv_player plrbv;
+  bool borders;
+  bool fogofwar;
+  const struct rgbcolor *colors[MAX_NUM_PLAYER_SLOTS + MAX_NUM_TERRAINS];
+
+  FILE *stream; /* open file of the 'stream' toolkit or NULL */
+};
+
+/* Below this many tiles, the image is drawn by the calling thread only. */
+#define MAPIMG_THREAD_MIN_TILES (64 * 64)
+/* Maximal number of worker threads drawing one image. */
+#define MAPIMG_MAX_THREADS 4
+
+/* One horizontal band of native rows [y0, y1) of an image. */
+struct img_band {
+  struct img *pimg;
+  struct player *pplayer; /* the only plotted player or NULL */
+  const bool *dirty;      /* the tiles to draw again or NULL for all */
+  int y0, y1;
 };
 
 static struct img *img_new(struct mapdef *mapdef, int topo, int xsize, int ysize);
@@ -399,13 +449,18 @@ static void img_plot_tile(struct img *pimg, const struct tile *ptile,
 static bool img_save(const struct img *pimg, const char *mapimgfile,
                      const char *path);
 static bool img_save_ppm(const struct img *pimg, const char *mapimgfile);
+static bool img_save_stream(const struct img *pimg, const char *mapimgfile);
 #ifdef HAVE_MAPIMG_MAGICKWAND
 static bool img_save_magickwand(const struct img *pimg,
                                 const char *mapimgfile);
 #endif /* HAVE_MAPIMG_MAGICKWAND */
 static bool img_filename(const char *mapimgfile, enum imageformat format,
                          char *filename, size_t filename_len);
-static void img_createmap(struct img *pimg);
+static void img_createmap(struct img *pimg, const bool *dirty);
+static struct player *img_plotted_player(const struct mapdef *pmapdef);
+static struct img *img_frame_draw(struct img_frame **pframe,
+                                  struct mapdef *pmapdef);
+static void img_frame_destroy(struct img_frame **pframe);
 
 /* == image toolkits == */
 typedef bool (*img_save_func)(const struct img *pimg,
@@ -432,6 +487,9 @@ static struct toolkit img_toolkits[] = {
               img_save_magickwand,
               N_("ImageMagick"))
 #endif /* HAVE_MAPIMG_MAGICKWAND */
+  GEN_TOOLKIT(IMGTOOL_STREAM, IMGFORMAT_PPM, IMGFORMAT_PPM,
+              img_save_stream,
+              N_("Binary ppm images of all turns in one file"))
 };
 
 static const int img_toolkits_count = ARRAY_SIZE(img_toolkits);
@@ -1198,6 +1256,7 @@ bool mapimg_delete(int id)
   /* delete map definition */
   pmapdef = mapdef_list_get(mapimg.mapdef, id);
   mapdef_list_remove(mapimg.mapdef, pmapdef);
+  mapdef_destroy(pmapdef);
 
   return TRUE;
 }
@@ -1364,12 +1423,10 @@ bool mapimg_create(struct mapdef *pmapdef, bool force, const char *savename,
     generate_save_name(savename, mapimgfile, sizeof(mapimgfile),
                        mapimg_generate_name(pmapdef));
 
-    pimg = img_new(pmapdef, CURRENT_TOPOLOGY, map.xsize, map.ysize);
-    img_createmap(pimg);
+    pimg = img_frame_draw(&pmapdef->frames[0], pmapdef);
     if (!img_save(pimg, mapimgfile, path)) {
       ret = FALSE;
     }
-    img_destroy(pimg);
     break;
   case SHOW_EACH:    /* one map for each player */
   case SHOW_HUMAN:   /* one map for each human player */
@@ -1378,6 +1435,7 @@ bool mapimg_create(struct mapdef *pmapdef, bool force, const char *savename,
                                  && pplayer->ai_controlled)) {
         /* no map image for dead players
          * or AI players if only human players should be shown */
+        img_frame_destroy(&pmapdef->frames[player_index(pplayer) + 1]);
         continue;
       }
 
@@ -1387,12 +1445,11 @@ bool mapimg_create(struct mapdef *pmapdef, bool force, const char *savename,
       generate_save_name(savename, mapimgfile, sizeof(mapimgfile),
                          mapimg_generate_name(pmapdef));
 
-      pimg = img_new(pmapdef, CURRENT_TOPOLOGY, map.xsize, map.ysize);
-      img_createmap(pimg);
+      pimg = img_frame_draw(&pmapdef->frames[player_index(pplayer) + 1],
+                            pmapdef);
       if (!img_save(pimg, mapimgfile, path)) {
         ret = FALSE;
       }
-      img_destroy(pimg);
 
       if (!ret) {
         break;
@@ -1803,6 +1860,7 @@ static struct mapdef *mapdef_new(bool colortest)
   BV_CLR_ALL(pmapdef->player.checked_plrbv);
   BV_CLR_ALL(pmapdef->args);
   pmapdef->colortest = colortest;
+  memset(pmapdef->frames, 0, sizeof(pmapdef->frames));
 
   return pmapdef;
 }
@@ -1812,10 +1870,16 @@ static struct mapdef *mapdef_new(bool colortest)
 ****************************************************************************/
 static void mapdef_destroy(struct mapdef *pmapdef)
 {
+  int i;
+
   if (pmapdef == NULL) {
     return;
   }
 
+  for (i = 0; i < ARRAY_SIZE(pmapdef->frames); i++) {
+    img_frame_destroy(&pmapdef->frames[i]);
+  }
+
   free(pmapdef);
 }
 
@@ -1931,6 +1995,8 @@ static struct img *img_new(struct mapdef *mapdef, int topo, int xsize, int ysize
   /* Initialise map. */
   memset(pimg->map, 0, pimg->imgsize.x * pimg->imgsize.y);
 
+  pimg->frame = NULL;
+
   return pimg;
 }
 
@@ -2274,12 +2340,31 @@ static bool img_save_magickwand(const struct img *pimg,
 #undef SET_COLOR
 #endif /* HAVE_MAPIMG_MAGICKWAND */
 
+/****************************************************************************
+  Write the decimal text of a color value (0 - 255) and the separator 'sep'
+  at 'pos'. Returns the position after the separator.
+****************************************************************************/
+static char *ppm_write_value(char *pos, int value, char sep)
+{
+  if (value >= 100) {
+    *pos++ = '0' + value / 100;
+  }
+  if (value >= 10) {
+    *pos++ = '0' + value / 10 % 10;
+  }
+  *pos++ = '0' + value % 10;
+  *pos++ = sep;
+
+  return pos;
+}
+
 /****************************************************************************
   Save an image as ppm file (toolkit: ppm).
 ****************************************************************************/
 static bool img_save_ppm(const struct img *pimg, const char *mapimgfile)
 {
   char ppmname[MAX_LEN_PATH];
+  char *row, *pos;
   FILE *fp;
   int x, y, xxx, yyy, index;
   const struct rgbcolor *pcolor;
@@ -2324,32 +2409,129 @@ static bool img_save_ppm(const struct img *pimg, const char *mapimgfile)
           pimg->imgsize.y * pimg->def->zoom);
   fprintf(fp, "255\n");
 
+  /* Each row of the image is formatted once and written 'zoom' times. The
+   * text of one pixel is at most "255 255 255\n". */
+  row = fc_malloc(pimg->imgsize.x * pimg->def->zoom * 12);
+
   /* y coordinate */
   for (y = 0; y < pimg->imgsize.y; y++) {
-    /* zoom for y */
-    for (yyy = 0; yyy < pimg->def->zoom; yyy++) {
-      /* x coordinate */
-      for (x = 0; x < pimg->imgsize.x; x++) {
-        index = img_index(x, y, pimg);
-        pcolor = pimg->map[index];
+    pos = row;
+
+    /* x coordinate */
+    for (x = 0; x < pimg->imgsize.x; x++) {
+      index = img_index(x, y, pimg);
+      pcolor = pimg->map[index];
+      if (pcolor == NULL) {
+        pcolor = imgcolor_special(IMGCOLOR_BACKGROUND);
+      }
 
-        /* zoom for x */
-        for (xxx = 0; xxx < pimg->def->zoom; xxx++) {
-          if (pcolor == NULL) {
-            pcolor = imgcolor_special(IMGCOLOR_BACKGROUND);
-          }
-          fprintf(fp, "%d %d %d\n", pcolor->r, pcolor->g, pcolor->b);
-        }
+      /* zoom for x */
+      for (xxx = 0; xxx < pimg->def->zoom; xxx++) {
+        pos = ppm_write_value(pos, pcolor->r, ' ');
+        pos = ppm_write_value(pos, pcolor->g, ' ');
+        pos = ppm_write_value(pos, pcolor->b, '\n');
       }
     }
+
+    /* zoom for y */
+    for (yyy = 0; yyy < pimg->def->zoom; yyy++) {
+      fwrite(row, 1, pos - row, fp);
+    }
   }
 
+  free(row);
+
   log_verbose("Map image saved as '%s'.", ppmname);
   fclose(fp);
 
   return TRUE;
 }
 
+/****************************************************************************
+  Append an image as binary ppm to the stream file of its frame (toolkit:
+  stream). The file is named after the first image and holds the images
+  of all turns one after another, as read by e.g. pnmsplit or
+  "ffmpeg -f image2pipe -c:v ppm". Without a frame, the stream file holds
+  just this image.
+****************************************************************************/
+static bool img_save_stream(const struct img *pimg, const char *mapimgfile)
+{
+  struct img_frame *frame = pimg->frame;
+  FILE *fp = (frame != NULL ? frame->stream : NULL);
+  unsigned char *row, *pos;
+  int x, y, xxx, yyy;
+  const struct rgbcolor *pcolor;
+  bool ret;
+
+  if (pimg->def->format != IMGFORMAT_PPM) {
+    MAPIMG_LOG(_("the stream toolkit can only create images in the ppm "
+                 "format"));
+    return FALSE;
+  }
+
+  if (fp == NULL) {
+    char streamname[MAX_LEN_PATH];
+
+    fc_snprintf(streamname, sizeof(streamname), "%s.map.stream.%s",
+                mapimgfile, imageformat_name(IMGFORMAT_PPM));
+    fp = fopen(streamname, "wb");
+    if (!fp) {
+      MAPIMG_LOG(_("could not open file: %s"), streamname);
+      return FALSE;
+    }
+    log_verbose("Map images are streamed to '%s'.", streamname);
+    if (frame != NULL) {
+      frame->stream = fp;
+    }
+  }
+
+  fprintf(fp, "P6\n");
+  fprintf(fp, "# %s\n", pimg->title);
+  fprintf(fp, "%d %d\n", pimg->imgsize.x * pimg->def->zoom,
+          pimg->imgsize.y * pimg->def->zoom);
+  fprintf(fp, "255\n");
+
+  row = fc_malloc(pimg->imgsize.x * pimg->def->zoom * 3);
+
+  for (y = 0; y < pimg->imgsize.y; y++) {
+    pos = row;
+
+    for (x = 0; x < pimg->imgsize.x; x++) {
+      pcolor = pimg->map[img_index(x, y, pimg)];
+      if (pcolor == NULL) {
+        pcolor = imgcolor_special(IMGCOLOR_BACKGROUND);
+      }
+
+      for (xxx = 0; xxx < pimg->def->zoom; xxx++) {
+        *pos++ = pcolor->r;
+        *pos++ = pcolor->g;
+        *pos++ = pcolor->b;
+      }
+    }
+
+    for (yyy = 0; yyy < pimg->def->zoom; yyy++) {
+      fwrite(row, 1, pos - row, fp);
+    }
+  }
+
+  free(row);
+
+  /* Keep the file complete after each turn. */
+  ret = (0 == fflush(fp) && !ferror(fp));
+  if (!ret) {
+    MAPIMG_LOG(_("error writing the stream file"));
+  }
+
+  if (frame == NULL) {
+    fclose(fp);
+  } else if (!ret) {
+    fclose(fp);
+    frame->stream = NULL;
+  }
+
+  return ret;
+}
+
 /****************************************************************************
   Generate the final filename.
 ****************************************************************************/
@@ -2381,32 +2563,38 @@ static const char *img_playerstr(const struct player *pplayer)
 }
 
 /****************************************************************************
-  Create the map considering the options (terrain, player(s), cities,
-  units, borders, known, fogofwar, ...).
+  Draw the tiles of the native rows [y0, y1) of one band of the image.
 ****************************************************************************/
-static void img_createmap(struct img *pimg)
+static void img_createmap_band(void *arg)
 {
+  const struct img_band *band = arg;
+  struct img *pimg = band->pimg;
   const struct rgbcolor *pcolor;
   bv_pixel pixel;
-  int player_id;
-  struct player *pplayer = NULL;
+  int player_id, tile_id;
+  struct player *pplayer = band->pplayer;
   struct player *plr_tile = NULL, *plr_city = NULL, *plr_unit = NULL;
   enum known_type tile_knowledge = TILE_UNKNOWN;
   struct terrain *pterrain = NULL;
   bool plr_knowledge = pimg->def->layers[MAPIMG_LAYER_KNOWLEDGE];
 
-  whole_map_iterate(ptile) {
-    if (bvplayers_count(pimg->def) == 1) {
-      /* only one player; get player id for 'known' and 'fogofwar' */
-      players_iterate(aplayer) {
-        if (BV_ISSET(pimg->def->player.checked_plrbv,
-                     player_index(aplayer))) {
-          pplayer = aplayer;
-          tile_knowledge = mapimg.mapimg_tile_known(ptile, pplayer,
-                                                    plr_knowledge);
-          break;
-        }
-      } players_iterate_end;
+  for (tile_id = band->y0 * map.xsize; tile_id < band->y1 * map.xsize;
+       tile_id++) {
+    struct tile *ptile = index_to_tile(tile_id);
+
+    if (band->dirty != NULL) {
+      if (!band->dirty[tile_id]) {
+        continue;
+      }
+
+      /* Clear what was drawn before. */
+      BV_SET_ALL(pixel);
+      img_plot_tile(pimg, ptile, NULL, pixel);
+    }
+
+    if (pplayer != NULL) {
+      tile_knowledge = mapimg.mapimg_tile_known(ptile, pplayer,
+                                                plr_knowledge);
     }
 
     /* known tiles */
@@ -2486,7 +2674,229 @@ static void img_createmap(struct img *pimg)
       pcolor = NULL;
       img_plot_tile(pimg, ptile, pcolor, pixel);
     }
+  }
+}
+
+/****************************************************************************
+  Create the map considering the options (terrain, player(s), cities,
+  units, borders, known, fogofwar, ...). If 'dirty' is not NULL, only the
+  tiles set in it are drawn again.
+
+  The tiles of different native rows never share a pixel, so on big maps
+  the rows are split into bands drawn by worker threads. The game state is
+  only read while the image is created.
+****************************************************************************/
+static void img_createmap(struct img *pimg, const bool *dirty)
+{
+  struct img_band bands[MAPIMG_MAX_THREADS];
+  fc_thread threads[MAPIMG_MAX_THREADS];
+  bool started[MAPIMG_MAX_THREADS];
+  struct player *pplayer = img_plotted_player(pimg->def);
+  int nbands = 1, i;
+
+  if (MAP_INDEX_SIZE >= MAPIMG_THREAD_MIN_TILES) {
+    nbands = MIN(MAPIMG_MAX_THREADS, map.ysize);
+  }
+
+  for (i = 0; i < nbands; i++) {
+    bands[i].pimg = pimg;
+    bands[i].pplayer = pplayer;
+    bands[i].dirty = dirty;
+    bands[i].y0 = map.ysize * i / nbands;
+    bands[i].y1 = map.ysize * (i + 1) / nbands;
+  }
+
+  /* The calling thread draws the first band itself. */
+  for (i = 1; i < nbands; i++) {
+    started[i] = (0 == fc_thread_start(&threads[i], img_createmap_band,
+                                       &bands[i]));
+    if (!started[i]) {
+      /* Could not start a thread, draw that band here. */
+      img_createmap_band(&bands[i]);
+    }
+  }
+  img_createmap_band(&bands[0]);
+  for (i = 1; i < nbands; i++) {
+    if (started[i]) {
+      fc_thread_wait(&threads[i]);
+    }
+  }
+}
+
+/****************************************************************************
+  Return the player if only one is plotted (used for 'known' and
+  'fogofwar'), else NULL.
+****************************************************************************/
+static struct player *img_plotted_player(const struct mapdef *pmapdef)
+{
+  if (bvplayers_count(pmapdef) == 1) {
+    players_iterate(aplayer) {
+      if (BV_ISSET(pmapdef->player.checked_plrbv, player_index(aplayer))) {
+        return aplayer;
+      }
+    } players_iterate_end;
+  }
+
+  return NULL;
+}
+
+/****************************************************************************
+  Fill 'colors' with the player and terrain colors the images point to.
+****************************************************************************/
+static void img_frame_colors(const struct rgbcolor **colors)
+{
+  int i;
+
+  for (i = 0; i < MAX_NUM_PLAYER_SLOTS; i++) {
+    struct player *pplayer = player_by_number(i);
+
+    colors[i] = (pplayer != NULL ? pplayer->rgb : NULL);
+  }
+  for (i = 0; i < MAX_NUM_TERRAINS; i++) {
+    struct terrain *pterrain = terrain_by_number(i);
+
+    colors[MAX_NUM_PLAYER_SLOTS + i] = (pterrain != NULL ? pterrain->rgb
+                                                         : NULL);
+  }
+}
+
+/****************************************************************************
+  Get what the tile would be drawn from.
+****************************************************************************/
+static void img_tile_state_get(struct img_tile_state *state,
+                               const struct tile *ptile,
+                               const struct player *pplayer, bool knowledge)
+{
+  struct terrain *pterrain;
+  struct player *plr;
+
+  state->known = mapimg.mapimg_tile_known(ptile, pplayer, knowledge);
+  pterrain = mapimg.mapimg_tile_terrain(ptile, pplayer, knowledge);
+  state->terrain = (pterrain != NULL ? terrain_index(pterrain) : -1);
+  plr = mapimg.mapimg_tile_owner(ptile, pplayer, knowledge);
+  state->owner = (plr != NULL ? player_index(plr) : -1);
+  plr = mapimg.mapimg_tile_city(ptile, pplayer, knowledge);
+  state->city = (plr != NULL ? player_index(plr) : -1);
+  plr = mapimg.mapimg_tile_unit(ptile, pplayer, knowledge);
+  state->unit = (plr != NULL ? player_index(plr) : -1);
+}
+
+/****************************************************************************
+  Draw the current map into the image kept in '*pframe' (created if
+  needed) and return the image.
+
+  Only the tiles whose state changed since the last image are drawn again,
+  together with their adjacent tiles as the borders depend on the owners
+  of the neighbours. Everything is drawn if the map, the plotted players,
+  the colors or the border and fog of war settings changed.
+****************************************************************************/
+static struct img *img_frame_draw(struct img_frame **pframe,
+                                  struct mapdef *pmapdef)
+{
+  struct img_frame *frame = *pframe;
+  const struct rgbcolor *colors[ARRAY_SIZE(frame->colors)];
+  struct player *pplayer = img_plotted_player(pmapdef);
+  bool knowledge = pmapdef->layers[MAPIMG_LAYER_KNOWLEDGE];
+  struct img_tile_state *tiles;
+  bool *dirty = NULL;
+  int ndirty = MAP_INDEX_SIZE;
+
+  if (frame == NULL) {
+    frame = fc_calloc(1, sizeof(*frame));
+    *pframe = frame;
+  }
+
+  if (frame->pimg != NULL
+      && (frame->topo != CURRENT_TOPOLOGY
+          || frame->pimg->mapsize.x != map.xsize
+          || frame->pimg->mapsize.y != map.ysize)) {
+    /* A new map; start a new stream, too. */
+    if (frame->stream != NULL) {
+      fclose(frame->stream);
+      frame->stream = NULL;
+    }
+    img_destroy(frame->pimg);
+    frame->pimg = NULL;
+  }
+
+  tiles = fc_malloc(MAP_INDEX_SIZE * sizeof(*tiles));
+  whole_map_iterate(ptile) {
+    img_tile_state_get(&tiles[tile_index(ptile)], ptile, pplayer,
+                       knowledge);
   } whole_map_iterate_end;
+
+  img_frame_colors(colors);
+
+  if (frame->pimg == NULL) {
+    frame->pimg = img_new(pmapdef, CURRENT_TOPOLOGY, map.xsize, map.ysize);
+    frame->pimg->frame = frame;
+  } else if (!BV_ARE_EQUAL(frame->plrbv, pmapdef->player.checked_plrbv)
+             || frame->borders != (game.info.borders > 0)
+             || frame->fogofwar != game.info.fogofwar
+             || 0 != memcmp(frame->colors, colors, sizeof(colors))) {
+    memset(frame->pimg->map, 0, frame->pimg->imgsize.x
+                                * frame->pimg->imgsize.y
+                                * sizeof(*frame->pimg->map));
+  } else {
+    dirty = fc_calloc(MAP_INDEX_SIZE, sizeof(*dirty));
+    ndirty = 0;
+    whole_map_iterate(ptile) {
+      int index = tile_index(ptile);
+
+      if (0 != memcmp(&tiles[index], &frame->tiles[index],
+                      sizeof(*tiles))) {
+        if (!dirty[index]) {
+          dirty[index] = TRUE;
+          ndirty++;
+        }
+        adjc_iterate(ptile, adjc_tile) {
+          if (!dirty[tile_index(adjc_tile)]) {
+            dirty[tile_index(adjc_tile)] = TRUE;
+            ndirty++;
+          }
+        } adjc_iterate_end;
+      }
+    } whole_map_iterate_end;
+  }
+
+  frame->pimg->turn = game.info.turn;
+  fc_snprintf(frame->pimg->title, sizeof(frame->pimg->title),
+              _("Turn: %4d - Year: %10s"), game.info.turn,
+              textyear(game.info.year));
+
+  img_createmap(frame->pimg, dirty);
+  log_debug("Map image: %d of %d tiles drawn.", ndirty, MAP_INDEX_SIZE);
+
+  free(frame->tiles);
+  frame->tiles = tiles;
+  frame->topo = CURRENT_TOPOLOGY;
+  frame->plrbv = pmapdef->player.checked_plrbv;
+  frame->borders = (game.info.borders > 0);
+  frame->fogofwar = game.info.fogofwar;
+  memcpy(frame->colors, colors, sizeof(colors));
+  free(dirty);
+
+  return frame->pimg;
+}
+
+/****************************************************************************
+  Destroy a kept image and close its stream file.
+****************************************************************************/
+static void img_frame_destroy(struct img_frame **pframe)
+{
+  struct img_frame *frame = *pframe;
+
+  if (frame == NULL) {
+    return;
+  }
+
+  if (frame->stream != NULL) {
+    fclose(frame->stream);
+  }
+  img_destroy(frame->pimg);
+  free(frame->tiles);
+  free(frame);
+  *pframe = NULL;
 }
 
 /*
@@ -40,6 +40,7 @@
 #include "log.h"
 #include "mem.h"
 #include "support.h"
+#include "timing.h"
 
 /* commmon */
 #include "dataio.h"
@@ -77,10 +78,26 @@
 #define PACKET_SIZE_STATISTICS 0
 
 #ifdef USE_COMPRESSION
-static int stat_size_alone = 0;
-static int stat_size_uncompressed = 0;
-static int stat_size_compressed = 0;
-static int stat_size_no_compression = 0;
+static struct packet_compression_stats compression_stats;
+
+/* Number of recently compressed queues kept to be reused. Observers and
+ * players with the same view get the same data queued. */
+#define COMPRESSION_CACHE_SIZE 4
+
+static struct {
+  z_stream stream;              /* Deflate state, reset for each queue. */
+  int level;                    /* Level 'stream' was set up with. */
+  bool initialized;
+  Bytef *buffer;                /* Output buffer, grown on demand. */
+  uLong buffer_size;
+  struct timer *timer;
+  struct {
+    struct byte_vector input;
+    struct byte_vector output;
+    int level;
+  } cache[COMPRESSION_CACHE_SIZE];
+  int cache_next;
+} compressor;
 
 /****************************************************************************
   Returns the compression level. Initilialize it if needed.
@@ -100,23 +117,94 @@ static inline int get_compression_level(void)
   return level;
 }
 
+/****************************************************************************
+  Compress 'size' bytes of 'data' the same way compress2() does. The deflate
+  state and the output buffer are kept between calls. Returns NULL on
+  error.
+****************************************************************************/
+static const Bytef *compress_data(const Bytef *data, uLong size, int level,
+                                  uLong *compressed_size)
+{
+  int i;
+
+  /* Identical data was compressed recently. */
+  for (i = 0; i < COMPRESSION_CACHE_SIZE; i++) {
+    if (compressor.cache[i].level == level
+        && byte_vector_size(&compressor.cache[i].input) == size
+        && 0 < size
+        && 0 == memcmp(compressor.cache[i].input.p, data, size)) {
+      compression_stats.cache_hits++;
+      *compressed_size = byte_vector_size(&compressor.cache[i].output);
+      return compressor.cache[i].output.p;
+    }
+  }
+
+  if (compressor.initialized && compressor.level != level) {
+    deflateEnd(&compressor.stream);
+    compressor.initialized = FALSE;
+  }
+  if (!compressor.initialized) {
+    memset(&compressor.stream, 0, sizeof(compressor.stream));
+    if (Z_OK != deflateInit(&compressor.stream, level)) {
+      return NULL;
+    }
+    compressor.level = level;
+    compressor.initialized = TRUE;
+  } else if (Z_OK != deflateReset(&compressor.stream)) {
+    return NULL;
+  }
+
+  *compressed_size = deflateBound(&compressor.stream, size);
+  if (compressor.buffer_size < *compressed_size) {
+    compressor.buffer = fc_realloc(compressor.buffer, *compressed_size);
+    compressor.buffer_size = *compressed_size;
+  }
+
+  compressor.stream.next_in = (Bytef *) data;
+  compressor.stream.avail_in = size;
+  compressor.stream.next_out = compressor.buffer;
+  compressor.stream.avail_out = compressor.buffer_size;
+  if (Z_STREAM_END != deflate(&compressor.stream, Z_FINISH)) {
+    return NULL;
+  }
+  *compressed_size = compressor.stream.total_out;
+
+  i = compressor.cache_next;
+  compressor.cache_next = (i + 1) % COMPRESSION_CACHE_SIZE;
+  compressor.cache[i].level = level;
+  byte_vector_reserve(&compressor.cache[i].input, size);
+  memcpy(compressor.cache[i].input.p, data, size);
+  byte_vector_reserve(&compressor.cache[i].output, *compressed_size);
+  memcpy(compressor.cache[i].output.p, compressor.buffer, *compressed_size);
+
+  return compressor.buffer;
+}
+
 /****************************************************************************
   Send all waiting data. Return TRUE on success.
 ****************************************************************************/
 static bool conn_compression_flush(struct connection *pconn)
 {
   int compression_level = get_compression_level();
-  uLongf compressed_size = 12 + 1.001 * pconn->compression.queue.size;
-  int error;
-  Bytef compressed[compressed_size];
+  uLong size = byte_vector_size(&pconn->compression.queue);
+  uLong compressed_size;
+  const Bytef *compressed;
   bool jumbo;
   unsigned long compressed_packet_len;
 
-  error = compress2(compressed, &compressed_size,
-                    pconn->compression.queue.p,
-                    pconn->compression.queue.size,
-                    compression_level);
-  fc_assert_ret_val(error == Z_OK, FALSE);
+  if (0 == size) {
+    return pconn->used;
+  }
+
+  if (NULL == compressor.timer) {
+    compressor.timer = timer_new(TIMER_USER, TIMER_ACTIVE);
+  }
+  timer_start(compressor.timer);
+  compressed = compress_data(pconn->compression.queue.p, size,
+                             compression_level, &compressed_size);
+  timer_stop(compressor.timer);
+  fc_assert_ret_val(NULL != compressed, FALSE);
+  compression_stats.flushes++;
 
   /* Compression signalling currently assumes a 2-byte packet length; if that
    * changes, the protocol should probably be changed */
@@ -126,21 +214,20 @@ static bool conn_compression_flush(struct connection *pconn)
   jumbo = (compressed_size+2 >= JUMBO_BORDER);
 
   compressed_packet_len = compressed_size + (jumbo ? 6 : 2);
-  if (compressed_packet_len < pconn->compression.queue.size) {
+  if (compressed_packet_len < size) {
     struct data_out dout;
 
-    log_compress("COMPRESS: compressed %lu bytes to %ld (level %d)",
-                 (unsigned long) pconn->compression.queue.size,
-                 compressed_size, compression_level);
-    stat_size_uncompressed += pconn->compression.queue.size;
-    stat_size_compressed += compressed_size;
+    log_compress("COMPRESS: compressed %lu bytes to %lu (level %d)",
+                 size, compressed_size, compression_level);
+    compression_stats.size_uncompressed += size;
+    compression_stats.size_compressed += compressed_size;
 
     if (!jumbo) {
       unsigned char header[2];
       FC_STATIC_ASSERT(COMPRESSION_BORDER > MAX_LEN_PACKET,
                        uncompressed_compressed_packet_len_overlap);
 
-      log_compress("COMPRESS: sending %ld as normal", compressed_size);
+      log_compress("COMPRESS: sending %lu as normal", compressed_size);
 
       dio_output_init(&dout, header, sizeof(header));
       dio_put_uint16(&dout, 2 + compressed_size + COMPRESSION_BORDER);
@@ -151,7 +238,7 @@ static bool conn_compression_flush(struct connection *pconn)
       FC_STATIC_ASSERT(JUMBO_SIZE >= JUMBO_BORDER+COMPRESSION_BORDER,
                        compressed_normal_jumbo_packet_len_overlap);
 
-      log_compress("COMPRESS: sending %ld as jumbo", compressed_size);
+      log_compress("COMPRESS: sending %lu as jumbo", compressed_size);
       dio_output_init(&dout, header, sizeof(header));
       dio_put_uint16(&dout, JUMBO_SIZE);
       dio_put_uint32(&dout, 6 + compressed_size);
@@ -159,18 +246,60 @@ static bool conn_compression_flush(struct connection *pconn)
       connection_send_data(pconn, compressed, compressed_size);
     }
   } else {
-    log_compress("COMPRESS: would enlarge %lu bytes to %ld; "
-                 "sending uncompressed",
-                 (unsigned long) pconn->compression.queue.size,
-                 compressed_packet_len);
-    connection_send_data(pconn, pconn->compression.queue.p,
-                         pconn->compression.queue.size);
-    stat_size_no_compression += pconn->compression.queue.size;
+    log_compress("COMPRESS: would enlarge %lu bytes to %lu; "
+                 "sending uncompressed", size, compressed_packet_len);
+    connection_send_data(pconn, pconn->compression.queue.p, size);
+    compression_stats.size_no_compression += size;
   }
   return pconn->used;
 }
+
 #endif /* USE_COMPRESSION */
 
+/****************************************************************************
+  Fill 'pstats' with the packet compression statistics collected so far.
+****************************************************************************/
+void packet_compression_stats_get(struct packet_compression_stats *pstats)
+{
+#ifdef USE_COMPRESSION
+  *pstats = compression_stats;
+  pstats->level = get_compression_level();
+  pstats->seconds = (NULL != compressor.timer
+                     ? timer_read_seconds(compressor.timer) : 0.0);
+#else  /* USE_COMPRESSION */
+  memset(pstats, 0, sizeof(*pstats));
+  pstats->level = 0;
+#endif /* USE_COMPRESSION */
+}
+
+/****************************************************************************
+  Free the resources used by the packet compression.
+****************************************************************************/
+void packet_compression_free(void)
+{
+#ifdef USE_COMPRESSION
+  int i;
+
+  if (compressor.initialized) {
+    deflateEnd(&compressor.stream);
+    compressor.initialized = FALSE;
+  }
+  if (NULL != compressor.buffer) {
+    free(compressor.buffer);
+    compressor.buffer = NULL;
+    compressor.buffer_size = 0;
+  }
+  if (NULL != compressor.timer) {
+    timer_destroy(compressor.timer);
+    compressor.timer = NULL;
+  }
+  for (i = 0; i < COMPRESSION_CACHE_SIZE; i++) {
+    byte_vector_free(&compressor.cache[i].input);
+    byte_vector_free(&compressor.cache[i].output);
+  }
+#endif /* USE_COMPRESSION */
+}
+
 /****************************************************************************
   Thaw the connection. Then maybe compress the data waiting to send them
   to the connection. Returns TRUE on success. See also
@@ -217,6 +346,9 @@ int send_packet_data(struct connection *pc, unsigned char *data, int len,
     pc->outgoing_packet_notify(pc, packet_type, len, result);
   }
 
+  PERF_COUNT(PERF_PACKETS, 1);
+  PERF_COUNT(PERF_PACKET_BYTES, len);
+  PROFILE_ZONE_START("send_packet");
 #ifdef USE_COMPRESSION
   if (TRUE) {
     int size = len;
@@ -240,6 +372,7 @@ int send_packet_data(struct connection *pc, unsigned char *data, int len,
                       byte_vector_size(&pc->compression.queue),
                       (long unsigned) MAX_LEN_COMPRESS_QUEUE);
         if (!conn_compression_flush(pc)) {
+          PROFILE_ZONE_STOP("send_packet");
           return -1;
         }
         byte_vector_reserve(&pc->compression.queue, 0);
@@ -251,20 +384,23 @@ int send_packet_data(struct connection *pc, unsigned char *data, int len,
       log_compress2("COMPRESS: putting %s into the queue",
                     packet_name(packet_type));
     } else {
-      stat_size_alone += size;
-      log_compress("COMPRESS: sending %s alone (%d bytes total)",
-                   packet_name(packet_type), stat_size_alone);
+      compression_stats.size_alone += size;
+      log_compress("COMPRESS: sending %s alone (%lu bytes total)",
+                   packet_name(packet_type), compression_stats.size_alone);
       connection_send_data(pc, data, len);
     }
 
-    log_compress2("COMPRESS: STATS: alone=%d compression-expand=%d "
-                  "compression (before/after) = %d/%d",
-                  stat_size_alone, stat_size_no_compression,
-                  stat_size_uncompressed, stat_size_compressed);
+    log_compress2("COMPRESS: STATS: alone=%lu compression-expand=%lu "
+                  "compression (before/after) = %lu/%lu",
+                  compression_stats.size_alone,
+                  compression_stats.size_no_compression,
+                  compression_stats.size_uncompressed,
+                  compression_stats.size_compressed);
   }
 #else  /* USE_COMPRESSION */
   connection_send_data(pc, data, len);
 #endif /* USE_COMPRESSION */
+  PROFILE_ZONE_STOP("send_packet");
 
 #if PACKET_SIZE_STATISTICS
   {
@@ -351,6 +487,222 @@ int send_packet_data(struct connection *pc, unsigned char *data, int len,
   return result;
 }
 
+/* Number of different encodings kept during a broadcast. Connections
+ * which share a view (observers, or players who see the same thing)
+ * usually all end up using the same one. */
+#define PACKET_BROADCAST_SLOTS 8
+
+struct packet_broadcast_slot {
+  bool valid;                   /* 'data' holds the result. */
+  enum packet_type type;
+  int variant;
+  struct packet_header header;
+  int different;
+  size_t packet_size;
+  void *packet;                 /* Packet as it was encoded. */
+  size_t old_size;
+  void *old;                    /* Delta state before the packet was sent. */
+  unsigned char *data;          /* NULL if the packet was discarded. */
+  int len;
+};
+
+static struct {
+  int depth;
+  bool active;                  /* Several receivers. */
+  int num_slots;
+  struct packet_broadcast_slot slots[PACKET_BROADCAST_SLOTS];
+  struct packet_broadcast_slot *pending;
+  const struct connection *pending_pc;
+  const struct packet_broadcast_slot *hit;
+  int encoded;
+  int shared;
+} broadcast;
+
+/**************************************************************************
+  Start sending packets to the connections of 'dest'. Until
+  packet_broadcast_end(), a connection which gets the same packet and has
+  the same delta state as one already served gets the bytes encoded for
+  that one instead of encoding the packet again. The packet may change
+  between the connections; only packets with the lsend flag are shared.
+  With a single connection nothing is recorded, as there is nobody to
+  share with.
+**************************************************************************/
+void packet_broadcast_begin(const struct conn_list *dest)
+{
+  if (0 < broadcast.depth++) {
+    /* Nested broadcast; only the outer one is shared. */
+    return;
+  }
+
+  broadcast.active = (1 < conn_list_size(dest));
+  broadcast.num_slots = 0;
+  broadcast.pending = NULL;
+  broadcast.pending_pc = NULL;
+  broadcast.hit = NULL;
+  broadcast.encoded = 0;
+  broadcast.shared = 0;
+}
+
+/**************************************************************************
+  Finish the broadcast started with packet_broadcast_begin().
+**************************************************************************/
+void packet_broadcast_end(void)
+{
+  int i;
+
+  fc_assert_ret(0 < broadcast.depth);
+  if (0 < --broadcast.depth) {
+    return;
+  }
+
+  if (0 < broadcast.shared) {
+    log_packet("broadcast: %d encoding(s) for %d packet(s)",
+               broadcast.encoded, broadcast.encoded + broadcast.shared);
+  }
+
+  for (i = 0; i < broadcast.num_slots; i++) {
+    struct packet_broadcast_slot *slot = broadcast.slots + i;
+
+    free(slot->packet);
+    slot->packet = NULL;
+    free(slot->old);
+    slot->old = NULL;
+    free(slot->data);
+    slot->data = NULL;
+  }
+  broadcast.num_slots = 0;
+  broadcast.pending = NULL;
+  broadcast.pending_pc = NULL;
+  broadcast.hit = NULL;
+}
+
+/**************************************************************************
+  Called by the generated send functions before encoding 'packet' for
+  'pc'. 'old' is the delta state of the connection for the packet (NULL
+  for packets without delta). Returns TRUE if the same packet has already
+  been encoded for a connection with the same state; then the caller only
+  has to update its delta state and call packet_broadcast_send().
+  Otherwise the caller encodes the packet as usual and the result gets
+  recorded by packet_broadcast_store().
+**************************************************************************/
+bool packet_broadcast_lookup(struct connection *pc, enum packet_type type,
+                             int variant,
+                             const void *packet, size_t packet_size,
+                             const void *old, size_t old_size,
+                             int different)
+{
+  struct packet_broadcast_slot *slot;
+  int i;
+
+  broadcast.hit = NULL;
+  if (1 != broadcast.depth || !broadcast.active) {
+    return FALSE;
+  }
+
+  for (i = 0; i < broadcast.num_slots; i++) {
+    slot = broadcast.slots + i;
+
+    if (slot->valid
+        && slot->type == type
+        && slot->variant == variant
+        && slot->header.length == pc->packet_header.length
+        && slot->header.type == pc->packet_header.type
+        && slot->different == different
+        && slot->packet_size == packet_size
+        && slot->old_size == old_size
+        && 0 == memcmp(slot->packet, packet, packet_size)
+        && (0 == old_size || 0 == memcmp(slot->old, old, old_size))) {
+      broadcast.hit = slot;
+      broadcast.shared++;
+      return TRUE;
+    }
+  }
+
+  /* Not found: record the input, the encoder will fill in the result. */
+  if (NULL != broadcast.pending) {
+    /* The previous encoding didn't complete; reuse its slot. */
+    slot = broadcast.pending;
+  } else if (PACKET_BROADCAST_SLOTS > broadcast.num_slots) {
+    slot = broadcast.slots + broadcast.num_slots++;
+    slot->packet = NULL;
+    slot->old = NULL;
+    slot->data = NULL;
+  } else {
+    return FALSE;
+  }
+
+  slot->valid = FALSE;
+  slot->type = type;
+  slot->variant = variant;
+  slot->header = pc->packet_header;
+  slot->different = different;
+  slot->packet_size = packet_size;
+  slot->packet = fc_realloc(slot->packet, packet_size);
+  memcpy(slot->packet, packet, packet_size);
+  slot->old_size = old_size;
+  if (0 < old_size) {
+    slot->old = fc_realloc(slot->old, old_size);
+    memcpy(slot->old, old, old_size);
+  }
+  broadcast.pending = slot;
+  broadcast.pending_pc = pc;
+
+  return FALSE;
+}
+
+/**************************************************************************
+  Returns TRUE if the packet found by the last successful
+  packet_broadcast_lookup() was discarded (no change for is-info packets).
+**************************************************************************/
+bool packet_broadcast_discarded(void)
+{
+  fc_assert_ret_val(NULL != broadcast.hit, FALSE);
+
+  return NULL == broadcast.hit->data;
+}
+
+/**************************************************************************
+  Send the bytes found by the last successful packet_broadcast_lookup() to
+  the connection.
+**************************************************************************/
+int packet_broadcast_send(struct connection *pc, enum packet_type type)
+{
+  fc_assert_ret_val(NULL != broadcast.hit, -1);
+  fc_assert_ret_val(NULL != broadcast.hit->data, -1);
+
+  return send_packet_data(pc, broadcast.hit->data, broadcast.hit->len,
+                          type);
+}
+
+/**************************************************************************
+  Record the result of encoding the packet for 'pc', to be reused by other
+  connections of the same broadcast. 'data' is NULL if the packet was
+  discarded.
+**************************************************************************/
+void packet_broadcast_store(struct connection *pc, enum packet_type type,
+                            const unsigned char *data, int len)
+{
+  struct packet_broadcast_slot *slot = broadcast.pending;
+
+  if (NULL == slot || pc != broadcast.pending_pc || type != slot->type) {
+    return;
+  }
+
+  if (NULL != data) {
+    slot->data = fc_realloc(slot->data, len);
+    memcpy(slot->data, data, len);
+    slot->len = len;
+  } else {
+    free(slot->data);
+    slot->data = NULL;
+    slot->len = 0;
+  }
+  slot->valid = TRUE;
+  broadcast.pending = NULL;
+  broadcast.pending_pc = NULL;
+  broadcast.encoded++;
+}
+
 /**************************************************************************
   Read and return a packet from the connection 'pc'. The type of the
   packet is written in 'ptype'. On error, the connection is closed and
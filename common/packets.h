@@ -125,6 +125,7 @@ void pre_send_packet_player_attribute_chunk(struct connection *pc,
     dio_output_rewind(&dout); \
     dio_put_type(&dout, pc->packet_header.length, size); \
     fc_assert(!dout.too_short); \
+    packet_broadcast_store(pc, packet_type, buffer, size); \
     return send_packet_data(pc, buffer, size, packet_type); \
   }
 
@@ -160,6 +161,34 @@ int send_packet_data(struct connection *pc, unsigned char *data, int len,
                      enum packet_type packet_type);
 bool packet_check(struct data_in *din, struct connection *pc);
 
+/* Totals of the data sent by send_packet_data(), in bytes. */
+struct packet_compression_stats {
+  unsigned long size_alone;             /* Sent while not frozen. */
+  unsigned long size_uncompressed;      /* Compressed, size before. */
+  unsigned long size_compressed;        /* Compressed, size after. */
+  unsigned long size_no_compression;    /* Compression wouldn't help. */
+  unsigned long flushes;                /* Number of compressed queues. */
+  unsigned long cache_hits;             /* Compressed output reused. */
+  int level;                            /* zlib level in use. */
+  double seconds;                       /* Time spent compressing. */
+};
+
+void packet_compression_stats_get(struct packet_compression_stats *pstats);
+void packet_compression_free(void);
+
+/* Encode once for many connections, see packet_broadcast_begin(). */
+void packet_broadcast_begin(const struct conn_list *dest);
+void packet_broadcast_end(void);
+bool packet_broadcast_lookup(struct connection *pc, enum packet_type type,
+                             int variant,
+                             const void *packet, size_t packet_size,
+                             const void *old, size_t old_size,
+                             int different);
+bool packet_broadcast_discarded(void);
+int packet_broadcast_send(struct connection *pc, enum packet_type type);
+void packet_broadcast_store(struct connection *pc, enum packet_type type,
+                            const unsigned char *data, int len);
+
 /* Utilities to exchange strings and string vectors. */
 #define PACKET_STRVEC_SEPARATOR '\3'
 #define PACKET_STRVEC_COMPUTE(str, strvec)                                  \
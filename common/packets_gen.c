@@ -2862,6 +2862,15 @@ static int send_packet_endgame_report_100(struct connection *pc, const struct pa
 
   log_packet_detailed("packet_endgame_report_100: sending info about ()");
 
+  if (packet_broadcast_lookup(pc, PACKET_ENDGAME_REPORT, 100,
+                              real_packet, sizeof(*real_packet),
+                              NULL, 0, 0)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    return packet_broadcast_send(pc, PACKET_ENDGAME_REPORT);
+  }
+
   dio_put_uint8(&dout, real_packet->category_num);
 
     {
@@ -2940,9 +2949,11 @@ int send_packet_endgame_report(struct connection *pc, const struct packet_endgam
 }
 void lsend_packet_endgame_report(struct conn_list *dest, const struct packet_endgame_report *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_endgame_report(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 static struct packet_endgame_player *receive_packet_endgame_player_100(struct connection *pc)
@@ -2982,6 +2993,15 @@ static int send_packet_endgame_player_100(struct connection *pc, const struct pa
 
   log_packet_detailed("packet_endgame_player_100: sending info about ()");
 
+  if (packet_broadcast_lookup(pc, PACKET_ENDGAME_PLAYER, 100,
+                              real_packet, sizeof(*real_packet),
+                              NULL, 0, 0)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    return packet_broadcast_send(pc, PACKET_ENDGAME_PLAYER);
+  }
+
   dio_put_uint8(&dout, real_packet->category_num);
   dio_put_sint8(&dout, real_packet->player_id);
   dio_put_uint16(&dout, real_packet->score);
@@ -3061,9 +3081,11 @@ int send_packet_endgame_player(struct connection *pc, const struct packet_endgam
 }
 void lsend_packet_endgame_player(struct conn_list *dest, const struct packet_endgame_player *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_endgame_player(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 static genhash_val_t hash_packet_tile_info_100(const void *vkey)
@@ -3245,6 +3267,16 @@ static int send_packet_tile_info_100(struct connection *pc, const struct packet_
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_TILE_INFO, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_TILE_INFO);
+  }
+
   differ = (old->continent != real_packet->continent);
   if (differ) {
     different++;
@@ -3326,6 +3358,7 @@ static int send_packet_tile_info_100(struct connection *pc, const struct packet_
 
   if (different == 0) {
     log_packet_detailed("  no change -> discard");
+    packet_broadcast_store(pc, PACKET_TILE_INFO, NULL, 0);
     return 0;
   }
 
@@ -3452,9 +3485,11 @@ int send_packet_tile_info(struct connection *pc, const struct packet_tile_info *
 }
 void lsend_packet_tile_info(struct conn_list *dest, const struct packet_tile_info *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_tile_info(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_game_info_100 hash_const
@@ -6684,6 +6719,16 @@ static int send_packet_map_info_100(struct connection *pc, const struct packet_m
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_MAP_INFO, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_MAP_INFO);
+  }
+
   differ = (old->xsize != real_packet->xsize);
   if (differ) {
     different++;
@@ -6786,9 +6831,11 @@ int send_packet_map_info(struct connection *pc, const struct packet_map_info *pa
 }
 void lsend_packet_map_info(struct conn_list *dest, const struct packet_map_info *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_map_info(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_nuke_tile_info_100 hash_const
@@ -6863,6 +6910,16 @@ static int send_packet_nuke_tile_info_100(struct connection *pc, const struct pa
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_NUKE_TILE_INFO, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_NUKE_TILE_INFO);
+  }
+
   differ = (old->tile != real_packet->tile);
   if (differ) {
     different++;
@@ -6945,9 +7002,11 @@ int send_packet_nuke_tile_info(struct connection *pc, const struct packet_nuke_t
 }
 void lsend_packet_nuke_tile_info(struct conn_list *dest, const struct packet_nuke_tile_info *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_nuke_tile_info(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 int dsend_packet_nuke_tile_info(struct connection *pc, int tile)
@@ -7060,6 +7119,16 @@ static int send_packet_team_name_info_100(struct connection *pc, const struct pa
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_TEAM_NAME_INFO, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_TEAM_NAME_INFO);
+  }
+
   differ = (strcmp(old->team_name, real_packet->team_name) != 0);
   if (differ) {
     different++;
@@ -7143,9 +7212,11 @@ int send_packet_team_name_info(struct connection *pc, const struct packet_team_n
 }
 void lsend_packet_team_name_info(struct conn_list *dest, const struct packet_team_name_info *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_team_name_info(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_chat_msg_100 hash_const
@@ -7243,6 +7314,16 @@ static int send_packet_chat_msg_100(struct connection *pc, const struct packet_c
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_CHAT_MSG, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_CHAT_MSG);
+  }
+
   differ = (strcmp(old->message, real_packet->message) != 0);
   if (differ) {
     different++;
@@ -7355,9 +7436,11 @@ int send_packet_chat_msg(struct connection *pc, const struct packet_chat_msg *pa
 }
 void lsend_packet_chat_msg(struct conn_list *dest, const struct packet_chat_msg *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_chat_msg(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_chat_msg_req_100 hash_const
@@ -7764,6 +7847,26 @@ static int send_packet_city_remove_100(struct connection *pc, const struct packe
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_CITY_REMOVE, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+
+    hash = pc->phs.sent + PACKET_CITY_INFO;
+    if (NULL != *hash) {
+      genhash_remove(*hash, real_packet);
+    }
+
+    hash = pc->phs.sent + PACKET_CITY_SHORT_INFO;
+    if (NULL != *hash) {
+      genhash_remove(*hash, real_packet);
+    }
+    return packet_broadcast_send(pc, PACKET_CITY_REMOVE);
+  }
+
   differ = (old->city_id != real_packet->city_id);
   if (differ) {
     different++;
@@ -7856,9 +7959,11 @@ int send_packet_city_remove(struct connection *pc, const struct packet_city_remo
 }
 void lsend_packet_city_remove(struct conn_list *dest, const struct packet_city_remove *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_city_remove(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 int dsend_packet_city_remove(struct connection *pc, int city_id)
@@ -8335,6 +8440,21 @@ static int send_packet_city_info_100(struct connection *pc, const struct packet_
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_CITY_INFO, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+
+    hash = pc->phs.sent + PACKET_CITY_SHORT_INFO;
+    if (NULL != *hash) {
+      genhash_remove(*hash, real_packet);
+    }
+    return packet_broadcast_send(pc, PACKET_CITY_INFO);
+  }
+
   differ = (old->tile != real_packet->tile);
   if (differ) {
     different++;
@@ -8804,6 +8924,7 @@ static int send_packet_city_info_100(struct connection *pc, const struct packet_
 
   if (different == 0) {
     log_packet_detailed("  no change -> discard");
+    packet_broadcast_store(pc, PACKET_CITY_INFO, NULL, 0);
     return 0;
   }
 
@@ -9158,9 +9279,11 @@ int send_packet_city_info(struct connection *pc, const struct packet_city_info *
 }
 void lsend_packet_city_info(struct conn_list *dest, const struct packet_city_info *packet, bool force_to_send)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_city_info(pconn, packet, force_to_send);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 static genhash_val_t hash_packet_city_short_info_100(const void *vkey)
@@ -9294,6 +9417,21 @@ static int send_packet_city_short_info_100(struct connection *pc, const struct p
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_CITY_SHORT_INFO, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+
+    hash = pc->phs.sent + PACKET_CITY_INFO;
+    if (NULL != *hash) {
+      genhash_remove(*hash, real_packet);
+    }
+    return packet_broadcast_send(pc, PACKET_CITY_SHORT_INFO);
+  }
+
   differ = (old->tile != real_packet->tile);
   if (differ) {
     different++;
@@ -9365,6 +9503,7 @@ static int send_packet_city_short_info_100(struct connection *pc, const struct p
 
   if (different == 0) {
     log_packet_detailed("  no change -> discard");
+    packet_broadcast_store(pc, PACKET_CITY_SHORT_INFO, NULL, 0);
     return 0;
   }
 
@@ -9473,9 +9612,11 @@ int send_packet_city_short_info(struct connection *pc, const struct packet_city_
 }
 void lsend_packet_city_short_info(struct conn_list *dest, const struct packet_city_short_info *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_city_short_info(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_city_sell_100 hash_const
@@ -11541,6 +11682,16 @@ static int send_packet_city_name_suggestion_info_100(struct connection *pc, cons
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_CITY_NAME_SUGGESTION_INFO, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_CITY_NAME_SUGGESTION_INFO);
+  }
+
   differ = (old->unit_id != real_packet->unit_id);
   if (differ) {
     different++;
@@ -11633,9 +11784,11 @@ int send_packet_city_name_suggestion_info(struct connection *pc, const struct pa
 }
 void lsend_packet_city_name_suggestion_info(struct conn_list *dest, const struct packet_city_name_suggestion_info *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_city_name_suggestion_info(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 int dsend_packet_city_name_suggestion_info(struct connection *pc, int unit_id, const char *name)
@@ -11742,6 +11895,16 @@ static int send_packet_city_sabotage_list_100(struct connection *pc, const struc
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_CITY_SABOTAGE_LIST, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_CITY_SABOTAGE_LIST);
+  }
+
   differ = (old->diplomat_id != real_packet->diplomat_id);
   if (differ) {
     different++;
@@ -11844,9 +12007,11 @@ int send_packet_city_sabotage_list(struct connection *pc, const struct packet_ci
 }
 void lsend_packet_city_sabotage_list(struct conn_list *dest, const struct packet_city_sabotage_list *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_city_sabotage_list(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_player_remove_100 hash_const
@@ -15280,6 +15445,26 @@ static int send_packet_unit_remove_100(struct connection *pc, const struct packe
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_UNIT_REMOVE, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+
+    hash = pc->phs.sent + PACKET_UNIT_INFO;
+    if (NULL != *hash) {
+      genhash_remove(*hash, real_packet);
+    }
+
+    hash = pc->phs.sent + PACKET_UNIT_SHORT_INFO;
+    if (NULL != *hash) {
+      genhash_remove(*hash, real_packet);
+    }
+    return packet_broadcast_send(pc, PACKET_UNIT_REMOVE);
+  }
+
   differ = (old->unit_id != real_packet->unit_id);
   if (differ) {
     different++;
@@ -15372,9 +15557,11 @@ int send_packet_unit_remove(struct connection *pc, const struct packet_unit_remo
 }
 void lsend_packet_unit_remove(struct conn_list *dest, const struct packet_unit_remove *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_unit_remove(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 int dsend_packet_unit_remove(struct connection *pc, int unit_id)
@@ -15812,6 +15999,21 @@ static int send_packet_unit_info_100(struct connection *pc, const struct packet_
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_UNIT_INFO, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+
+    hash = pc->phs.sent + PACKET_UNIT_SHORT_INFO;
+    if (NULL != *hash) {
+      genhash_remove(*hash, real_packet);
+    }
+    return packet_broadcast_send(pc, PACKET_UNIT_INFO);
+  }
+
   differ = (old->owner != real_packet->owner);
   if (differ) {
     different++;
@@ -16137,6 +16339,7 @@ static int send_packet_unit_info_100(struct connection *pc, const struct packet_
 
   if (different == 0) {
     log_packet_detailed("  no change -> discard");
+    packet_broadcast_store(pc, PACKET_UNIT_INFO, NULL, 0);
     return 0;
   }
 
@@ -16744,6 +16947,21 @@ static int send_packet_unit_info_101(struct connection *pc, const struct packet_
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_UNIT_INFO, 101,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+
+    hash = pc->phs.sent + PACKET_UNIT_SHORT_INFO;
+    if (NULL != *hash) {
+      genhash_remove(*hash, real_packet);
+    }
+    return packet_broadcast_send(pc, PACKET_UNIT_INFO);
+  }
+
   differ = (old->owner != real_packet->owner);
   if (differ) {
     different++;
@@ -17069,6 +17287,7 @@ static int send_packet_unit_info_101(struct connection *pc, const struct packet_
 
   if (different == 0) {
     log_packet_detailed("  no change -> discard");
+    packet_broadcast_store(pc, PACKET_UNIT_INFO, NULL, 0);
     return 0;
   }
 
@@ -17330,9 +17549,11 @@ int send_packet_unit_info(struct connection *pc, const struct packet_unit_info *
 }
 void lsend_packet_unit_info(struct conn_list *dest, const struct packet_unit_info *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_unit_info(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 static genhash_val_t hash_packet_unit_short_info_100(const void *vkey)
@@ -17527,6 +17748,21 @@ static int send_packet_unit_short_info_100(struct connection *pc, const struct p
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_UNIT_SHORT_INFO, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+
+    hash = pc->phs.sent + PACKET_UNIT_INFO;
+    if (NULL != *hash) {
+      genhash_remove(*hash, real_packet);
+    }
+    return packet_broadcast_send(pc, PACKET_UNIT_SHORT_INFO);
+  }
+
   differ = (old->owner != real_packet->owner);
   if (differ) {
     different++;
@@ -17632,6 +17868,7 @@ static int send_packet_unit_short_info_100(struct connection *pc, const struct p
 
   if (different == 0) {
     log_packet_detailed("  no change -> discard");
+    packet_broadcast_store(pc, PACKET_UNIT_SHORT_INFO, NULL, 0);
     return 0;
   }
 
@@ -17767,9 +18004,11 @@ int send_packet_unit_short_info(struct connection *pc, const struct packet_unit_
 }
 void lsend_packet_unit_short_info(struct conn_list *dest, const struct packet_unit_short_info *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_unit_short_info(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_unit_combat_info_100 hash_const
@@ -17863,6 +18102,16 @@ static int send_packet_unit_combat_info_100(struct connection *pc, const struct
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_UNIT_COMBAT_INFO, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_UNIT_COMBAT_INFO);
+  }
+
   differ = (old->attacker_unit_id != real_packet->attacker_unit_id);
   if (differ) {
     different++;
@@ -17984,9 +18233,11 @@ int send_packet_unit_combat_info(struct connection *pc, const struct packet_unit
 }
 void lsend_packet_unit_combat_info(struct conn_list *dest, const struct packet_unit_combat_info *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_unit_combat_info(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_unit_move_100 hash_const
@@ -21544,6 +21795,16 @@ static int send_packet_unit_diplomat_answer_100(struct connection *pc, const str
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_UNIT_DIPLOMAT_ANSWER, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_UNIT_DIPLOMAT_ANSWER);
+  }
+
   differ = (old->diplomat_id != real_packet->diplomat_id);
   if (differ) {
     different++;
@@ -21656,9 +21917,11 @@ int send_packet_unit_diplomat_answer(struct connection *pc, const struct packet_
 }
 void lsend_packet_unit_diplomat_answer(struct conn_list *dest, const struct packet_unit_diplomat_answer *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_unit_diplomat_answer(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 int dsend_packet_unit_diplomat_answer(struct connection *pc, int diplomat_id, int target_id, int cost, enum diplomat_actions action_type)
@@ -22539,6 +22802,16 @@ static int send_packet_diplomacy_init_meeting_100(struct connection *pc, const s
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_DIPLOMACY_INIT_MEETING, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_DIPLOMACY_INIT_MEETING);
+  }
+
   differ = (old->counterpart != real_packet->counterpart);
   if (differ) {
     different++;
@@ -22631,9 +22904,11 @@ int send_packet_diplomacy_init_meeting(struct connection *pc, const struct packe
 }
 void lsend_packet_diplomacy_init_meeting(struct conn_list *dest, const struct packet_diplomacy_init_meeting *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_diplomacy_init_meeting(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 int dsend_packet_diplomacy_init_meeting(struct connection *pc, int counterpart, int initiated_from)
@@ -22895,6 +23170,16 @@ static int send_packet_diplomacy_cancel_meeting_100(struct connection *pc, const
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_DIPLOMACY_CANCEL_MEETING, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_DIPLOMACY_CANCEL_MEETING);
+  }
+
   differ = (old->counterpart != real_packet->counterpart);
   if (differ) {
     different++;
@@ -22987,9 +23272,11 @@ int send_packet_diplomacy_cancel_meeting(struct connection *pc, const struct pac
 }
 void lsend_packet_diplomacy_cancel_meeting(struct conn_list *dest, const struct packet_diplomacy_cancel_meeting *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_diplomacy_cancel_meeting(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 int dsend_packet_diplomacy_cancel_meeting(struct connection *pc, int counterpart, int initiated_from)
@@ -23324,6 +23611,16 @@ static int send_packet_diplomacy_create_clause_100(struct connection *pc, const
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_DIPLOMACY_CREATE_CLAUSE, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_DIPLOMACY_CREATE_CLAUSE);
+  }
+
   differ = (old->counterpart != real_packet->counterpart);
   if (differ) {
     different++;
@@ -23436,9 +23733,11 @@ int send_packet_diplomacy_create_clause(struct connection *pc, const struct pack
 }
 void lsend_packet_diplomacy_create_clause(struct conn_list *dest, const struct packet_diplomacy_create_clause *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_diplomacy_create_clause(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 int dsend_packet_diplomacy_create_clause(struct connection *pc, int counterpart, int giver, enum clause_type type, int value)
@@ -23777,6 +24076,16 @@ static int send_packet_diplomacy_remove_clause_100(struct connection *pc, const
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_DIPLOMACY_REMOVE_CLAUSE, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_DIPLOMACY_REMOVE_CLAUSE);
+  }
+
   differ = (old->counterpart != real_packet->counterpart);
   if (differ) {
     different++;
@@ -23889,9 +24198,11 @@ int send_packet_diplomacy_remove_clause(struct connection *pc, const struct pack
 }
 void lsend_packet_diplomacy_remove_clause(struct conn_list *dest, const struct packet_diplomacy_remove_clause *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_diplomacy_remove_clause(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 int dsend_packet_diplomacy_remove_clause(struct connection *pc, int counterpart, int giver, enum clause_type type, int value)
@@ -24153,6 +24464,16 @@ static int send_packet_diplomacy_accept_treaty_100(struct connection *pc, const
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_DIPLOMACY_ACCEPT_TREATY, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_DIPLOMACY_ACCEPT_TREATY);
+  }
+
   differ = (old->counterpart != real_packet->counterpart);
   if (differ) {
     different++;
@@ -24253,9 +24574,11 @@ int send_packet_diplomacy_accept_treaty(struct connection *pc, const struct pack
 }
 void lsend_packet_diplomacy_accept_treaty(struct conn_list *dest, const struct packet_diplomacy_accept_treaty *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_diplomacy_accept_treaty(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 int dsend_packet_diplomacy_accept_treaty(struct connection *pc, int counterpart, bool I_accepted, bool other_accepted)
@@ -24558,6 +24881,16 @@ static int send_packet_page_msg_old_100(struct connection *pc, const struct pack
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_PAGE_MSG_OLD, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_PAGE_MSG_OLD);
+  }
+
   differ = (strcmp(old->caption, real_packet->caption) != 0);
   if (differ) {
     different++;
@@ -24670,9 +25003,11 @@ int send_packet_page_msg_old(struct connection *pc, const struct packet_page_msg
 }
 void lsend_packet_page_msg_old(struct conn_list *dest, const struct packet_page_msg_old *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_page_msg_old(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_page_msg_new_100 hash_const
@@ -24776,6 +25111,16 @@ static int send_packet_page_msg_new_100(struct connection *pc, const struct pack
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_PAGE_MSG_NEW, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_PAGE_MSG_NEW);
+  }
+
   differ = (strcmp(old->caption, real_packet->caption) != 0);
   if (differ) {
     different++;
@@ -24898,9 +25243,11 @@ int send_packet_page_msg_new(struct connection *pc, const struct packet_page_msg
 }
 void lsend_packet_page_msg_new(struct conn_list *dest, const struct packet_page_msg_new *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_page_msg_new(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_page_msg_part_100 hash_const
@@ -24975,6 +25322,16 @@ static int send_packet_page_msg_part_100(struct connection *pc, const struct pac
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_PAGE_MSG_PART, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_PAGE_MSG_PART);
+  }
+
   differ = (strcmp(old->lines, real_packet->lines) != 0);
   if (differ) {
     different++;
@@ -25057,9 +25414,11 @@ int send_packet_page_msg_part(struct connection *pc, const struct packet_page_ms
 }
 void lsend_packet_page_msg_part(struct conn_list *dest, const struct packet_page_msg_part *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_page_msg_part(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_report_req_100 hash_const
@@ -25352,6 +25711,16 @@ static int send_packet_conn_info_100(struct connection *pc, const struct packet_
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_CONN_INFO, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_CONN_INFO);
+  }
+
   differ = (old->used != real_packet->used);
   if(differ) {
     different++;
@@ -25409,6 +25778,7 @@ static int send_packet_conn_info_100(struct connection *pc, const struct packet_
 
   if (different == 0) {
     log_packet_detailed("  no change -> discard");
+    packet_broadcast_store(pc, PACKET_CONN_INFO, NULL, 0);
     return 0;
   }
 
@@ -25507,9 +25877,11 @@ int send_packet_conn_info(struct connection *pc, const struct packet_conn_info *
 }
 void lsend_packet_conn_info(struct conn_list *dest, const struct packet_conn_info *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_conn_info(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_conn_ping_info_100 hash_const
@@ -25616,6 +25988,16 @@ static int send_packet_conn_ping_info_100(struct connection *pc, const struct pa
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_CONN_PING_INFO, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_CONN_PING_INFO);
+  }
+
   differ = (old->connections != real_packet->connections);
   if (differ) {
     different++;
@@ -25756,9 +26138,11 @@ int send_packet_conn_ping_info(struct connection *pc, const struct packet_conn_p
 }
 void lsend_packet_conn_ping_info(struct conn_list *dest, const struct packet_conn_ping_info *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_conn_ping_info(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 static struct packet_conn_ping *receive_packet_conn_ping_100(struct connection *pc)
@@ -26247,6 +26631,16 @@ static int send_packet_start_phase_100(struct connection *pc, const struct packe
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_START_PHASE, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_START_PHASE);
+  }
+
   differ = (old->phase != real_packet->phase);
   if (differ) {
     different++;
@@ -26329,9 +26723,11 @@ int send_packet_start_phase(struct connection *pc, const struct packet_start_pha
 }
 void lsend_packet_start_phase(struct conn_list *dest, const struct packet_start_phase *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_start_phase(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 int dsend_packet_start_phase(struct connection *pc, int phase)
@@ -26430,6 +26826,16 @@ static int send_packet_new_year_100(struct connection *pc, const struct packet_n
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_NEW_YEAR, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_NEW_YEAR);
+  }
+
   differ = (old->year != real_packet->year);
   if (differ) {
     different++;
@@ -26522,9 +26928,11 @@ int send_packet_new_year(struct connection *pc, const struct packet_new_year *pa
 }
 void lsend_packet_new_year(struct conn_list *dest, const struct packet_new_year *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_new_year(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 static struct packet_begin_turn *receive_packet_begin_turn_100(struct connection *pc)
@@ -27316,6 +27724,16 @@ static int send_packet_spaceship_info_100(struct connection *pc, const struct pa
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_SPACESHIP_INFO, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_SPACESHIP_INFO);
+  }
+
   differ = (old->sship_state != real_packet->sship_state);
   if (differ) {
     different++;
@@ -27559,9 +27977,11 @@ int send_packet_spaceship_info(struct connection *pc, const struct packet_spaces
 }
 void lsend_packet_spaceship_info(struct conn_list *dest, const struct packet_spaceship_info *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_spaceship_info(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_unit_100 hash_const
@@ -27936,6 +28356,16 @@ static int send_packet_ruleset_unit_100(struct connection *pc, const struct pack
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_UNIT, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_UNIT);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -28832,6 +29262,16 @@ static int send_packet_ruleset_unit_101(struct connection *pc, const struct pack
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_UNIT, 101,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_UNIT);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -29427,9 +29867,11 @@ int send_packet_ruleset_unit(struct connection *pc, const struct packet_ruleset_
 }
 void lsend_packet_ruleset_unit(struct conn_list *dest, const struct packet_ruleset_unit *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_unit(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_unit_bonus_100 hash_const
@@ -29537,6 +29979,16 @@ static int send_packet_ruleset_unit_bonus_100(struct connection *pc, const struc
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_UNIT_BONUS, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_UNIT_BONUS);
+  }
+
   differ = (old->unit != real_packet->unit);
   if (differ) {
     different++;
@@ -29649,9 +30101,11 @@ int send_packet_ruleset_unit_bonus(struct connection *pc, const struct packet_ru
 }
 void lsend_packet_ruleset_unit_bonus(struct conn_list *dest, const struct packet_ruleset_unit_bonus *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_unit_bonus(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_unit_flag_100 hash_const
@@ -29738,6 +30192,16 @@ static int send_packet_ruleset_unit_flag_100(struct connection *pc, const struct
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_UNIT_FLAG, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_UNIT_FLAG);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -29840,9 +30304,11 @@ int send_packet_ruleset_unit_flag(struct connection *pc, const struct packet_rul
 }
 void lsend_packet_ruleset_unit_flag(struct conn_list *dest, const struct packet_ruleset_unit_flag *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_unit_flag(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_game_100 hash_const
@@ -30001,6 +30467,16 @@ static int send_packet_ruleset_game_100(struct connection *pc, const struct pack
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_GAME, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_GAME);
+  }
+
   differ = (old->default_specialist != real_packet->default_specialist);
   if (differ) {
     different++;
@@ -30346,6 +30822,16 @@ static int send_packet_ruleset_game_101(struct connection *pc, const struct pack
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_GAME, 101,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_GAME);
+  }
+
   differ = (old->default_specialist != real_packet->default_specialist);
   if (differ) {
     different++;
@@ -30606,9 +31092,11 @@ int send_packet_ruleset_game(struct connection *pc, const struct packet_ruleset_
 }
 void lsend_packet_ruleset_game(struct conn_list *dest, const struct packet_ruleset_game *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_game(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_specialist_100 hash_const
@@ -30740,6 +31228,16 @@ static int send_packet_ruleset_specialist_100(struct connection *pc, const struc
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_SPECIALIST, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_SPECIALIST);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -30911,9 +31409,11 @@ int send_packet_ruleset_specialist(struct connection *pc, const struct packet_ru
 }
 void lsend_packet_ruleset_specialist(struct conn_list *dest, const struct packet_ruleset_specialist *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_specialist(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_government_ruler_title_100 hash_const
@@ -31011,6 +31511,16 @@ static int send_packet_ruleset_government_ruler_title_100(struct connection *pc,
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_GOVERNMENT_RULER_TITLE, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_GOVERNMENT_RULER_TITLE);
+  }
+
   differ = (old->gov != real_packet->gov);
   if (differ) {
     different++;
@@ -31123,9 +31633,11 @@ int send_packet_ruleset_government_ruler_title(struct connection *pc, const stru
 }
 void lsend_packet_ruleset_government_ruler_title(struct conn_list *dest, const struct packet_ruleset_government_ruler_title *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_government_ruler_title(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_tech_100 hash_const
@@ -31267,6 +31779,16 @@ static int send_packet_ruleset_tech_100(struct connection *pc, const struct pack
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_TECH, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_TECH);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -31468,9 +31990,11 @@ int send_packet_ruleset_tech(struct connection *pc, const struct packet_ruleset_
 }
 void lsend_packet_ruleset_tech(struct conn_list *dest, const struct packet_ruleset_tech *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_tech(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_tech_flag_100 hash_const
@@ -31557,6 +32081,16 @@ static int send_packet_ruleset_tech_flag_100(struct connection *pc, const struct
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_TECH_FLAG, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_TECH_FLAG);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -31659,9 +32193,11 @@ int send_packet_ruleset_tech_flag(struct connection *pc, const struct packet_rul
 }
 void lsend_packet_ruleset_tech_flag(struct conn_list *dest, const struct packet_ruleset_tech_flag *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_tech_flag(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_government_100 hash_const
@@ -31788,6 +32324,16 @@ static int send_packet_ruleset_government_100(struct connection *pc, const struc
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_GOVERNMENT, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_GOVERNMENT);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -31959,9 +32505,11 @@ int send_packet_ruleset_government(struct connection *pc, const struct packet_ru
 }
 void lsend_packet_ruleset_government(struct conn_list *dest, const struct packet_ruleset_government *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_government(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_terrain_control_100 hash_const
@@ -32092,6 +32640,16 @@ static int send_packet_ruleset_terrain_control_100(struct connection *pc, const
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_TERRAIN_CONTROL, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_TERRAIN_CONTROL);
+  }
+
   differ = (old->ocean_reclaim_requirement_pct != real_packet->ocean_reclaim_requirement_pct);
   if (differ) {
     different++;
@@ -32282,9 +32840,11 @@ int send_packet_ruleset_terrain_control(struct connection *pc, const struct pack
 }
 void lsend_packet_ruleset_terrain_control(struct conn_list *dest, const struct packet_ruleset_terrain_control *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_terrain_control(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 static struct packet_rulesets_ready *receive_packet_rulesets_ready_100(struct connection *pc)
@@ -32492,6 +33052,16 @@ static int send_packet_ruleset_nation_sets_100(struct connection *pc, const stru
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_NATION_SETS, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_NATION_SETS);
+  }
+
   differ = (old->nsets != real_packet->nsets);
   if (differ) {
     different++;
@@ -32661,9 +33231,11 @@ int send_packet_ruleset_nation_sets(struct connection *pc, const struct packet_r
 }
 void lsend_packet_ruleset_nation_sets(struct conn_list *dest, const struct packet_ruleset_nation_sets *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_nation_sets(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_nation_groups_100 hash_const
@@ -32754,6 +33326,16 @@ static int send_packet_ruleset_nation_groups_100(struct connection *pc, const st
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_NATION_GROUPS, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_NATION_GROUPS);
+  }
+
   differ = (old->ngroups != real_packet->ngroups);
   if (differ) {
     different++;
@@ -32865,9 +33447,11 @@ int send_packet_ruleset_nation_groups(struct connection *pc, const struct packet
 }
 void lsend_packet_ruleset_nation_groups(struct conn_list *dest, const struct packet_ruleset_nation_groups *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_nation_groups(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 static genhash_val_t hash_packet_ruleset_nation_100(const void *vkey)
@@ -33122,6 +33706,16 @@ static int send_packet_ruleset_nation_100(struct connection *pc, const struct pa
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_NATION, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_NATION);
+  }
+
   differ = (strcmp(old->translation_domain, real_packet->translation_domain) != 0);
   if (differ) {
     different++;
@@ -33516,9 +34110,11 @@ int send_packet_ruleset_nation(struct connection *pc, const struct packet_rulese
 }
 void lsend_packet_ruleset_nation(struct conn_list *dest, const struct packet_ruleset_nation *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_nation(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_nation_availability_100 hash_const
@@ -33610,6 +34206,16 @@ static int send_packet_nation_availability_100(struct connection *pc, const stru
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_NATION_AVAILABILITY, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_NATION_AVAILABILITY);
+  }
+
   differ = (old->ncount != real_packet->ncount);
   if (differ) {
     different++;
@@ -33754,6 +34360,16 @@ static int send_packet_nation_availability_101(struct connection *pc, const stru
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_NATION_AVAILABILITY, 101,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_NATION_AVAILABILITY);
+  }
+
   differ = (old->ncount != real_packet->ncount);
   if (differ) {
     different++;
@@ -33872,9 +34488,11 @@ int send_packet_nation_availability(struct connection *pc, const struct packet_n
 }
 void lsend_packet_nation_availability(struct conn_list *dest, const struct packet_nation_availability *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_nation_availability(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_city_100 hash_const
@@ -34025,6 +34643,16 @@ static int send_packet_ruleset_city_100(struct connection *pc, const struct pack
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_CITY, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_CITY);
+  }
+
   differ = (old->style_id != real_packet->style_id);
   if (differ) {
     different++;
@@ -34236,9 +34864,11 @@ int send_packet_ruleset_city(struct connection *pc, const struct packet_ruleset_
 }
 void lsend_packet_ruleset_city(struct conn_list *dest, const struct packet_ruleset_city *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_city(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_building_100 hash_const
@@ -34434,6 +35064,16 @@ static int send_packet_ruleset_building_100(struct connection *pc, const struct
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_BUILDING, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_BUILDING);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -34695,9 +35335,11 @@ int send_packet_ruleset_building(struct connection *pc, const struct packet_rule
 }
 void lsend_packet_ruleset_building(struct conn_list *dest, const struct packet_ruleset_building *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_building(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_terrain_100 hash_const
@@ -34995,6 +35637,16 @@ static int send_packet_ruleset_terrain_100(struct connection *pc, const struct p
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_TERRAIN, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_TERRAIN);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -35424,9 +36076,11 @@ int send_packet_ruleset_terrain(struct connection *pc, const struct packet_rules
 }
 void lsend_packet_ruleset_terrain(struct conn_list *dest, const struct packet_ruleset_terrain *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_terrain(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_terrain_flag_100 hash_const
@@ -35513,6 +36167,16 @@ static int send_packet_ruleset_terrain_flag_100(struct connection *pc, const str
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_TERRAIN_FLAG, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_TERRAIN_FLAG);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -35615,9 +36279,11 @@ int send_packet_ruleset_terrain_flag(struct connection *pc, const struct packet_
 }
 void lsend_packet_ruleset_terrain_flag(struct conn_list *dest, const struct packet_ruleset_terrain_flag *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_terrain_flag(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_unit_class_100 hash_const
@@ -35740,6 +36406,16 @@ static int send_packet_ruleset_unit_class_100(struct connection *pc, const struc
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_UNIT_CLASS, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_UNIT_CLASS);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -35958,6 +36634,16 @@ static int send_packet_ruleset_unit_class_101(struct connection *pc, const struc
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_UNIT_CLASS, 101,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_UNIT_CLASS);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -36170,6 +36856,16 @@ static int send_packet_ruleset_unit_class_102(struct connection *pc, const struc
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_UNIT_CLASS, 102,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_UNIT_CLASS);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -36372,6 +37068,16 @@ static int send_packet_ruleset_unit_class_103(struct connection *pc, const struc
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_UNIT_CLASS, 103,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_UNIT_CLASS);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -36543,9 +37249,11 @@ int send_packet_ruleset_unit_class(struct connection *pc, const struct packet_ru
 }
 void lsend_packet_ruleset_unit_class(struct conn_list *dest, const struct packet_ruleset_unit_class *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_unit_class(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_base_100 hash_const
@@ -36745,6 +37453,16 @@ static int send_packet_ruleset_base_100(struct connection *pc, const struct pack
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_BASE, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_BASE);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -37044,9 +37762,11 @@ int send_packet_ruleset_base(struct connection *pc, const struct packet_ruleset_
 }
 void lsend_packet_ruleset_base(struct conn_list *dest, const struct packet_ruleset_base *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_base(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_road_100 hash_const
@@ -37284,6 +38004,16 @@ static int send_packet_ruleset_road_100(struct connection *pc, const struct pack
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_ROAD, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_ROAD);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -37831,6 +38561,16 @@ static int send_packet_ruleset_road_101(struct connection *pc, const struct pack
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_ROAD, 101,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_ROAD);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -38214,9 +38954,11 @@ int send_packet_ruleset_road(struct connection *pc, const struct packet_ruleset_
 }
 void lsend_packet_ruleset_road(struct conn_list *dest, const struct packet_ruleset_road *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_road(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_disaster_100 hash_const
@@ -38337,6 +39079,16 @@ static int send_packet_ruleset_disaster_100(struct connection *pc, const struct
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_DISASTER, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_DISASTER);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -38498,9 +39250,11 @@ int send_packet_ruleset_disaster(struct connection *pc, const struct packet_rule
 }
 void lsend_packet_ruleset_disaster(struct conn_list *dest, const struct packet_ruleset_disaster *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_disaster(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_trade_100 hash_const
@@ -38592,6 +39346,16 @@ static int send_packet_ruleset_trade_100(struct connection *pc, const struct pac
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_TRADE, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_TRADE);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -38694,9 +39458,11 @@ int send_packet_ruleset_trade(struct connection *pc, const struct packet_ruleset
 }
 void lsend_packet_ruleset_trade(struct conn_list *dest, const struct packet_ruleset_trade *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_trade(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_control_100 hash_const
@@ -38868,6 +39634,16 @@ static int send_packet_ruleset_control_100(struct connection *pc, const struct p
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_CONTROL, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_CONTROL);
+  }
+
   differ = (old->num_unit_classes != real_packet->num_unit_classes);
   if (differ) {
     different++;
@@ -39119,9 +39895,11 @@ int send_packet_ruleset_control(struct connection *pc, const struct packet_rules
 }
 void lsend_packet_ruleset_control(struct conn_list *dest, const struct packet_ruleset_control *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_control(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_single_want_hack_req_100 hash_const
@@ -39701,6 +40479,16 @@ static int send_packet_game_load_100(struct connection *pc, const struct packet_
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_GAME_LOAD, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_GAME_LOAD);
+  }
+
   differ = (old->load_successful != real_packet->load_successful);
   if(differ) {
     different++;
@@ -39792,9 +40580,11 @@ int send_packet_game_load(struct connection *pc, const struct packet_game_load *
 }
 void lsend_packet_game_load(struct conn_list *dest, const struct packet_game_load *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_game_load(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 int dsend_packet_game_load(struct connection *pc, bool load_successful, const char *load_filename)
@@ -41696,6 +42486,16 @@ static int send_packet_ruleset_effect_100(struct connection *pc, const struct pa
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_EFFECT, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_EFFECT);
+  }
+
   differ = (old->effect_type != real_packet->effect_type);
   if (differ) {
     different++;
@@ -41788,9 +42588,11 @@ int send_packet_ruleset_effect(struct connection *pc, const struct packet_rulese
 }
 void lsend_packet_ruleset_effect(struct conn_list *dest, const struct packet_ruleset_effect *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_effect(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_effect_req_100 hash_const
@@ -41896,6 +42698,16 @@ static int send_packet_ruleset_effect_req_100(struct connection *pc, const struc
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_EFFECT_REQ, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_EFFECT_REQ);
+  }
+
   differ = (old->effect_id != real_packet->effect_id);
   if (differ) {
     different++;
@@ -42035,9 +42847,11 @@ int send_packet_ruleset_effect_req(struct connection *pc, const struct packet_ru
 }
 void lsend_packet_ruleset_effect_req(struct conn_list *dest, const struct packet_ruleset_effect_req *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_effect_req(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_ruleset_resource_100 hash_const
@@ -42154,6 +42968,16 @@ static int send_packet_ruleset_resource_100(struct connection *pc, const struct
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_RULESET_RESOURCE, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_RULESET_RESOURCE);
+  }
+
   differ = (old->id != real_packet->id);
   if (differ) {
     different++;
@@ -42305,9 +43129,11 @@ int send_packet_ruleset_resource(struct connection *pc, const struct packet_rule
 }
 void lsend_packet_ruleset_resource(struct conn_list *dest, const struct packet_ruleset_resource *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_ruleset_resource(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_scenario_info_100 hash_const
@@ -48550,6 +49376,16 @@ static int send_packet_edit_player_100(struct connection *pc, const struct packe
     different = 1;      /* Force to send. */
   }
 
+  if (packet_broadcast_lookup(pc, PACKET_EDIT_PLAYER, 100,
+                              real_packet, sizeof(*real_packet),
+                              old, sizeof(*old), different)) {
+    if (packet_broadcast_discarded()) {
+      return 0;
+    }
+    *old = *real_packet;
+    return packet_broadcast_send(pc, PACKET_EDIT_PLAYER);
+  }
+
   differ = (strcmp(old->name, real_packet->name) != 0);
   if (differ) {
     different++;
@@ -48893,9 +49729,11 @@ int send_packet_edit_player(struct connection *pc, const struct packet_edit_play
 }
 void lsend_packet_edit_player(struct conn_list *dest, const struct packet_edit_player *packet)
 {
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     send_packet_edit_player(pconn, packet);
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 #define hash_packet_edit_player_vision_100 hash_const
@@ -33,6 +33,8 @@ struct section_file;
 struct luascript_func_hash;
 struct luascript_signal_hash;
 struct luascript_signal_name_list;
+struct signal_profile_list;
+struct genvec;
 struct connection;
 struct fc_lua;
 
@@ -52,6 +54,8 @@ struct fc_lua {
 
   struct luascript_signal_hash *signals;
   struct luascript_signal_name_list *signal_names;
+  struct genvec *signals_by_id;
+  struct signal_profile_list *signal_profiles;
 };
 
 /* Error functions for lua scripts. */
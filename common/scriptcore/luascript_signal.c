@@ -35,6 +35,14 @@
     return false
 
   If the value is 'true' the current signal emission will be stopped.
+
+  Each signal also gets an integer id at creation. Emitting by id avoids
+  the lookup of the name, and signals without callbacks can be skipped
+  before their arguments are even collected (see
+  luascript_signal_connected()).
+
+  The CPU time spent in each callback is accumulated, and can be reported
+  with luascript_signal_profile_report().
 *****************************************************************************/
 
 #ifdef HAVE_CONFIG_H
@@ -44,7 +52,9 @@
 #include <stdarg.h>
 
 /* utility */
+#include "genvec.h"
 #include "log.h"
+#include "timing.h"
 
 /* common/scriptcore */
 #include "luascript.h"
@@ -54,6 +64,7 @@
 
 struct signal;
 struct signal_callback;
+struct signal_profile;
 
 /* get 'struct signal_callback_list' and related functions: */
 #define SPECLIST_TAG signal_callback
@@ -65,13 +76,31 @@ struct signal_callback;
 #define signal_callback_list_iterate_end                                     \
   LIST_ITERATE_END
 
-static struct signal_callback *signal_callback_new(const char *name);
+/* get 'struct signal_profile_list' and related functions: */
+#define SPECLIST_TAG signal_profile
+#define SPECLIST_TYPE struct signal_profile
+#include "speclist.h"
+
+#define signal_profile_list_iterate(list, pprofile)                          \
+  TYPED_LIST_ITERATE(struct signal_profile, list, pprofile)
+#define signal_profile_list_iterate_end                                      \
+  LIST_ITERATE_END
+
+static struct signal_callback *signal_callback_new(const char *name,
+                                                   struct signal_profile *
+                                                   pprofile);
 static void signal_callback_destroy(struct signal_callback *pcallback);
-static struct signal *signal_new(int nargs, enum api_types *parg_types);
+static struct signal *signal_new(const char *name, int nargs,
+                                 enum api_types *parg_types);
 static void signal_destroy(struct signal *psignal);
+static struct signal_profile *signal_profile_get(struct fc_lua *fcl,
+                                                 const char *signal_name,
+                                                 const char *callback_name);
+static void signal_profile_destroy(struct signal_profile *pprofile);
 
 /* Signal datastructure. */
 struct signal {
+  char *name;                             /* signal name */
   int nargs;                              /* number of arguments to pass */
   enum api_types *arg_types;              /* argument types */
   struct signal_callback_list *callbacks; /* connected callbacks */
@@ -80,6 +109,17 @@ struct signal {
 /* Signal callback datastructure. */
 struct signal_callback {
   char *name;                             /* callback function name */
+  struct signal_profile *profile;         /* owned by fcl->signal_profiles */
+};
+
+/* Time spent in a callback of a signal. It is kept when the callback is
+ * removed, and reused if it is connected again. */
+struct signal_profile {
+  char *signal_name;
+  char *callback_name;
+  int calls;
+  int depth;                              /* nested invocations */
+  struct timer *timer;
 };
 
 /*****************************************************************************
@@ -113,11 +153,14 @@ struct signal_callback {
 /*****************************************************************************
   Create a new signal callback.
 *****************************************************************************/
-static struct signal_callback *signal_callback_new(const char *name)
+static struct signal_callback *signal_callback_new(const char *name,
+                                                   struct signal_profile *
+                                                   pprofile)
 {
   struct signal_callback *pcallback = fc_malloc(sizeof(*pcallback));
 
   pcallback->name = fc_strdup(name);
+  pcallback->profile = pprofile;
   return pcallback;
 }
 
@@ -133,10 +176,12 @@ static void signal_callback_destroy(struct signal_callback *pcallback)
 /*****************************************************************************
   Create a new signal.
 *****************************************************************************/
-static struct signal *signal_new(int nargs, enum api_types *parg_types)
+static struct signal *signal_new(const char *name, int nargs,
+                                 enum api_types *parg_types)
 {
   struct signal *psignal = fc_malloc(sizeof(*psignal));
 
+  psignal->name = fc_strdup(name);
   psignal->nargs = nargs;
   psignal->arg_types = parg_types;
   psignal->callbacks
@@ -153,9 +198,125 @@ static void signal_destroy(struct signal *psignal)
     free(psignal->arg_types);
   }
   signal_callback_list_destroy(psignal->callbacks);
+  free(psignal->name);
   free(psignal);
 }
 
+/*****************************************************************************
+  Return the profile of the callback 'callback_name' of the signal
+  'signal_name', creating it if needed.
+*****************************************************************************/
+static struct signal_profile *signal_profile_get(struct fc_lua *fcl,
+                                                 const char *signal_name,
+                                                 const char *callback_name)
+{
+  struct signal_profile *pprofile;
+
+  signal_profile_list_iterate(fcl->signal_profiles, pprofile_old) {
+    if (!strcmp(pprofile_old->signal_name, signal_name)
+        && !strcmp(pprofile_old->callback_name, callback_name)) {
+      return pprofile_old;
+    }
+  } signal_profile_list_iterate_end;
+
+  pprofile = fc_malloc(sizeof(*pprofile));
+  pprofile->signal_name = fc_strdup(signal_name);
+  pprofile->callback_name = fc_strdup(callback_name);
+  pprofile->calls = 0;
+  pprofile->depth = 0;
+  pprofile->timer = timer_new(TIMER_CPU, TIMER_ACTIVE);
+  signal_profile_list_append(fcl->signal_profiles, pprofile);
+
+  return pprofile;
+}
+
+/*****************************************************************************
+  Free a callback profile.
+*****************************************************************************/
+static void signal_profile_destroy(struct signal_profile *pprofile)
+{
+  timer_destroy(pprofile->timer);
+  free(pprofile->signal_name);
+  free(pprofile->callback_name);
+  free(pprofile);
+}
+
+/*****************************************************************************
+  Invoke all the callback functions attached to the signal.
+*****************************************************************************/
+static void signal_emit(struct fc_lua *fcl, struct signal *psignal,
+                        int nargs, va_list args)
+{
+  if (psignal->nargs != nargs) {
+    luascript_log(fcl, LOG_ERROR, "Signal \"%s\" requires %d args but was "
+                                  "passed %d on invoke.", psignal->name,
+                  psignal->nargs, nargs);
+    return;
+  }
+
+  signal_callback_list_iterate(psignal->callbacks, pcallback) {
+    /* The callback may remove itself, but its profile is kept. */
+    struct signal_profile *pprofile = pcallback->profile;
+    va_list args_cb;
+    bool stop;
+
+    if (0 == pprofile->depth++) {
+      timer_start(pprofile->timer);
+    }
+    va_copy(args_cb, args);
+    stop = luascript_callback_invoke(fcl, pcallback->name, nargs,
+                                     psignal->arg_types, args_cb);
+    va_end(args_cb);
+    if (0 == --pprofile->depth) {
+      timer_stop(pprofile->timer);
+    }
+    pprofile->calls++;
+
+    if (stop) {
+      break;
+    }
+  } signal_callback_list_iterate_end;
+}
+
+/*****************************************************************************
+  Invoke all the callback functions attached to the signal with the id
+  'signal_id', as returned by luascript_signal_create().
+*****************************************************************************/
+void luascript_signal_emit_by_id_valist(struct fc_lua *fcl, int signal_id,
+                                        int nargs, va_list args)
+{
+  struct signal *psignal;
+
+  fc_assert_ret(fcl);
+  fc_assert_ret(fcl->signals_by_id);
+
+  psignal = genvec_get(fcl->signals_by_id, signal_id);
+  if (NULL == psignal) {
+    luascript_log(fcl, LOG_ERROR, "Signal %d does not exist, so cannot "
+                                  "be invoked.", signal_id);
+  } else if (0 < signal_callback_list_size(psignal->callbacks)) {
+    signal_emit(fcl, psignal, nargs, args);
+  }
+}
+
+/*****************************************************************************
+  Returns whether any callback is connected to the signal with the id
+  'signal_id'. Emitting a signal without callbacks does nothing.
+*****************************************************************************/
+bool luascript_signal_connected(struct fc_lua *fcl, int signal_id)
+{
+  struct signal *psignal;
+
+  if (NULL == fcl || NULL == fcl->signals_by_id
+      || 0 > signal_id || signal_id >= genvec_size(fcl->signals_by_id)) {
+    return FALSE;
+  }
+
+  psignal = genvec_get(fcl->signals_by_id, signal_id);
+
+  return 0 < signal_callback_list_size(psignal->callbacks);
+}
+
 /*****************************************************************************
   Invoke all the callback functions attached to a given signal.
 *****************************************************************************/
@@ -168,23 +329,7 @@ void luascript_signal_emit_valist(struct fc_lua *fcl, const char *signal_name,
   fc_assert_ret(fcl->signals);
 
   if (luascript_signal_hash_lookup(fcl->signals, signal_name, &psignal)) {
-    if (psignal->nargs != nargs) {
-      luascript_log(fcl, LOG_ERROR, "Signal \"%s\" requires %d args but was "
-                                    "passed %d on invoke.", signal_name,
-                    psignal->nargs, nargs);
-    } else {
-      signal_callback_list_iterate(psignal->callbacks, pcallback) {
-        va_list args_cb;
-
-        va_copy(args_cb, args);
-        if (luascript_callback_invoke(fcl, pcallback->name, nargs,
-                                      psignal->arg_types, args_cb)) {
-          va_end(args_cb);
-          break;
-        }
-        va_end(args_cb);
-      } signal_callback_list_iterate_end;
-    }
+    signal_emit(fcl, psignal, nargs, args);
   } else {
     luascript_log(fcl, LOG_ERROR, "Signal \"%s\" does not exist, so cannot "
                                   "be invoked.", signal_name);
@@ -205,20 +350,22 @@ void luascript_signal_emit(struct fc_lua *fcl, const char *signal_name,
 }
 
 /*****************************************************************************
-  Create a new signal type.
+  Create a new signal type. Returns the id of the signal, or -1 on
+  failure.
 *****************************************************************************/
-void luascript_signal_create_valist(struct fc_lua *fcl,
-                                    const char *signal_name,
-                                    int nargs, va_list args)
+int luascript_signal_create_valist(struct fc_lua *fcl,
+                                   const char *signal_name,
+                                   int nargs, va_list args)
 {
   struct signal *psignal;
 
-  fc_assert_ret(fcl);
-  fc_assert_ret(fcl->signals);
+  fc_assert_ret_val(fcl, -1);
+  fc_assert_ret_val(fcl->signals, -1);
 
   if (luascript_signal_hash_lookup(fcl->signals, signal_name, &psignal)) {
     luascript_log(fcl, LOG_ERROR, "Signal \"%s\" was already created.",
                   signal_name);
+    return -1;
   } else {
     enum api_types *parg_types = fc_calloc(nargs, sizeof(*parg_types));
     int i;
@@ -227,24 +374,32 @@ void luascript_signal_create_valist(struct fc_lua *fcl,
     for (i = 0; i < nargs; i++) {
       *(parg_types + i) = va_arg(args, int);
     }
-    luascript_signal_hash_insert(fcl->signals, signal_name,
-                                 signal_new(nargs, parg_types));
+    psignal = signal_new(signal_name, nargs, parg_types);
+    luascript_signal_hash_insert(fcl->signals, signal_name, psignal);
     strcpy(sn, signal_name);
     luascript_signal_name_list_append(fcl->signal_names, sn);
+    /* The id is also the index in fcl->signal_names. */
+    genvec_append(fcl->signals_by_id, psignal);
+
+    return genvec_size(fcl->signals_by_id) - 1;
   }
 }
 
 /*****************************************************************************
-  Create a new signal type.
+  Create a new signal type. Returns the id of the signal, or -1 on
+  failure.
 *****************************************************************************/
-void luascript_signal_create(struct fc_lua *fcl, const char *signal_name,
-                             int nargs, ...)
+int luascript_signal_create(struct fc_lua *fcl, const char *signal_name,
+                            int nargs, ...)
 {
   va_list args;
+  int signal_id;
 
   va_start(args, nargs);
-  luascript_signal_create_valist(fcl, signal_name, nargs, args);
+  signal_id = luascript_signal_create_valist(fcl, signal_name, nargs, args);
   va_end(args);
+
+  return signal_id;
 }
 
 /*****************************************************************************
@@ -275,7 +430,9 @@ void luascript_signal_callback(struct fc_lua *fcl, const char *signal_name,
                         callback_name);
       } else {
         signal_callback_list_append(psignal->callbacks,
-                                    signal_callback_new(callback_name));
+                                    signal_callback_new(callback_name,
+                                      signal_profile_get(fcl, signal_name,
+                                                         callback_name)));
       }
     } else {
       if (pcallback_found) {
@@ -331,6 +488,9 @@ void luascript_signal_init(struct fc_lua *fcl)
   if (NULL == fcl->signals) {
     fcl->signals = luascript_signal_hash_new();
     fcl->signal_names = luascript_signal_name_list_new_full(sn_free);
+    fcl->signals_by_id = genvec_new();
+    fcl->signal_profiles
+      = signal_profile_list_new_full(signal_profile_destroy);
   }
 }
 
@@ -343,8 +503,13 @@ void luascript_signal_free(struct fc_lua *fcl)
     luascript_signal_hash_destroy(fcl->signals);
 
     luascript_signal_name_list_destroy(fcl->signal_names);
+    genvec_destroy(fcl->signals_by_id);
+    signal_profile_list_destroy(fcl->signal_profiles);
 
     fcl->signals = NULL;
+    fcl->signal_names = NULL;
+    fcl->signals_by_id = NULL;
+    fcl->signal_profiles = NULL;
   }
 }
 
@@ -382,3 +547,41 @@ const char *luascript_signal_callback_by_index(struct fc_lua *fcl,
 
   return NULL;
 }
+
+/*****************************************************************************
+  Compare the time spent in two callbacks, for sorting the most expensive
+  first.
+*****************************************************************************/
+static int signal_profile_compare(const struct signal_profile *const *pp1,
+                                  const struct signal_profile *const *pp2)
+{
+  double t1 = timer_read_seconds((*pp1)->timer);
+  double t2 = timer_read_seconds((*pp2)->timer);
+
+  return (t1 < t2) - (t1 > t2);
+}
+
+/*****************************************************************************
+  Log the number of invocations and the CPU time spent in every callback
+  which was ever connected, the most expensive first.
+*****************************************************************************/
+void luascript_signal_profile_report(struct fc_lua *fcl)
+{
+  fc_assert_ret(fcl != NULL);
+  fc_assert_ret(fcl->signal_profiles != NULL);
+
+  if (0 == signal_profile_list_size(fcl->signal_profiles)) {
+    luascript_log(fcl, LOG_NORMAL, "No signal callbacks.");
+    return;
+  }
+
+  signal_profile_list_sort(fcl->signal_profiles, signal_profile_compare);
+
+  luascript_log(fcl, LOG_NORMAL, "%-24s %-32s %8s %10s",
+                "signal", "callback", "calls", "seconds");
+  signal_profile_list_iterate(fcl->signal_profiles, pprofile) {
+    luascript_log(fcl, LOG_NORMAL, "%-24s %-32s %8d %10.3f",
+                  pprofile->signal_name, pprofile->callback_name,
+                  pprofile->calls, timer_read_seconds(pprofile->timer));
+  } signal_profile_list_iterate_end;
+}
@@ -29,11 +29,14 @@ void luascript_signal_emit_valist(struct fc_lua *fcl, const char *signal_name,
                                   int nargs, va_list args);
 void luascript_signal_emit(struct fc_lua *fcl, const char *signal_name,
                            int nargs, ...);
-void luascript_signal_create_valist(struct fc_lua *fcl,
-                                    const char *signal_name, int nargs,
-                                    va_list args);
-void luascript_signal_create(struct fc_lua *fcl, const char *signal_name,
-                             int nargs, ...);
+void luascript_signal_emit_by_id_valist(struct fc_lua *fcl, int signal_id,
+                                        int nargs, va_list args);
+bool luascript_signal_connected(struct fc_lua *fcl, int signal_id);
+int luascript_signal_create_valist(struct fc_lua *fcl,
+                                   const char *signal_name, int nargs,
+                                   va_list args);
+int luascript_signal_create(struct fc_lua *fcl, const char *signal_name,
+                            int nargs, ...);
 void luascript_signal_callback(struct fc_lua *fcl, const char *signal_name,
                                const char *callback_name, bool create);
 bool luascript_signal_callback_defined(struct fc_lua *fcl,
@@ -45,6 +48,8 @@ const char *luascript_signal_callback_by_index(struct fc_lua *fcl,
                                                const char *signal_name,
                                                int index);
 
+void luascript_signal_profile_report(struct fc_lua *fcl);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
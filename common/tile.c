@@ -23,6 +23,7 @@
 /* common */
 #include "fc_interface.h"
 #include "game.h"
+#include "map.h"
 #include "movement.h"
 #include "road.h"
 #include "unit.h"
@@ -953,7 +954,6 @@ struct tile *tile_virtual_new(const struct tile *ptile)
   vtile->worked = NULL;
   vtile->owner = NULL;
   vtile->claimer = NULL;
-  vtile->spec_sprite = NULL;
 
   if (ptile) {
     /* Used by is_city_center to give virtual tiles the output bonuses
@@ -988,7 +988,6 @@ struct tile *tile_virtual_new(const struct tile *ptile)
     vtile->worked = ptile->worked;
     vtile->owner = ptile->owner;
     vtile->claimer = ptile->claimer;
-    vtile->spec_sprite = NULL;
   }
 
   return vtile;
@@ -1060,11 +1059,45 @@ void *tile_hash_key(const struct tile *ptile)
   return key;
 }
 
+/****************************************************************************
+  Returns the cold fields of the tile, or NULL for a virtual tile. The
+  table is only allocated once a field is set, if 'create' is TRUE;
+  before that NULL is returned too.
+****************************************************************************/
+static struct tile_cold *tile_cold_get(const struct tile *ptile, bool create)
+{
+  int idx = tile_index(ptile);
+
+  if (NULL == map.tiles || 0 > idx || idx >= MAP_INDEX_SIZE
+      || ptile != map.tiles + idx) {
+    return NULL;
+  }
+  if (NULL == map.tiles_cold) {
+    if (!create) {
+      return NULL;
+    }
+    map.tiles_cold = fc_calloc(MAP_INDEX_SIZE, sizeof(*map.tiles_cold));
+  }
+
+  return map.tiles_cold + idx;
+}
+
+/****************************************************************************
+  Returns the label of the tile, or NULL if it has none.
+****************************************************************************/
+const char *tile_label(const struct tile *ptile)
+{
+  const struct tile_cold *pcold = tile_cold_get(ptile, FALSE);
+
+  return (NULL != pcold ? pcold->label : NULL);
+}
+
 /****************************************************************************
   Sets label for tile. Returns whether label changed.
 ****************************************************************************/
 bool tile_set_label(struct tile *ptile, const char *label)
 {
+  struct tile_cold *pcold;
   bool changed = FALSE;
 
   /* Handle empty label as NULL label */
@@ -1072,21 +1105,157 @@ bool tile_set_label(struct tile *ptile, const char *label)
     label = NULL;
   }
 
-  if (ptile->label != NULL) {
+  pcold = tile_cold_get(ptile, label != NULL);
+  if (NULL == pcold) {
+    /* Nothing to clear, or a virtual tile. */
+    fc_assert(label == NULL);
+    return FALSE;
+  }
+
+  if (pcold->label != NULL) {
     if (label == NULL) {
       changed = TRUE;
-    } else if (strcmp(ptile->label, label)) {
+    } else if (strcmp(pcold->label, label)) {
       changed = TRUE;
     }
-    FC_FREE(ptile->label);
-    ptile->label = NULL;
+    FC_FREE(pcold->label);
   } else if (label != NULL) {
     changed = TRUE;
   }
 
   if (label != NULL) {
-    ptile->label = fc_strdup(label);
+    pcold->label = fc_strdup(label);
   }
 
   return changed;
 }
+
+/****************************************************************************
+  Returns the name of the special sprite of the tile, or NULL if it has
+  none.
+****************************************************************************/
+const char *tile_spec_sprite(const struct tile *ptile)
+{
+  const struct tile_cold *pcold = tile_cold_get(ptile, FALSE);
+
+  return (NULL != pcold ? pcold->spec_sprite : NULL);
+}
+
+/****************************************************************************
+  Sets the special sprite of the tile; NULL for none.
+****************************************************************************/
+void tile_set_spec_sprite(struct tile *ptile, const char *spec_sprite)
+{
+  struct tile_cold *pcold = tile_cold_get(ptile, NULL != spec_sprite);
+
+  if (NULL == pcold) {
+    /* Nothing to clear, or a virtual tile. */
+    fc_assert(NULL == spec_sprite);
+    return;
+  }
+
+  if (NULL != pcold->spec_sprite) {
+    FC_FREE(pcold->spec_sprite);
+  }
+  if (NULL != spec_sprite) {
+    pcold->spec_sprite = fc_strdup(spec_sprite);
+  }
+}
+
+/* The unit list shared by all map tiles without units, and the emptied
+ * lists kept for reuse. */
+#define TILE_UNITS_POOL_SIZE 256
+static struct unit_list *tile_no_units = NULL;
+static struct unit_list *tile_units_pool[TILE_UNITS_POOL_SIZE];
+static int tile_units_pool_count = 0;
+
+/****************************************************************************
+  Returns the empty unit list shared by the map tiles without units. It
+  must never be changed.
+****************************************************************************/
+struct unit_list *tile_units_empty(void)
+{
+  if (NULL == tile_no_units) {
+    tile_no_units = unit_list_new();
+  }
+
+  return tile_no_units;
+}
+
+/****************************************************************************
+  Add the unit to the front of the units list of the tile. A map tile
+  without units gets a list of its own first.
+****************************************************************************/
+void tile_add_unit(struct tile *ptile, struct unit *punit)
+{
+  if (ptile->units == tile_no_units) {
+    fc_assert(0 == unit_list_size(tile_no_units));
+    ptile->units = (0 < tile_units_pool_count
+                    ? tile_units_pool[--tile_units_pool_count]
+                    : unit_list_new());
+  }
+
+  unit_list_prepend(ptile->units, punit);
+}
+
+/****************************************************************************
+  Remove the unit from the units list of the tile. Returns whether it was
+  there. A map tile left without units gives its list back.
+****************************************************************************/
+bool tile_remove_unit(struct tile *ptile, struct unit *punit)
+{
+  bool removed;
+
+  if (ptile->units == tile_no_units) {
+    return FALSE;
+  }
+
+  removed = unit_list_remove(ptile->units, punit);
+  if (0 == unit_list_size(ptile->units)) {
+    tile_units_clear(ptile);
+  }
+
+  return removed;
+}
+
+/****************************************************************************
+  Remove all units from the units list of the tile. The list of a map
+  tile is given back for reuse. This doesn't free the units.
+****************************************************************************/
+void tile_units_clear(struct tile *ptile)
+{
+  int idx = tile_index(ptile);
+
+  if (ptile->units == tile_no_units) {
+    return;
+  }
+
+  unit_list_clear(ptile->units);
+  if (NULL == map.tiles || 0 > idx || idx >= MAP_INDEX_SIZE
+      || ptile != map.tiles + idx) {
+    /* Virtual tiles keep their own list. */
+    return;
+  }
+
+  if (tile_units_pool_count < TILE_UNITS_POOL_SIZE) {
+    tile_units_pool[tile_units_pool_count++] = ptile->units;
+  } else {
+    unit_list_destroy(ptile->units);
+  }
+  ptile->units = tile_units_empty();
+}
+
+/****************************************************************************
+  Free the shared empty unit list and the lists kept for reuse. No map
+  tile may use them anymore.
+****************************************************************************/
+void tile_units_pool_free(void)
+{
+  while (0 < tile_units_pool_count) {
+    unit_list_destroy(tile_units_pool[--tile_units_pool_count]);
+  }
+  if (NULL != tile_no_units) {
+    unit_list_destroy(tile_no_units);
+    tile_no_units = NULL;
+  }
+}
@@ -56,12 +56,19 @@ struct tile {
   bv_roads roads;
   struct resource *resource;		/* NULL for no resource */
   struct terrain *terrain;		/* NULL for unknown tiles */
-  struct unit_list *units;
+  struct unit_list *units;              /* see tile_add_unit() */
   struct city *worked;			/* NULL for not worked */
   struct player *owner;			/* NULL for not owned */
   struct tile *claimer;
+};
+
+/* Rarely set fields of the tiles. They are kept in map.tiles_cold, apart
+ * from struct tile, so that whole map sweeps touch less memory; the table
+ * is only allocated once one of them is set. Use tile_label() and
+ * tile_spec_sprite() to read them. Virtual tiles have none. */
+struct tile_cold {
   char *label;                          /* NULL for no label */
-  char *spec_sprite;
+  char *spec_sprite;                    /* NULL for no sprite */
 };
 
 /* 'struct tile_list' and related functions. */
@@ -190,7 +197,19 @@ bool tile_virtual_check(struct tile *vtile);
 
 void *tile_hash_key(const struct tile *ptile);
 
+const char *tile_label(const struct tile *ptile);
 bool tile_set_label(struct tile *ptile, const char *label);
+const char *tile_spec_sprite(const struct tile *ptile);
+void tile_set_spec_sprite(struct tile *ptile, const char *spec_sprite);
+
+/* Most map tiles never hold a unit. They all share one empty unit list,
+ * and only get a list of their own while they hold units. So the units
+ * list of a map tile must only be changed by these functions. */
+struct unit_list *tile_units_empty(void);
+void tile_add_unit(struct tile *ptile, struct unit *punit);
+bool tile_remove_unit(struct tile *ptile, struct unit *punit);
+void tile_units_clear(struct tile *ptile);
+void tile_units_pool_free(void);
 
 #ifdef __cplusplus
 }
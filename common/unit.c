@@ -42,6 +42,12 @@
 
 static bool is_real_activity(enum unit_activity activity);
 
+/* Units and their advisor data are created and destroyed all the time. */
+static struct fc_mem_pool unit_pool =
+  FC_MEM_POOL_INIT("unit", sizeof(struct unit));
+static struct fc_mem_pool unit_adv_pool =
+  FC_MEM_POOL_INIT("unit_adv", sizeof(struct unit_adv));
+
 Activity_type_id real_activities[ACTIVITY_LAST];
 
 struct cargo_iter {
@@ -1850,8 +1856,8 @@ struct unit *unit_virtual_create(struct player *pplayer, struct city *pcity,
                                  int veteran_level)
 {
   /* Make sure that contents of unit structure are correctly initialized,
-   * if you ever allocate it by some other mean than fc_calloc() */
-  struct unit *punit = fc_calloc(1, sizeof(*punit));
+   * if you ever allocate it by some other mean than a zeroing allocator */
+  struct unit *punit = fc_mem_pool_alloc(&unit_pool);
   int max_vet_lvl;
 
   /* It does not register the unit so the id is set to 0. */
@@ -1911,7 +1917,7 @@ struct unit *unit_virtual_create(struct player *pplayer, struct city *pcity,
     punit->server.action_turn = -2;
     /* punit->server.moving = NULL; set by fc_calloc(). */
 
-    punit->server.adv = fc_calloc(1, sizeof(*punit->server.adv));
+    punit->server.adv = fc_mem_pool_alloc(&unit_adv_pool);
 
     CALL_FUNC_EACH_AI(unit_alloc, punit);
   } else {
@@ -1951,10 +1957,11 @@ void unit_virtual_destroy(struct unit *punit)
   CALL_FUNC_EACH_AI(unit_free, punit);
 
   if (is_server() && punit->server.adv) {
-    FC_FREE(punit->server.adv);
+    fc_mem_pool_free(&unit_adv_pool, punit->server.adv);
+    punit->server.adv = NULL;
   }
 
-  FC_FREE(punit);
+  fc_mem_pool_free(&unit_pool, punit);
 }
 
 /**************************************************************************
@@ -25,6 +25,8 @@ extern "C" {
 /* get 'struct unit_list' and related functions: */
 #define SPECLIST_TAG unit
 #define SPECLIST_TYPE struct unit
+/* Units on a tile, cargo of a transporter, units supported by a city. */
+#define SPECLIST_SMALL
 #include "speclist.h"
 
 #define unit_list_iterate(unitlist, punit) \
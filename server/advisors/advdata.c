@@ -717,6 +717,9 @@ void adv_data_close(struct player *pplayer)
     free(adv->government_want);
   }
 
+  adv_settler_jobs_destroy(adv->settler_jobs);
+  adv->settler_jobs = NULL;
+
   if (adv->dipl.adv_dipl_slots != NULL) {
     players_iterate(aplayer) {
       adv_dipl_free(pplayer, aplayer);
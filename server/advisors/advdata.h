@@ -132,6 +132,12 @@ struct adv_data {
 
   /* AI doesn't like having more than this number of cities */
   int max_num_cities;
+
+  /* Incremented whenever the infrastructure cache of our cities changes */
+  int infracache_serial;
+
+  /* Candidate jobs for our auto workers, see autosettlers.c */
+  struct adv_settler_jobs *settler_jobs;
 };
 
 enum choice_type {
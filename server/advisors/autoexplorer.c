@@ -19,6 +19,7 @@
 
 /* utility */
 #include "bitvector.h"
+#include "genvec.h"
 #include "log.h"
 
 /* common */
@@ -266,14 +267,14 @@ static int explorer_desirable(struct tile *ptile, struct player *pplayer,
 }
 
 enum unit_move_result random_auto_explorer(struct unit *punit) {
-	struct genlist* actionList = genlist_new();
+	struct genvec* actionList = genvec_new();
 	collect_explorer_moves(punit, actionList);
 
-	int rand_no = rand() % genlist_size(actionList);
-	struct potentialMove *chosen_action = genlist_get(actionList, rand_no);
+	int rand_no = rand() % genvec_size(actionList);
+	struct potentialMove *chosen_action = genvec_get(actionList, rand_no);
 	enum unit_move_result result = make_explorer_move(punit,
 			chosen_action->moveInfo);
-	// Clear the genlist
+	// Clear the genvec
 	free_explorer_moves(actionList);
 	return result;
 }
@@ -461,7 +462,7 @@ enum unit_move_result manage_random_auto_explorer(struct unit *punit)
 
   TIMING_LOG(AIT_EXPLORER, TIMER_START);
 
-  struct genlist* actionList = genlist_new();
+  struct genvec* actionList = genvec_new();
 
 //  struct tile* adj_tiles[8];
   int tiles = 0;
@@ -474,20 +475,20 @@ enum unit_move_result manage_random_auto_explorer(struct unit *punit)
 
 	  if(adv_could_unit_move_to_tile(punit, ptile) != 0){
 //		  adj_tiles[tiles] = ptile;
-		  genlist_append(actionList, ptile);
+		  genvec_append(actionList, ptile);
 		  tiles++;
 	  }
 
   } adjc_iterate_end;
 
 //  printf("%d\n", tiles);
-//  printf("GenList size: %d\n", genlist_size(actionList));
+//  printf("GenList size: %d\n", genvec_size(actionList));
 
   // randomly choose which tile to move to
   //  best_tile = adj_tiles[fc_rand(tiles)];
-  best_tile = genlist_get(actionList, fc_rand(tiles));
+  best_tile = genvec_get(actionList, fc_rand(tiles));
 
-  genlist_destroy(actionList);
+  genvec_destroy(actionList);
 
   TIMING_LOG(AIT_EXPLORER, TIMER_STOP);
 
@@ -527,7 +528,7 @@ enum unit_move_result manage_random_auto_explorer(struct unit *punit)
   Only considers moves that can make within a single turn radius.
   Add moves to the provided list.
 **************************************************************************/
-void collect_explorer_moves(struct unit *punit, struct genlist *move_list) {
+void collect_explorer_moves(struct unit *punit, struct genvec *move_list) {
 	/* Loop prevention */
 	struct tile *init_tile = unit_tile(punit);
 
@@ -564,7 +565,7 @@ void collect_explorer_moves(struct unit *punit, struct genlist *move_list) {
 	index_to_native_pos(&move_tile->x, &move_tile->y, tile_index(init_tile));
 
 	pMove->moveInfo = move_tile;
-	genlist_append(move_list, pMove);
+	genvec_append(move_list, pMove);
 
 	//int move_rate = parameter.move_rate;
 	int move_rate = unit_move_rate(punit);
@@ -585,7 +586,7 @@ void collect_explorer_moves(struct unit *punit, struct genlist *move_list) {
 			index_to_native_pos(&move_tile->x, &move_tile->y,
 					tile_index(ptile));
 			pMove->moveInfo = move_tile;
-			genlist_append(move_list, pMove);
+			genvec_append(move_list, pMove);
 		}
 
 	}pf_map_move_costs_iterate_end;
@@ -640,14 +641,14 @@ enum unit_move_result make_explorer_move(struct unit *punit,
 /**************************************************************************
   Destroy the explorer move list
 **************************************************************************/
-void free_explorer_moves(struct genlist *moveList){
-	for(int i = 0; i < genlist_size(moveList); i++ ){
-		struct potentialMove *toRemove = genlist_back(moveList);
+void free_explorer_moves(struct genvec *moveList){
+	while (genvec_size(moveList) > 0) {
+		struct potentialMove *toRemove = genvec_back(moveList);
 		free(toRemove->moveInfo);
 		free(toRemove);
-		genlist_pop_back(moveList);
+		genvec_pop_back(moveList);
 	}
-	genlist_destroy(moveList);
+	genvec_destroy(moveList);
 }
 
 enum unit_move_result manage_random_auto_explorer2(struct unit *punit)
@@ -679,23 +680,23 @@ enum unit_move_result manage_random_auto_explorer2(struct unit *punit)
 
 	pfm = pf_map_new(&parameter);
 
-	struct genlist* actionList = genlist_new();
+	struct genvec* actionList = genvec_new();
 	int turns = 0;
 
-	genlist_append(actionList, init_tile);
+	genvec_append(actionList, init_tile);
 	pf_map_move_costs_iterate(pfm, ptile, move_cost, FALSE) {
 		fc_assert_action(map_is_known(ptile, pplayer), continue);
 		turns = move_cost / parameter.move_rate;
 
 		if(turns <= 1){
-			genlist_append(actionList, ptile);
+			genvec_append(actionList, ptile);
 		}
 
 	} pf_map_move_costs_iterate_end;
 	pf_map_destroy(pfm);
 
-	best_tile = genlist_get(actionList, fc_rand(genlist_size(actionList)));
-	genlist_destroy(actionList);
+	best_tile = genvec_get(actionList, fc_rand(genvec_size(actionList)));
+	genvec_destroy(actionList);
 
 	TIMING_LOG(AIT_EXPLORER, TIMER_STOP);
 
@@ -13,6 +13,7 @@
 #ifndef FC__AUTOEXPLORER_H
 #define FC__AUTOEXPLORER_H
 
+struct genvec;
 struct unit;
 
 enum moveType{
@@ -33,8 +34,8 @@ enum unit_move_result manage_auto_explorer(struct unit *punit);
 enum unit_move_result manage_random_auto_explorer(struct unit *punit);
 enum unit_move_result manage_random_auto_explorer2(struct unit *punit);
 
-void collect_explorer_moves(struct unit *punit, struct genlist *moveList);
+void collect_explorer_moves(struct unit *punit, struct genvec *moveList);
 enum unit_move_result make_explorer_move(struct unit *punit, struct move_tile_natcoord *move_coord);
-void free_explorer_moves(struct genlist *moveList);
+void free_explorer_moves(struct genvec *moveList);
 
 #endif /* FC__AUTOEXPLORER_H */
@@ -68,15 +68,51 @@ struct settlermap {
   int eta; /* estimated number of turns until enroute arrives */
 };
 
-static struct timer *as_timer = NULL;
+/* A city tile where some worker could do something useful according to
+ * the infrastructure cache. */
+struct settler_job {
+  struct tile *ptile;
+  int cindex;
+  int oldv;                     /* city_tile_value(), -1 until needed. */
+};
+
+/* The jobs of one city: jobs[first .. first + count - 1] of the player. */
+struct settler_job_city {
+  int city_id;
+  int first;
+  int count;
+};
+
+/* Candidate jobs for the workers of one player, kept in the advisor data
+ * of the player. They are collected once and shared by all workers until
+ * the infrastructure cache changes, so each worker only has to look at
+ * the tiles where there is some work. */
+struct adv_settler_jobs {
+  int turn;
+  int serial;                   /* infrastructure_cache_get_serial() */
+  int num_cities;
+  struct settler_job_city *cities;
+  int num_jobs;
+  int max_jobs;
+  struct settler_job *jobs;
+};
 
 /**************************************************************************
-  Free resources allocated for autosettlers system
+  Free the candidate jobs of a player. jobs may be NULL.
 **************************************************************************/
-void adv_settlers_free(void)
+void adv_settler_jobs_destroy(struct adv_settler_jobs *jobs)
 {
-  timer_destroy(as_timer);
-  as_timer = NULL;
+  if (NULL == jobs) {
+    return;
+  }
+
+  if (NULL != jobs->cities) {
+    free(jobs->cities);
+  }
+  if (NULL != jobs->jobs) {
+    free(jobs->jobs);
+  }
+  free(jobs);
 }
 
 /**************************************************************************
@@ -304,6 +340,93 @@ static bool autosettler_enter_territory(const struct player *pplayer,
           || pplayers_allied(owner, pplayer));
 }
 
+/****************************************************************************
+  Returns TRUE if the infrastructure cache knows of any work at the tile
+  'cindex' of pcity, i.e. if settler_evaluate_improvements() could consider
+  some activity there.
+****************************************************************************/
+static bool settler_job_possible(const struct city *pcity, int cindex)
+{
+  activity_type_iterate(act) {
+    if (act != ACTIVITY_BASE && act != ACTIVITY_GEN_ROAD
+        && adv_city_worker_act_get(pcity, cindex, act) >= 0) {
+      return TRUE;
+    }
+  } activity_type_iterate_end;
+
+  road_type_iterate(proad) {
+    if (adv_city_worker_road_get(pcity, cindex, proad) >= 0) {
+      return TRUE;
+    }
+  } road_type_iterate_end;
+
+  base_type_iterate(pbase) {
+    if (adv_city_worker_base_get(pcity, cindex, pbase) > 0) {
+      return TRUE;
+    }
+  } base_type_iterate_end;
+
+  return FALSE;
+}
+
+/****************************************************************************
+  Return the candidate jobs of pplayer, collecting them again if the
+  infrastructure cache has changed since.
+****************************************************************************/
+static struct adv_settler_jobs *settler_jobs_get(const struct player *pplayer)
+{
+  struct adv_data *adv = pplayer->server.adv;
+  struct adv_settler_jobs *sjobs = adv->settler_jobs;
+
+  if (NULL == sjobs) {
+    sjobs = fc_calloc(1, sizeof(*sjobs));
+    sjobs->turn = -1;
+    adv->settler_jobs = sjobs;
+  } else if (sjobs->turn == game.info.turn
+             && sjobs->serial == infrastructure_cache_get_serial(pplayer)
+             && sjobs->num_cities == city_list_size(pplayer->cities)) {
+    return sjobs;
+  }
+
+  sjobs->turn = game.info.turn;
+  sjobs->serial = infrastructure_cache_get_serial(pplayer);
+  sjobs->num_cities = 0;
+  sjobs->num_jobs = 0;
+  sjobs->cities = fc_realloc(sjobs->cities,
+                             MAX(1, city_list_size(pplayer->cities))
+                             * sizeof(*sjobs->cities));
+
+  city_list_iterate(pplayer->cities, pcity) {
+    struct settler_job_city *pjcity = sjobs->cities + sjobs->num_cities++;
+
+    pjcity->city_id = pcity->id;
+    pjcity->first = sjobs->num_jobs;
+
+    city_tile_iterate_index(city_map_radius_sq_get(pcity), city_tile(pcity),
+                            ptile, cindex) {
+      struct settler_job *pjob;
+
+      if (!settler_job_possible(pcity, cindex)) {
+        continue;
+      }
+
+      if (sjobs->num_jobs == sjobs->max_jobs) {
+        sjobs->max_jobs = MAX(64, 2 * sjobs->max_jobs);
+        sjobs->jobs = fc_realloc(sjobs->jobs,
+                                 sjobs->max_jobs * sizeof(*sjobs->jobs));
+      }
+      pjob = sjobs->jobs + sjobs->num_jobs++;
+      pjob->ptile = ptile;
+      pjob->cindex = cindex;
+      pjob->oldv = -1;
+    } city_tile_iterate_index_end;
+
+    pjcity->count = sjobs->num_jobs - pjcity->first;
+  } city_list_iterate_end;
+
+  return sjobs;
+}
+
 /****************************************************************************
   Finds tiles to improve, using punit.
 
@@ -340,17 +463,28 @@ int settler_evaluate_improvements(struct unit *punit,
 
   /* closest worker, if any, headed towards target tile */
   struct unit *enroute = NULL;
+  struct adv_settler_jobs *sjobs;
+  int i, j;
 
   pft_fill_unit_parameter(&parameter, punit);
   parameter.can_invade_tile = autosettler_enter_territory;
   pfm = pf_map_new(&parameter);
 
-  city_list_iterate(pplayer->cities, pcity) {
-    struct tile *pcenter = city_tile(pcity);
+  sjobs = settler_jobs_get(pplayer);
+
+  for (i = 0; i < sjobs->num_cities; i++) {
+    struct settler_job_city *pjcity = sjobs->cities + i;
+    struct city *pcity = game_city_by_number(pjcity->city_id);
+
+    if (NULL == pcity || city_owner(pcity) != pplayer) {
+      continue;
+    }
 
     /* try to work near the city */
-    city_tile_iterate_index(city_map_radius_sq_get(pcity), pcenter, ptile,
-                            cindex) {
+    for (j = pjcity->first; j < pjcity->first + pjcity->count; j++) {
+      struct settler_job *pjob = sjobs->jobs + j;
+      struct tile *ptile = pjob->ptile;
+      int cindex = pjob->cindex;
       bool consider = TRUE;
       bool in_use = (tile_worked(ptile) == pcity);
 
@@ -407,7 +541,10 @@ int settler_evaluate_improvements(struct unit *punit,
                      enroute->id, eta, inbound_distance);
           }
 
-          oldv = city_tile_value(pcity, ptile, 0, 0);
+          if (0 > pjob->oldv) {
+            pjob->oldv = city_tile_value(pcity, ptile, 0, 0);
+          }
+          oldv = pjob->oldv;
 
           /* Now, consider various activities... */
           activity_type_iterate(act) {
@@ -553,8 +690,8 @@ int settler_evaluate_improvements(struct unit *punit,
           } base_type_iterate_end;
         } /* endif: can we finish sooner than current worker, if any? */
       } /* endif: are we travelling to a legal destination? */
-    } city_tile_iterate_index_end;
-  } city_list_iterate_end;
+    }
+  }
 
   best_newv /= WORKER_FACTOR;
 
@@ -892,10 +1029,11 @@ bool adv_settler_safe_tile(const struct player *pplayer, struct unit *punit,
 void auto_settlers_player(struct player *pplayer) 
 {
   struct settlermap *state;
+  struct timer *as_timer;
 
   state = fc_calloc(MAP_INDEX_SIZE, sizeof(*state));
 
-  as_timer = timer_renew(as_timer, TIMER_CPU, TIMER_DEBUG);
+  as_timer = timer_new(TIMER_CPU, TIMER_DEBUG);
   timer_start(as_timer);
 
   if (pplayer->ai_controlled) {
@@ -982,6 +1120,7 @@ void auto_settlers_player(struct player *pplayer)
 
   }
 
+  timer_destroy(as_timer);
   FC_FREE(state);
 }
 
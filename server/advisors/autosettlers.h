@@ -17,10 +17,11 @@
 #include "fc_types.h"
 #include "map.h"
 
+struct adv_settler_jobs;
 struct settlermap;
 struct pf_path;
 
-void adv_settlers_free(void);
+void adv_settler_jobs_destroy(struct adv_settler_jobs *jobs);
 
 void auto_settlers_player(struct player *pplayer);
 
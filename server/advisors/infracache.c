@@ -15,6 +15,9 @@
 #include <fc_config.h>
 #endif
 
+/* utility */
+#include "mem.h"
+
 /* common */
 #include "city.h"
 #include "game.h"
@@ -26,6 +29,9 @@
 #include "citytools.h"
 #include "maphand.h"
 
+/* server/advisors */
+#include "advdata.h"
+
 #include "infracache.h"
 
 /* cache activities within the city map */
@@ -35,6 +41,9 @@ struct worker_activity_cache {
   int base[MAX_BASE_TYPES];
 };
 
+static struct fc_mem_pool adv_city_pool =
+  FC_MEM_POOL_INIT("adv_city", sizeof(struct adv_city));
+
 static int adv_calc_irrigate(const struct city *pcity,
                              const struct tile *ptile);
 static int adv_calc_mine(const struct city *pcity, const struct tile *ptile);
@@ -390,6 +399,8 @@ static int best_worker_tile_value(struct city *pcity)
 **************************************************************************/
 void initialize_infrastructure_cache(struct player *pplayer)
 {
+  pplayer->server.adv->infracache_serial++;
+
   city_list_iterate(pplayer->cities, pcity) {
     struct tile *pcenter = city_tile(pcity);
     int radius_sq = city_map_radius_sq_get(pcity);
@@ -612,15 +623,26 @@ void adv_city_update(struct city *pcity)
            city_map_tiles(radius_sq)
            * sizeof(*(pcity->server.adv->act_cache)));
     pcity->server.adv->act_cache_radius_sq = radius_sq;
+    city_owner(pcity)->server.adv->infracache_serial++;
   }
 }
 
+/**************************************************************************
+  Return a number that changes whenever the values cached by
+  initialize_infrastructure_cache() for the cities of pplayer may have
+  changed.
+**************************************************************************/
+int infrastructure_cache_get_serial(const struct player *pplayer)
+{
+  return pplayer->server.adv->infracache_serial;
+}
+
 /**************************************************************************
   Allocate advisors related city data
 **************************************************************************/
 void adv_city_alloc(struct city *pcity)
 {
-  pcity->server.adv = fc_calloc(1, sizeof(*pcity->server.adv));
+  pcity->server.adv = fc_mem_pool_alloc(&adv_city_pool);
 
   pcity->server.adv->act_cache = NULL;
   pcity->server.adv->act_cache_radius_sq = -1;
@@ -639,6 +661,7 @@ void adv_city_free(struct city *pcity)
     if (pcity->server.adv->act_cache) {
       FC_FREE(pcity->server.adv->act_cache);
     }
-    FC_FREE(pcity->server.adv);
+    fc_mem_pool_free(&adv_city_pool, pcity->server.adv);
+    pcity->server.adv = NULL;
   }
 }
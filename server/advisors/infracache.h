@@ -36,6 +36,7 @@ void adv_city_alloc(struct city *pcity);
 void adv_city_free(struct city *pcity);
 
 void initialize_infrastructure_cache(struct player *pplayer);
+int infrastructure_cache_get_serial(const struct player *pplayer);
 
 void adv_city_update(struct city *pcity);
 
@@ -1569,6 +1569,9 @@ void create_city(struct player *pplayer, struct tile *ptile,
   city_thaw_workers_queue(); /* after new city has a chance to work! */
   city_refresh_queue_processing();
 
+  /* The new city works tiles around it, even inside old borders. */
+  CALL_FUNC_EACH_AI(tile_changed, ptile);
+
   /* Bases destroyed earlier may have had watchtower effect. Refresh
    * unit vision. */
   unit_list_refresh_vision(ptile->units);
@@ -1612,7 +1615,7 @@ void create_city(struct player *pplayer, struct tile *ptile,
 
   sanity_check_city(pcity);
 
-  script_server_signal_emit("city_built", 1,
+  script_server_signal_emit(SIGNAL_CITY_BUILT, 1,
                             API_TYPE_CITY, pcity);
 }
 
@@ -1633,6 +1636,8 @@ void remove_city(struct city *pcity)
   struct tile_list *process_queue;
   const char *ctl = city_tile_link(pcity);
 
+  sanity_mark_tile(pcenter);
+
   BV_CLR_ALL(had_small_wonders);
   city_built_iterate(pcity, pimprove) {
     city_remove_improvement(pcity, pimprove);
@@ -1774,6 +1779,7 @@ void remove_city(struct city *pcity)
 
   /* Remove city from the map. */
   tile_set_worked(pcenter, NULL);
+  CALL_FUNC_EACH_AI(tile_changed, pcenter);
 
   /* Reveal units. */
   players_iterate(other_player) {
@@ -1909,7 +1915,7 @@ void unit_enter_city(struct unit *punit, struct city *pcity, bool passenger)
     notify_player(cplayer, city_tile(pcity), E_CITY_LOST, ftc_server,
                   _("%s has been destroyed by %s."), 
                   city_tile_link(pcity), player_name(pplayer));
-    script_server_signal_emit("city_destroyed", 3,
+    script_server_signal_emit(SIGNAL_CITY_DESTROYED, 3,
                               API_TYPE_CITY, pcity,
                               API_TYPE_PLAYER, cplayer,
                               API_TYPE_PLAYER, pplayer);
@@ -2007,7 +2013,7 @@ void unit_enter_city(struct unit *punit, struct city *pcity, bool passenger)
   }
 
   if (city_remains) {
-    script_server_signal_emit("city_lost", 3,
+    script_server_signal_emit(SIGNAL_CITY_LOST, 3,
                               API_TYPE_CITY, pcity,
                               API_TYPE_PLAYER, cplayer,
                               API_TYPE_PLAYER, pplayer);
@@ -2185,6 +2191,8 @@ void send_city_info(struct player *dest, struct city *pcity)
 {
   struct player *powner = city_owner(pcity);
 
+  sanity_mark_city(pcity);
+
   if (S_S_RUNNING != server_state() && S_S_OVER != server_state()) {
     return;
   }
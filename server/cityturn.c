@@ -27,6 +27,7 @@
 #include "rand.h"
 #include "shared.h"
 #include "support.h"
+#include "timing.h"
 
 /* common/aicore */
 #include "cm.h"
@@ -144,11 +145,13 @@ bool city_refresh(struct city *pcity)
 {
   bool retval;
 
+  PROFILE_ZONE_START("city_refresh");
   pcity->server.needs_refresh = FALSE;
 
   retval = city_map_update_radius_sq(pcity);
   city_units_upkeep(pcity); /* update unit upkeep */
   city_refresh_from_main_map(pcity, NULL);
+  PROFILE_ZONE_STOP("city_refresh");
 
   if (retval) {
     /* Force a sync of the city after the change. */
@@ -320,7 +323,6 @@ void auto_arrange_workers(struct city *pcity)
   city_refresh(pcity);
 
   sanity_check_city(pcity);
-  cm_clear_cache(pcity);
 
   cm_init_parameter(&cmp);
   cmp.require_happy = FALSE;
@@ -678,7 +680,7 @@ bool city_reduce_size(struct city *pcity, citizens pop_loss,
 
   if (city_size_get(pcity) <= pop_loss) {
 
-    script_server_signal_emit("city_destroyed", 3,
+    script_server_signal_emit(SIGNAL_CITY_DESTROYED, 3,
                               API_TYPE_CITY, pcity,
                               API_TYPE_PLAYER, pcity->owner,
                               API_TYPE_PLAYER, destroyer);
@@ -872,7 +874,7 @@ static bool city_increase_size(struct city *pcity, struct player *nationality)
   notify_player(powner, city_tile(pcity), E_CITY_GROWTH, ftc_server,
                 _("%s grows to size %d."),
                 city_link(pcity), city_size_get(pcity));
-  script_server_signal_emit("city_growth", 2,
+  script_server_signal_emit(SIGNAL_CITY_GROWTH, 2,
                             API_TYPE_CITY, pcity,
                             API_TYPE_INT, city_size_get(pcity));
   if (city_exist(saved_id)) {
@@ -1029,7 +1031,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                       _("%s can't build %s from the worklist; "
                         "tech not yet available.  Postponing..."),
                       city_link(pcity), utype_name_translation(ptarget));
-        script_server_signal_emit("unit_cant_be_built", 3,
+        script_server_signal_emit(SIGNAL_UNIT_CANT_BE_BUILT, 3,
                                   API_TYPE_UNIT_TYPE, ptarget,
                                   API_TYPE_CITY, pcity,
                                   API_TYPE_STRING, "need_tech");
@@ -1048,7 +1050,7 @@ static bool worklist_change_build_target(struct player *pplayer,
 			    in the worklist, not its obsolete-closure
 			    pupdate. */
 			 utype_name_translation(ptarget));
-        script_server_signal_emit("unit_cant_be_built", 3,
+        script_server_signal_emit(SIGNAL_UNIT_CANT_BE_BUILT, 3,
                                   API_TYPE_UNIT_TYPE, ptarget,
                                   API_TYPE_CITY, pcity,
                                   API_TYPE_STRING, "never");
@@ -1085,7 +1087,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                       _("%s can't build %s from the worklist.  Purging..."),
                       city_link(pcity),
                       city_improvement_name_translation(pcity, ptarget));
-        script_server_signal_emit("building_cant_be_built", 3,
+        script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
                                   API_TYPE_BUILDING_TYPE, ptarget,
                                   API_TYPE_CITY, pcity,
                                   API_TYPE_STRING, "never");
@@ -1120,7 +1122,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                             city_improvement_name_translation(pcity, ptarget),
                             advance_name_for_player(pplayer,
                                  advance_number(preq->source.value.advance)));
-              script_server_signal_emit("building_cant_be_built", 3,
+              script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
                                         API_TYPE_BUILDING_TYPE, ptarget,
                                         API_TYPE_CITY, pcity,
                                         API_TYPE_STRING, "need_tech");
@@ -1134,7 +1136,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                             city_link(pcity),
                             city_improvement_name_translation(pcity, ptarget),
                             tech_flag_id_name(preq->source.value.techflag));
-              script_server_signal_emit("building_cant_be_built", 3,
+              script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
                                         API_TYPE_BUILDING_TYPE, ptarget,
                                         API_TYPE_CITY, pcity,
                                         API_TYPE_STRING, "need_techflag");
@@ -1148,7 +1150,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                             city_improvement_name_translation(pcity, ptarget),
                             city_improvement_name_translation(pcity,
 						preq->source.value.building));
-              script_server_signal_emit("building_cant_be_built", 3,
+              script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
                                         API_TYPE_BUILDING_TYPE, ptarget,
                                         API_TYPE_CITY, pcity,
                                         API_TYPE_STRING, "need_building");
@@ -1161,7 +1163,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                             city_link(pcity),
                             city_improvement_name_translation(pcity, ptarget),
                             government_name_translation(preq->source.value.govern));
-              script_server_signal_emit("building_cant_be_built", 3,
+              script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
                                         API_TYPE_BUILDING_TYPE, ptarget,
                                         API_TYPE_CITY, pcity,
                                         API_TYPE_STRING, "need_government");
@@ -1174,7 +1176,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                             city_link(pcity),
                             city_improvement_name_translation(pcity, ptarget),
                             special_name_translation(preq->source.value.special));
-              script_server_signal_emit("building_cant_be_built", 3,
+              script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
                                         API_TYPE_BUILDING_TYPE, ptarget,
                                         API_TYPE_CITY, pcity,
                                         API_TYPE_STRING, "need_special");
@@ -1187,7 +1189,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                             city_link(pcity),
                             city_improvement_name_translation(pcity, ptarget),
                             terrain_name_translation(preq->source.value.terrain));
-              script_server_signal_emit("building_cant_be_built", 3,
+              script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
                                         API_TYPE_BUILDING_TYPE, ptarget,
                                         API_TYPE_CITY, pcity,
                                         API_TYPE_STRING, "need_terrain");
@@ -1200,7 +1202,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                             city_link(pcity),
                             city_improvement_name_translation(pcity, ptarget),
                             resource_name_translation(preq->source.value.resource));
-              script_server_signal_emit("building_cant_be_built", 3,
+              script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
                                         API_TYPE_BUILDING_TYPE, ptarget,
                                         API_TYPE_CITY, pcity,
                                         API_TYPE_STRING, "need_resource");
@@ -1215,7 +1217,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                             city_link(pcity),
                             city_improvement_name_translation(pcity, ptarget),
                             nation_plural_translation(preq->source.value.nation));
-              script_server_signal_emit("building_cant_be_built", 3,
+              script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
                                         API_TYPE_BUILDING_TYPE, ptarget,
                                         API_TYPE_CITY, pcity,
                                         API_TYPE_STRING, "need_nation");
@@ -1229,7 +1231,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                             city_link(pcity),
                             city_improvement_name_translation(pcity, ptarget),
                             nation_plural_translation(preq->source.value.nationality));
-              script_server_signal_emit("building_cant_be_built", 3,
+              script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
                                         API_TYPE_BUILDING_TYPE, ptarget,
                                         API_TYPE_CITY, pcity,
                                         API_TYPE_STRING, "need_nationality");
@@ -1242,7 +1244,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                             city_link(pcity),
                             city_improvement_name_translation(pcity, ptarget),
                             preq->source.value.minsize);
-	      script_server_signal_emit("building_cant_be_built", 3,
+	      script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
 				 API_TYPE_BUILDING_TYPE, ptarget,
 				 API_TYPE_CITY, pcity,
 				 API_TYPE_STRING, "need_minsize");
@@ -1258,7 +1260,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                             city_link(pcity),
                             city_improvement_name_translation(pcity, ptarget),
                             ai_level_name(preq->source.value.ai_level));
-              script_server_signal_emit("building_cant_be_built", 3,
+              script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
                                         API_TYPE_BUILDING_TYPE, ptarget,
                                         API_TYPE_CITY, pcity,
                                         API_TYPE_STRING, "need_ai_level");
@@ -1272,7 +1274,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                             city_link(pcity),
                             city_improvement_name_translation(pcity, ptarget),
                             terrain_class_name_translation(preq->source.value.terrainclass));
-              script_server_signal_emit("building_cant_be_built", 3,
+              script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
                                         API_TYPE_BUILDING_TYPE, ptarget,
                                         API_TYPE_CITY, pcity,
                                         API_TYPE_STRING, "need_terrainclass");
@@ -1286,7 +1288,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                             city_link(pcity),
                             city_improvement_name_translation(pcity, ptarget),
                             terrain_flag_id_name(preq->source.value.terrainflag));
-              script_server_signal_emit("building_cant_be_built", 3,
+              script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
                                         API_TYPE_BUILDING_TYPE, ptarget,
                                         API_TYPE_CITY, pcity,
                                         API_TYPE_STRING, "need_terrainflag");
@@ -1299,7 +1301,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                             city_link(pcity),
                             city_improvement_name_translation(pcity, ptarget),
                             road_name_translation(preq->source.value.road));
-              script_server_signal_emit("building_cant_be_built", 3,
+              script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
                                         API_TYPE_BUILDING_TYPE, ptarget,
                                         API_TYPE_CITY, pcity,
                                         API_TYPE_STRING, "need_road");
@@ -1326,7 +1328,7 @@ static bool worklist_change_build_target(struct player *pplayer,
                             city_link(pcity),
                             city_improvement_name_translation(pcity, ptarget),
                             textyear(preq->source.value.minyear));
-              script_server_signal_emit("building_cant_be_built", 3,
+              script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
                                         API_TYPE_BUILDING_TYPE, ptarget,
                                         API_TYPE_CITY, pcity,
                                         API_TYPE_STRING, "need_minyear");
@@ -1615,7 +1617,7 @@ static bool city_build_building(struct player *pplayer, struct city *pcity)
                   _("%s is building %s, which is no longer available."),
                   city_link(pcity),
                   city_improvement_name_translation(pcity, pimprove));
-    script_server_signal_emit("building_cant_be_built", 3,
+    script_server_signal_emit(SIGNAL_BUILDING_CANT_BE_BUILT, 3,
                               API_TYPE_BUILDING_TYPE, pimprove,
                               API_TYPE_CITY, pcity,
                               API_TYPE_STRING, "unavailable");
@@ -1660,7 +1662,7 @@ static bool city_build_building(struct player *pplayer, struct city *pcity)
     notify_player(pplayer, city_tile(pcity), E_IMP_BUILD, ftc_server,
                   _("%s has finished building %s."),
                   city_link(pcity), improvement_name_translation(pimprove));
-    script_server_signal_emit("building_built", 2,
+    script_server_signal_emit(SIGNAL_BUILDING_BUILT, 2,
                               API_TYPE_BUILDING_TYPE, pimprove,
                               API_TYPE_CITY, pcity);
 
@@ -1758,7 +1760,7 @@ static bool city_build_unit(struct player *pplayer, struct city *pcity)
     log_verbose("%s %s tried to build %s, which is not available.",
                 nation_rule_name(nation_of_city(pcity)),
                 city_name(pcity), utype_rule_name(utype));
-    script_server_signal_emit("unit_cant_be_built", 3,
+    script_server_signal_emit(SIGNAL_UNIT_CANT_BE_BUILT, 3,
                               API_TYPE_UNIT_TYPE, utype,
                               API_TYPE_CITY, pcity,
                               API_TYPE_STRING, "unavailable");
@@ -1783,7 +1785,7 @@ static bool city_build_unit(struct player *pplayer, struct city *pcity)
                       "(city size: %d, unit population cost: %d)"),
                     city_link(pcity), utype_name_translation(utype),
                     city_size_get(pcity), pop_cost);
-      script_server_signal_emit("unit_cant_be_built", 3,
+      script_server_signal_emit(SIGNAL_UNIT_CANT_BE_BUILT, 3,
                                 API_TYPE_UNIT_TYPE, utype,
                                 API_TYPE_CITY, pcity,
                                 API_TYPE_STRING, "pop_cost");
@@ -1836,7 +1838,7 @@ static bool city_build_unit(struct player *pplayer, struct city *pcity)
                       city_link(pcity), city_size_get(pcity));
       }
 
-      script_server_signal_emit("unit_built", 2,
+      script_server_signal_emit(SIGNAL_UNIT_BUILT, 2,
                                 API_TYPE_UNIT, punit,
                                 API_TYPE_CITY, pcity);
 
@@ -2540,7 +2542,7 @@ static bool disband_city(struct city *pcity)
                   _("%s can't build %s yet, "
                     "and we can't disband our only city."),
                   city_link(pcity), utype_name_translation(utype));
-    script_server_signal_emit("unit_cant_be_built", 3,
+    script_server_signal_emit(SIGNAL_UNIT_CANT_BE_BUILT, 3,
                               API_TYPE_UNIT_TYPE, utype,
                               API_TYPE_CITY, pcity,
                               API_TYPE_STRING, "pop_cost");
@@ -2569,7 +2571,7 @@ static bool disband_city(struct city *pcity)
                 _("%s is disbanded into %s."), 
                 city_tile_link(pcity), utype_name_translation(utype));
 
-  script_server_signal_emit("city_destroyed", 3,
+  script_server_signal_emit(SIGNAL_CITY_DESTROYED, 3,
                             API_TYPE_CITY, pcity,
                             API_TYPE_PLAYER, pcity->owner,
                             API_TYPE_PLAYER, NULL);
@@ -2836,7 +2838,7 @@ static bool do_city_migration(struct city *pcity_from,
                           -1, TRUE);
       sz_strlcpy(name_from, city_tile_link(pcity_from));
 
-      script_server_signal_emit("city_destroyed", 3,
+      script_server_signal_emit(SIGNAL_CITY_DESTROYED, 3,
                                 API_TYPE_CITY, pcity_from,
                                 API_TYPE_PLAYER, pcity_from->owner,
                                 API_TYPE_PLAYER, NULL);
@@ -3052,7 +3054,7 @@ static void apply_disaster(struct city *pcity, struct disaster_type *pdis)
     }
   }
 
-  script_server_signal_emit("disaster", 2,
+  script_server_signal_emit(SIGNAL_DISASTER, 2,
                             API_TYPE_DISASTER, pdis,
                             API_TYPE_CITY, pcity);
 }
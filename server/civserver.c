@@ -62,6 +62,7 @@
 #include "console.h"
 #include "ggzserver.h"
 #include "meta.h"
+#include "sanitycheck.h"
 #include "sernet.h"
 #include "srv_main.h"
 
@@ -270,6 +271,30 @@ int main(int argc, char *argv[])
       free(option);
     } else if (is_option("--exit-on-end", argv[inx])) {
       srvarg.exit_on_end = TRUE;
+    } else if ((option = get_option_malloc("--genmaps", argv, &inx, argc))) {
+      if (!str_to_int(option, &srvarg.genmaps) || srvarg.genmaps < 0) {
+        showhelp = TRUE;
+        break;
+      }
+      free(option);
+    } else if ((option = get_option_malloc("--workers", argv, &inx, argc))) {
+      if (!str_to_int(option, &srvarg.genmaps_workers)
+          || srvarg.genmaps_workers < 1
+          || srvarg.genmaps_workers > GENMAPS_MAX_WORKERS) {
+        showhelp = TRUE;
+        break;
+      }
+      free(option);
+#ifdef SANITY_CHECKING
+    } else if ((option = get_option_malloc("--checkturns",
+                                           argv, &inx, argc))) {
+      if (!str_to_int(option, &srvarg.sanity_check_turns)
+          || srvarg.sanity_check_turns < 0) {
+        showhelp = TRUE;
+        break;
+      }
+      free(option);
+#endif /* SANITY_CHECKING */
     } else if ((option = get_option_malloc("--debug", argv, &inx, argc))) {
       if (!log_parse_level_str(option, &srvarg.loglevel)) {
         showhelp = TRUE;
@@ -361,6 +386,13 @@ int main(int argc, char *argv[])
                 _("Listen for clients on ADDR"));
     cmdhelp_add(help, "B", "Bind-meta ADDR",
                 _("Connect to metaserver from this address"));
+#ifdef SANITY_CHECKING
+    cmdhelp_add(help, "c",
+                /* TRANS: "checkturns" is exactly what user must type, do not translate. */
+                _("checkturns TURNS"),
+                _("Check the whole game state only every TURNS turns, "
+                  "and only what changed in between"));
+#endif /* SANITY_CHECKING */
 #ifdef DEBUG
     cmdhelp_add(help, "d",
                 /* TRANS: "debug" is exactly what user must type, do not translate. */
@@ -383,6 +415,11 @@ int main(int argc, char *argv[])
                 /* TRANS: "file" is exactly what user must type, do not translate. */
                 _("file FILE"),
                 _("Load saved game FILE"));
+    cmdhelp_add(help, "g",
+                /* TRANS: "genmaps" is exactly what user must type, do not translate. */
+                _("genmaps COUNT"),
+                _("Generate COUNT maps with consecutive map seeds, save "
+                  "them as scenarios and exit"));
     cmdhelp_add(help, "h", "help",
                 _("Print a summary of the options"));
     cmdhelp_add(help, "i",
@@ -440,6 +477,10 @@ int main(int argc, char *argv[])
 #endif /* AI_MODULES */
     cmdhelp_add(help, "v", "version",
                 _("Print the version number"));
+    cmdhelp_add(help, "w",
+                /* TRANS: "workers" is exactly what user must type, do not translate. */
+                _("workers NUM"),
+                _("Use NUM worker processes with --genmaps"));
 
     /* The function below prints a header and footer for the options.
      * Furthermore, the options are sorted. */
@@ -85,6 +85,7 @@ static struct command commands[] = {
    /* no translatable parameters */
    SYN_ORIG_("list\n"
              "list colors\n"
+             "list compression\n"
              "list connections\n"
              "list delegations\n"
              "list ignored users\n"
@@ -97,6 +98,7 @@ static struct command commands[] = {
    N_("Show a list of various things."),
    N_("Show a list of:\n"
       " - the player colors,\n"
+      " - packet compression statistics,\n"
       " - connections to the server,\n"
       " - all player delegations,\n"
       " - your ignore list,\n"
@@ -204,10 +206,13 @@ static struct command commands[] = {
       "debug units <x> <y>\n"
       "debug unit <id>\n"
       "debug timing\n"
+      "debug profile [file]\n"
       "debug info"),
    N_("Turn on or off AI debugging of given entity."),
    N_("Print AI debug information about given entity and turn continuous "
-      "debugging output for this entity on or off."), NULL,
+      "debugging output for this entity on or off. 'debug profile' starts "
+      "or stops writing the time spent in the server to a file, as folded "
+      "stacks suitable for flame graph tools."), NULL,
    CMD_ECHO_ADMINS, VCF_NONE, 0
   },
   {"set",	ALLOW_CTRL,
@@ -612,9 +617,13 @@ static struct command commands[] = {
    /* TRANS: translate text between <> only */
    N_("lua cmd <script line>\n"
       "lua file <script file>\n"
+      "lua profile\n"
       "lua <script line> (deprecated)"),
    N_("Evaluate a line of Freeciv script or a Freeciv script file in the "
-      "current game."), NULL, NULL,
+      "current game."),
+   N_("'lua profile' lists the callbacks connected to the script signals, "
+      "with the number of times they were called and the CPU time spent "
+      "in them."), NULL,
    CMD_ECHO_ADMINS, VCF_NONE, 0
   },
   {"kick", ALLOW_CTRL,
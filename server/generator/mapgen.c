@@ -28,6 +28,7 @@
 #include "mem.h"
 #include "rand.h"
 #include "shared.h"
+#include "timing.h"
 
 /* common */
 #include "game.h"
@@ -1372,6 +1373,9 @@ bool map_fractal_generate(bool autosize, struct unit_type *initial_unit)
   /* save the current random state: */
   RANDOM_STATE rstate;
   RANDOM_TYPE seed_rand;
+  struct timer *gen_timer = timer_new(TIMER_USER, TIMER_ACTIVE);
+
+  timer_start(gen_timer);
 
   /* Call fc_rand() even when result is not needed to make sure
    * random state proceeds equally for random seeds and explicitly
@@ -1552,6 +1556,7 @@ bool map_fractal_generate(bool autosize, struct unit_type *initial_unit)
         default:
           log_error(_("The server couldn't allocate starting positions."));
           destroy_tmap();
+          timer_destroy(gen_timer);
           return FALSE;
       }
     }
@@ -1562,6 +1567,11 @@ bool map_fractal_generate(bool autosize, struct unit_type *initial_unit)
 
   print_mapgen_map();
 
+  timer_stop(gen_timer);
+  log_verbose("Map generation (%dx%d) took %.3f seconds.",
+              map.xsize, map.ysize, timer_read_seconds(gen_timer));
+  timer_destroy(gen_timer);
+
   return TRUE;
 }
 
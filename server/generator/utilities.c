@@ -16,7 +16,9 @@
 
 /* utility */
 #include "fcintl.h"
+#include "fcthread.h"
 #include "log.h"
+#include "mem.h"
 #include "rand.h"
 #include "support.h"            /* bool type */
 
@@ -119,26 +121,45 @@ void set_placed_near_pos(struct tile *ptile, int dist)
 
   If filter is non-null then it only tiles for which filter(ptile, data) is
   TRUE will be considered.
+
+  Without a filter the map is scanned as a plain array, which lets the
+  compiler vectorize the minimum/maximum and translation passes.
 **************************************************************************/
 void adjust_int_map_filtered(int *int_map, int int_map_max, void *data,
 			     bool (*filter)(const struct tile *ptile,
 					    const void *data))
 {
+  const int map_size = MAP_INDEX_SIZE;
   int minval = 0, maxval = 0, total = 0;
-  bool first = TRUE;
+  int i;
 
-  /* Determine minimum and maximum value. */
-  whole_map_iterate_filtered(ptile, data, filter) {
-    if (first) {
-      minval = int_map[tile_index(ptile)];
-      maxval = int_map[tile_index(ptile)];
-    } else {
-      maxval = MAX(maxval, int_map[tile_index(ptile)]);
-      minval = MIN(minval, int_map[tile_index(ptile)]);
+  if (NULL == filter) {
+    if (map_size == 0) {
+      return;
+    }
+    minval = int_map[0];
+    maxval = int_map[0];
+    for (i = 1; i < map_size; i++) {
+      maxval = MAX(maxval, int_map[i]);
+      minval = MIN(minval, int_map[i]);
     }
-    first = FALSE;
-    total++;
-  } whole_map_iterate_filtered_end;
+    total = map_size;
+  } else {
+    bool first = TRUE;
+
+    /* Determine minimum and maximum value. */
+    whole_map_iterate_filtered(ptile, data, filter) {
+      if (first) {
+        minval = int_map[tile_index(ptile)];
+        maxval = int_map[tile_index(ptile)];
+      } else {
+        maxval = MAX(maxval, int_map[tile_index(ptile)]);
+        minval = MIN(minval, int_map[tile_index(ptile)]);
+      }
+      first = FALSE;
+      total++;
+    } whole_map_iterate_filtered_end;
+  }
 
   if (total == 0) {
     return;
@@ -146,17 +167,25 @@ void adjust_int_map_filtered(int *int_map, int int_map_max, void *data,
 
   {
     int const size = 1 + maxval - minval;
-    int i, count = 0, frequencies[size];
-
-    INITIALIZE_ARRAY(frequencies, size, 0);
+    int count = 0;
+    int *frequencies = fc_calloc(size, sizeof(*frequencies));
 
     /* Translate value so the minimum value is 0
        and count the number of occurencies of all values to initialize the 
        frequencies[] */
-    whole_map_iterate_filtered(ptile, data, filter) {
-      int_map[tile_index(ptile)] -= minval;
-      frequencies[int_map[tile_index(ptile)]]++;
-    } whole_map_iterate_filtered_end;
+    if (NULL == filter) {
+      for (i = 0; i < map_size; i++) {
+        int_map[i] -= minval;
+      }
+      for (i = 0; i < map_size; i++) {
+        frequencies[int_map[i]]++;
+      }
+    } else {
+      whole_map_iterate_filtered(ptile, data, filter) {
+        int_map[tile_index(ptile)] -= minval;
+        frequencies[int_map[tile_index(ptile)]]++;
+      } whole_map_iterate_filtered_end;
+    }
 
     /* create the linearize function as "incremental" frequencies */
     for(i =  0; i < size; i++) {
@@ -165,9 +194,17 @@ void adjust_int_map_filtered(int *int_map, int int_map_max, void *data,
     }
 
     /* apply the linearize function */
-    whole_map_iterate_filtered(ptile, data, filter) {
-      int_map[tile_index(ptile)] = frequencies[int_map[tile_index(ptile)]];
-    } whole_map_iterate_filtered_end;
+    if (NULL == filter) {
+      for (i = 0; i < map_size; i++) {
+        int_map[i] = frequencies[int_map[i]];
+      }
+    } else {
+      whole_map_iterate_filtered(ptile, data, filter) {
+        int_map[tile_index(ptile)] = frequencies[int_map[tile_index(ptile)]];
+      } whole_map_iterate_filtered_end;
+    }
+
+    free(frequencies);
   }
 }
 
@@ -180,6 +217,202 @@ bool is_normal_nat_pos(int x, int y)
   return is_normal_map_pos(x, y);
 }
 
+/* Below this many tiles, smoothing is done by the calling thread only. */
+#define SMOOTH_THREAD_MIN_TILES (128 * 128)
+/* Maximal number of worker threads for one smoothing pass. */
+#define SMOOTH_MAX_THREADS 4
+
+/* One horizontal band of rows [y0, y1) of a smoothing pass. */
+struct smooth_band {
+  const int *source;
+  int *target;
+  const float *weight;
+  bool x_axis;
+  bool zeroes_at_edges;
+  int y0, y1;
+};
+
+/****************************************************************************
+  Return the wrapped native coordinate 'pos' on an axis of length 'size',
+  or -1 if it does not exist.
+****************************************************************************/
+static inline int smooth_wrap(int pos, int size, bool wrap)
+{
+  if (wrap) {
+    return FC_WRAP(pos, size);
+  }
+  return (pos < 0 || pos >= size) ? -1 : pos;
+}
+
+/****************************************************************************
+  Smooth along the x axis the tile at native column 'x' of a row, checking
+  for wrapping and unreal neighbours.
+****************************************************************************/
+static void smooth_border_tile(const int *src, int *dst, int x,
+                               const float *weight, bool zeroes_at_edges)
+{
+  const bool wrapx = current_topo_has_flag(TF_WRAPX);
+  float N = 0, D = 0;
+  int i;
+
+  for (i = -2; i <= 2; i++) {
+    int nx = smooth_wrap(x + i, map.xsize, wrapx);
+
+    if (nx >= 0) {
+      D += weight[i + 2];
+      N += weight[i + 2] * src[nx];
+    }
+  }
+  if (zeroes_at_edges) {
+    D = 1;
+  }
+  dst[x] = (float)N / D;
+}
+
+/****************************************************************************
+  Smooth one band of rows along the native x or y axis.
+
+  Every target value depends on the source map only, and terms are summed
+  in the same order (-2 .. 2) as the generic axis_iterate() loop did, so
+  the result is bit-identical however the rows are split between threads.
+  The inner loops over interior tiles have no branches and are laid out
+  for auto-vectorization.
+****************************************************************************/
+static void smooth_int_map_band(void *arg)
+{
+  const struct smooth_band *band = arg;
+  const float *weight = band->weight;
+  const int xsize = map.xsize, ysize = map.ysize;
+  const bool wrapy = current_topo_has_flag(TF_WRAPY);
+  int x, y, i;
+
+  for (y = band->y0; y < band->y1; y++) {
+    const int *src = band->source + y * xsize;
+    int *dst = band->target + y * xsize;
+
+    if (band->x_axis) {
+      const int inner_end = xsize - 2;
+      float D = 0;
+
+      for (i = 0; i < 5; i++) {
+        D += weight[i];
+      }
+      if (band->zeroes_at_edges) {
+        D = 1;
+      }
+
+      for (x = 2; x < inner_end; x++) {
+        float N = 0;
+
+        N += weight[0] * src[x - 2];
+        N += weight[1] * src[x - 1];
+        N += weight[2] * src[x];
+        N += weight[3] * src[x + 1];
+        N += weight[4] * src[x + 2];
+        dst[x] = (float)N / D;
+      }
+
+      /* Border columns, where neighbours wrap or do not exist. */
+      for (x = 0; x < MIN(2, xsize); x++) {
+        smooth_border_tile(src, dst, x, weight, band->zeroes_at_edges);
+      }
+      for (x = MAX(2, inner_end); x < xsize; x++) {
+        smooth_border_tile(src, dst, x, weight, band->zeroes_at_edges);
+      }
+    } else {
+      const int *rows[5];
+      float D = 0;
+      bool complete = TRUE;
+
+      for (i = -2; i <= 2; i++) {
+        int ny = smooth_wrap(y + i, ysize, wrapy);
+
+        if (ny >= 0) {
+          rows[i + 2] = band->source + ny * xsize;
+          D += weight[i + 2];
+        } else {
+          rows[i + 2] = NULL;
+          complete = FALSE;
+        }
+      }
+      if (band->zeroes_at_edges) {
+        D = 1;
+      }
+
+      if (complete) {
+        const int *r0 = rows[0], *r1 = rows[1], *r2 = rows[2];
+        const int *r3 = rows[3], *r4 = rows[4];
+
+        for (x = 0; x < xsize; x++) {
+          float N = 0;
+
+          N += weight[0] * r0[x];
+          N += weight[1] * r1[x];
+          N += weight[2] * r2[x];
+          N += weight[3] * r3[x];
+          N += weight[4] * r4[x];
+          dst[x] = (float)N / D;
+        }
+      } else {
+        for (x = 0; x < xsize; x++) {
+          float N = 0;
+
+          for (i = 0; i < 5; i++) {
+            if (NULL != rows[i]) {
+              N += weight[i] * rows[i][x];
+            }
+          }
+          dst[x] = (float)N / D;
+        }
+      }
+    }
+  }
+}
+
+/****************************************************************************
+  Run one smoothing pass over the whole map, splitting the rows into bands
+  handled by worker threads on big maps.
+****************************************************************************/
+static void smooth_int_map_pass(const int *source, int *target,
+                                const float *weight, bool x_axis,
+                                bool zeroes_at_edges)
+{
+  struct smooth_band bands[SMOOTH_MAX_THREADS];
+  fc_thread threads[SMOOTH_MAX_THREADS];
+  bool started[SMOOTH_MAX_THREADS];
+  int nbands = 1, i;
+
+  if (MAP_INDEX_SIZE >= SMOOTH_THREAD_MIN_TILES) {
+    nbands = MIN(SMOOTH_MAX_THREADS, map.ysize);
+  }
+
+  for (i = 0; i < nbands; i++) {
+    bands[i].source = source;
+    bands[i].target = target;
+    bands[i].weight = weight;
+    bands[i].x_axis = x_axis;
+    bands[i].zeroes_at_edges = zeroes_at_edges;
+    bands[i].y0 = map.ysize * i / nbands;
+    bands[i].y1 = map.ysize * (i + 1) / nbands;
+  }
+
+  /* The calling thread handles the first band itself. */
+  for (i = 1; i < nbands; i++) {
+    started[i] = (0 == fc_thread_start(&threads[i], smooth_int_map_band,
+                                       &bands[i]));
+    if (!started[i]) {
+      /* Could not start a thread, do that band here. */
+      smooth_int_map_band(&bands[i]);
+    }
+  }
+  smooth_int_map_band(&bands[0]);
+  for (i = 1; i < nbands; i++) {
+    if (started[i]) {
+      fc_thread_wait(&threads[i]);
+    }
+  }
+}
+
 /*******************************************************************************
   Apply a Gaussian diffusion filter on the map. The size of the map is
   MAP_INDEX_SIZE and the map is indexed by native_pos_to_index function.
@@ -190,41 +423,17 @@ void smooth_int_map(int *int_map, bool zeroes_at_edges)
 {
   static const float weight_standard[5] = { 0.13, 0.19, 0.37, 0.19, 0.13 };
   static const float weight_isometric[5] = { 0.15, 0.21, 0.29, 0.21, 0.15 };
-  const float *weight;
-  bool axe = TRUE;
-  int *target_map, *source_map;
-  int *alt_int_map = fc_calloc(MAP_INDEX_SIZE, sizeof(*alt_int_map));
+  int *alt_int_map;
 
   fc_assert_ret(NULL != int_map);
 
-  weight = weight_standard;
-  target_map = alt_int_map;
-  source_map = int_map;
-
-  do {
-    whole_map_iterate(ptile) {
-      float N = 0, D = 0;
-
-      axis_iterate(ptile, pnear, i, 2, axe) {
-        D += weight[i + 2];
-        N += weight[i + 2] * source_map[tile_index(pnear)];
-      } axis_iterate_end;
-      if (zeroes_at_edges) {
-        D = 1;
-      }
-      target_map[tile_index(ptile)] = (float)N / D;
-    } whole_map_iterate_end;
-
-    if (MAP_IS_ISOMETRIC) {
-      weight = weight_isometric;
-    }
-
-    axe = !axe;
-
-    source_map = alt_int_map;
-    target_map = int_map;
+  alt_int_map = fc_malloc(MAP_INDEX_SIZE * sizeof(*alt_int_map));
 
-  } while (!axe);
+  smooth_int_map_pass(int_map, alt_int_map, weight_standard, TRUE,
+                      zeroes_at_edges);
+  smooth_int_map_pass(alt_int_map, int_map,
+                      MAP_IS_ISOMETRIC ? weight_isometric : weight_standard,
+                      FALSE, zeroes_at_edges);
 
   FC_FREE(alt_int_map);
 }
@@ -22,8 +22,10 @@
 #include "mem.h"
 #include "rand.h"
 #include "support.h"
+#include "timing.h"
 
 /* common */
+#include "ai.h"
 #include "base.h"
 #include "borders.h"
 #include "events.h"
@@ -578,6 +580,8 @@ void send_tile_info(struct conn_list *dest, struct tile *ptile,
   struct packet_tile_info info;
   const struct player *owner;
 
+  sanity_mark_tile(ptile);
+
   if (send_tile_suppressed) {
     return;
   }
@@ -588,12 +592,13 @@ void send_tile_info(struct conn_list *dest, struct tile *ptile,
 
   info.tile = tile_index(ptile);
 
-  if (ptile->spec_sprite) {
-    sz_strlcpy(info.spec_sprite, ptile->spec_sprite);
+  if (tile_spec_sprite(ptile)) {
+    sz_strlcpy(info.spec_sprite, tile_spec_sprite(ptile));
   } else {
     info.spec_sprite[0] = '\0';
   }
 
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     struct player *pplayer = pconn->playing;
 
@@ -623,8 +628,8 @@ void send_tile_info(struct conn_list *dest, struct tile *ptile,
       info.bases = ptile->bases;
       info.roads = ptile->roads;
 
-      if (ptile->label != NULL) {
-        strncpy(info.label, ptile->label, sizeof(info.label));
+      if (tile_label(ptile) != NULL) {
+        strncpy(info.label, tile_label(ptile), sizeof(info.label));
       } else {
         info.label[0] = '\0';
       }
@@ -658,8 +663,8 @@ void send_tile_info(struct conn_list *dest, struct tile *ptile,
       info.roads = plrtile->roads;
 
       /* Labels never change, so they are not subject to fog of war */
-      if (ptile->label != NULL) {
-        strncpy(info.label, ptile->label, sizeof(info.label));
+      if (tile_label(ptile) != NULL) {
+        strncpy(info.label, tile_label(ptile), sizeof(info.label));
       } else {
         info.label[0] = '\0';
       }
@@ -686,6 +691,7 @@ void send_tile_info(struct conn_list *dest, struct tile *ptile,
     }
   }
   conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 /****************************************************************************
@@ -959,6 +965,8 @@ void map_change_seen(struct player *pplayer,
   struct player_tile *plrtile = map_get_player_tile(ptile, pplayer);
   bool revealing_tile = FALSE;
 
+  sanity_mark_tile(ptile);
+
 #ifdef DEBUG
   log_debug("%s() for player %s (nb %d) at (%d, %d).",
             __FUNCTION__, player_name(pplayer), player_number(pplayer),
@@ -1261,6 +1269,7 @@ void remove_player_from_maps(struct player *pplayer)
       tile_set_owner(ptile, NULL, NULL);
       /* Update anyone who can see the tile (e.g. global observers) */
       send_tile_info(NULL, ptile, FALSE);
+      CALL_FUNC_EACH_AI(tile_changed, ptile);
     }
   } whole_map_iterate_end;
   conn_list_do_unbuffer(game.est_connections);
@@ -2022,6 +2031,8 @@ static void map_claim_border_ownership(struct tile *ptile,
       map_unit_homecity_enqueue(ptile);
     }
 
+    CALL_FUNC_EACH_AI(tile_changed, ptile);
+
     if (!city_map_update_tile_frozen(ptile)) {
       send_tile_info(NULL, ptile, FALSE);
     }
@@ -2267,9 +2278,11 @@ void map_claim_base(struct tile *ptile, struct base_type *pbase,
 ****************************************************************************/
 void vision_change_sight(struct vision *vision, const v_radius_t radius_sq)
 {
+  PROFILE_ZONE_START("vision");
   map_vision_update(vision->player, vision->tile, vision->radius_sq,
                     radius_sq, vision->can_reveal_tiles);
   memcpy(vision->radius_sq, radius_sq, sizeof(v_radius_t));
+  PROFILE_ZONE_STOP("vision");
 }
 
 /****************************************************************************
@@ -18,6 +18,10 @@
 #include <stdio.h>
 #include <string.h>
 
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>             /* sysconf() */
+#endif
+
 /* utility */
 #include "bitvector.h"
 #include "capability.h"
@@ -27,6 +31,7 @@
 #include "mem.h"
 #include "rand.h"
 #include "support.h"
+#include "timing.h"
 
 /* common */
 #include "events.h"
@@ -1452,6 +1457,243 @@ log_civ_score_disable:
   log_civ_score_free();
 }
 
+/* data needed for the performance log */
+struct logging_perf {
+  FILE *fp;
+  FILE *ai_fp;                  /* AI time of each player */
+  struct timer *step_timer;
+  struct timer *ai_timer;
+  double step[PERF_STEP_LAST];
+  double *ai;                   /* per player slot */
+  unsigned long counters[PERF_LAST]; /* perf_counters at the last line */
+};
+
+static struct logging_perf *perf_log = NULL;
+
+/**************************************************************************
+  Initialize the performance log.
+**************************************************************************/
+void log_perf_init(void)
+{
+  if (perf_log != NULL) {
+    return;
+  }
+
+  perf_log = fc_calloc(1, sizeof(*perf_log));
+  perf_log->fp = NULL;
+  perf_log->step_timer = timer_new(TIMER_USER, TIMER_ACTIVE);
+  perf_log->ai_timer = timer_new(TIMER_USER, TIMER_ACTIVE);
+  perf_log->ai = fc_calloc(player_slot_count(), sizeof(*perf_log->ai));
+  perf_counters_read(perf_log->counters);
+  perf_counters_enable(TRUE);
+}
+
+/**************************************************************************
+  Free resources allocated for the performance log.
+**************************************************************************/
+void log_perf_free(void)
+{
+  if (!perf_log) {
+    /* nothing to do */
+    return;
+  }
+
+  perf_counters_enable(FALSE);
+  if (perf_log->fp) {
+    fclose(perf_log->fp);
+  }
+  if (perf_log->ai_fp) {
+    fclose(perf_log->ai_fp);
+  }
+  timer_destroy(perf_log->step_timer);
+  timer_destroy(perf_log->ai_timer);
+  free(perf_log->ai);
+  free(perf_log);
+  perf_log = NULL;
+}
+
+/**************************************************************************
+  Start timing a server step for the performance log.
+**************************************************************************/
+void log_perf_step_start(enum perf_step step)
+{
+  if (perf_log) {
+    timer_clear(perf_log->step_timer);
+    timer_start(perf_log->step_timer);
+  }
+}
+
+/**************************************************************************
+  Stop timing a server step for the performance log.
+**************************************************************************/
+void log_perf_step_stop(enum perf_step step)
+{
+  if (perf_log) {
+    timer_stop(perf_log->step_timer);
+    perf_log->step[step] += timer_read_seconds(perf_log->step_timer);
+  }
+}
+
+/**************************************************************************
+  Start timing the AI of a player for the performance log.
+**************************************************************************/
+void log_perf_ai_start(const struct player *pplayer)
+{
+  if (perf_log) {
+    timer_clear(perf_log->ai_timer);
+    timer_start(perf_log->ai_timer);
+  }
+}
+
+/**************************************************************************
+  Stop timing the AI of a player for the performance log.
+**************************************************************************/
+void log_perf_ai_stop(const struct player *pplayer)
+{
+  if (perf_log) {
+    timer_stop(perf_log->ai_timer);
+    perf_log->ai[player_index(pplayer)]
+      += timer_read_seconds(perf_log->ai_timer);
+  }
+}
+
+/**************************************************************************
+  Returns the resident set size of the server in kB, or -1 if unknown.
+**************************************************************************/
+static long perf_rss_kb(void)
+{
+  long rss = -1;
+#if defined(HAVE_UNISTD_H) && defined(_SC_PAGESIZE)
+  FILE *fp = fc_fopen("/proc/self/statm", "r");
+
+  if (fp) {
+    long size, pages;
+
+    if (fscanf(fp, "%ld %ld", &size, &pages) == 2) {
+      rss = pages * (sysconf(_SC_PAGESIZE) / 1024);
+    }
+    fclose(fp);
+  }
+#endif /* HAVE_UNISTD_H && _SC_PAGESIZE */
+
+  return rss;
+}
+
+/**************************************************************************
+  Open the file of the performance log called 'filename' for appending,
+  and write the 'header' line if the file is new. Returns NULL on error.
+**************************************************************************/
+static FILE *perf_log_open(const char *filename, const char *header)
+{
+  FILE *fp = fc_fopen(filename, "a");
+
+  if (!fp) {
+    log_error("Can't open perflog file '%s' for appending!", filename);
+    return NULL;
+  }
+  if (ftell(fp) == 0) {
+    fprintf(fp, "%s\n", header);
+  }
+
+  return fp;
+}
+
+/**************************************************************************
+  Append the line of 'turn' to the performance log, and start counting
+  the next one. The log is a CSV file with one line per turn; a header
+  line names the columns. The AI time of each player is appended to a
+  second CSV file, with one line per turn and AI player. Its name is
+  the one of the log with "-ai" inserted before the extension.
+**************************************************************************/
+void log_perf_now(int turn)
+{
+  static const char *step_names[] = {
+    "begin_turn", "begin_phase", "sniff", "end_phase", "end_turn"
+  };
+  static const char *counter_names[] = {
+    "allocs", "cm_queries", "cm_cache_hits", "pf_maps", "packets", "packet_bytes"
+  };
+  unsigned long counters[PERF_LAST];
+  double ai_total = 0.0;
+  long rss;
+  int i;
+
+  FC_STATIC_ASSERT(ARRAY_SIZE(step_names) == PERF_STEP_LAST,
+                   perf_step_names_mismatch);
+  FC_STATIC_ASSERT(ARRAY_SIZE(counter_names) == PERF_LAST,
+                   perf_counter_names_mismatch);
+
+  if (!game.server.perflog || !perf_log) {
+    return;
+  }
+
+  if (!perf_log->fp) {
+    char header[512];
+    char ai_file[MAX_LEN_PATH];
+    const char *ext = strrchr(game.server.perffile, '.');
+
+    sz_strlcpy(header, "game,turn");
+    for (i = 0; i < PERF_STEP_LAST; i++) {
+      cat_snprintf(header, sizeof(header), ",%s", step_names[i]);
+    }
+    sz_strlcat(header, ",ai");
+    for (i = 0; i < PERF_LAST; i++) {
+      cat_snprintf(header, sizeof(header), ",%s", counter_names[i]);
+    }
+    sz_strlcat(header, ",rss_kb");
+
+    if (NULL != ext && NULL == strchr(ext, '/')) {
+      fc_snprintf(ai_file, sizeof(ai_file), "%.*s-ai%s",
+                  (int) (ext - game.server.perffile), game.server.perffile,
+                  ext);
+    } else {
+      fc_snprintf(ai_file, sizeof(ai_file), "%s-ai", game.server.perffile);
+    }
+
+    perf_log->fp = perf_log_open(game.server.perffile, header);
+    perf_log->ai_fp = perf_log_open(ai_file, "game,turn,player,ai");
+    if (!perf_log->fp || !perf_log->ai_fp) {
+      log_perf_free();
+      return;
+    }
+  }
+
+  players_iterate(pplayer) {
+    ai_total += perf_log->ai[player_index(pplayer)];
+  } players_iterate_end;
+
+  fprintf(perf_log->fp, "%s,%d", server.game_identifier, turn);
+  for (i = 0; i < PERF_STEP_LAST; i++) {
+    fprintf(perf_log->fp, ",%.6f", perf_log->step[i]);
+    perf_log->step[i] = 0.0;
+  }
+  fprintf(perf_log->fp, ",%.6f", ai_total);
+  perf_counters_read(counters);
+  for (i = 0; i < PERF_LAST; i++) {
+    fprintf(perf_log->fp, ",%lu", counters[i] - perf_log->counters[i]);
+    perf_log->counters[i] = counters[i];
+  }
+
+  rss = perf_rss_kb();
+  if (rss >= 0) {
+    fprintf(perf_log->fp, ",%ld\n", rss);
+  } else {
+    fprintf(perf_log->fp, ",\n");
+  }
+  fflush(perf_log->fp);
+
+  players_iterate(pplayer) {
+    double *ai = perf_log->ai + player_index(pplayer);
+
+    if (*ai > 0.0) {
+      fprintf(perf_log->ai_fp, "%s,%d,%d,%.6f\n", server.game_identifier,
+              turn, player_number(pplayer), *ai);
+    }
+  } players_iterate_end;
+  memset(perf_log->ai, 0, player_slot_count() * sizeof(*perf_log->ai));
+  fflush(perf_log->ai_fp);
+}
+
 /**************************************************************************
   Produce random history report if it's time for one.
 **************************************************************************/
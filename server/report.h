@@ -25,6 +25,26 @@ void log_civ_score_init(void);
 void log_civ_score_free(void);
 void log_civ_score_now(void);
 
+/* Server steps timed by the performance log. */
+enum perf_step {
+  PERF_STEP_BEGIN_TURN,
+  PERF_STEP_BEGIN_PHASE,
+  PERF_STEP_SNIFF,
+  PERF_STEP_END_PHASE,
+  PERF_STEP_END_TURN,
+  PERF_STEP_LAST
+};
+
+struct player;
+
+void log_perf_init(void);
+void log_perf_free(void);
+void log_perf_step_start(enum perf_step step);
+void log_perf_step_stop(enum perf_step step);
+void log_perf_ai_start(const struct player *pplayer);
+void log_perf_ai_stop(const struct player *pplayer);
+void log_perf_now(int turn);
+
 void make_history_report(void);
 void report_wonders_of_the_world(struct conn_list *dest);
 void report_top_five_cities(struct conn_list *dest);
@@ -70,17 +70,48 @@
     }                                                                       \
   } while(0)
 
+/* Identity numbers of units and cities, see identity_number(). */
+BV_DEFINE(bv_sanity_ids, 1 + MAX_UINT16);
+
+/* What changed since the last sanity check, for the incremental checks
+ * of sanity_check_changed(). The tile set is only valid while it has the
+ * size of the current map; it is (re)sized by every full check, and
+ * freed with the game by sanity_check_free(). */
+static struct {
+  struct dbv tiles;
+  bv_sanity_ids units;
+  bv_sanity_ids cities;
+  int full_check_turn;          /* Turn of the last full check */
+} dirty;
+
+/* Is the tile of 'ptile' to be checked, according to the tile set
+ * 'ptiles' (NULL for all tiles)? */
+#define SANITY_TILE_WANTED(ptiles, ptile)                                   \
+  (NULL == (ptiles) || dbv_isset((ptiles), tile_index(ptile)))
+
+/* Same for units and cities, with an identity number set. */
+#define SANITY_ID_WANTED(pids, id)                                          \
+  (NULL == (pids) || BV_ISSET(*(pids), (id)))
+
 static void check_city_feelings(const struct city *pcity, const char *file,
                                 const char *function, int line);
 
 /**************************************************************************
   Sanity checking on map (tile) specials.
 **************************************************************************/
-static void check_specials(const char *file, const char *function, int line)
+static void check_specials(const struct dbv *ptiles, const char *file,
+                           const char *function, int line)
 {
   whole_map_iterate(ptile) {
-    const struct terrain *pterrain = tile_terrain(ptile);
-    bv_special special = tile_specials(ptile);
+    const struct terrain *pterrain;
+    bv_special special;
+
+    if (!SANITY_TILE_WANTED(ptiles, ptile)) {
+      continue;
+    }
+
+    pterrain = tile_terrain(ptile);
+    special = tile_specials(ptile);
 
     if (contains_special(special, S_FARMLAND)) {
       SANITY_TILE(ptile, contains_special(special, S_IRRIGATION));
@@ -101,7 +132,8 @@ static void check_specials(const char *file, const char *function, int line)
 /**************************************************************************
   Sanity checking on fog-of-war (visibility, shared vision, etc.).
 **************************************************************************/
-static void check_fow(const char *file, const char *function, int line)
+static void check_fow(const struct dbv *ptiles, const char *file,
+                      const char *function, int line)
 {
   if (!game_was_started()) {
     /* The private map of the players is only allocated at game start. */
@@ -109,6 +141,10 @@ static void check_fow(const char *file, const char *function, int line)
   }
 
   whole_map_iterate(ptile) {
+    if (!SANITY_TILE_WANTED(ptiles, ptile)) {
+      continue;
+    }
+
     players_iterate(pplayer) {
       struct player_tile *plr_tile = map_get_player_tile(ptile, pplayer);
 
@@ -160,11 +196,22 @@ static void check_misc(const char *file, const char *function, int line)
 /**************************************************************************
   Sanity checks on the map itself.  See also check_specials.
 **************************************************************************/
-static void check_map(const char *file, const char *function, int line)
+static void check_map(const struct dbv *ptiles, const char *file,
+                      const char *function, int line)
 {
+  /* Units must only be added to map tiles by tile_add_unit(). */
+  SANITY_CHECK(0 == unit_list_size(tile_units_empty()));
+
   whole_map_iterate(ptile) {
-    struct city *pcity = tile_city(ptile);
-    int cont = tile_continent(ptile);
+    struct city *pcity;
+    int cont;
+
+    if (!SANITY_TILE_WANTED(ptiles, ptile)) {
+      continue;
+    }
+
+    pcity = tile_city(ptile);
+    cont = tile_continent(ptile);
 
     CHECK_INDEX(tile_index(ptile));
 
@@ -329,12 +376,18 @@ void real_sanity_check_city(struct city *pcity, const char *file,
 }
 
 /**************************************************************************
-  Sanity checks on all cities in the world.
+  Sanity checks on the cities in the set 'pids' (NULL for all cities in
+  the world).
 **************************************************************************/
-static void check_cities(const char *file, const char *function, int line)
+static void check_cities(const bv_sanity_ids *pids, const char *file,
+                         const char *function, int line)
 {
   players_iterate(pplayer) {
     city_list_iterate(pplayer->cities, pcity) {
+      if (!SANITY_ID_WANTED(pids, pcity->id)) {
+        continue;
+      }
+
       SANITY_CITY(pcity, city_owner(pcity) == pplayer);
 
       real_sanity_check_city(pcity, file, function, line);
@@ -343,9 +396,11 @@ static void check_cities(const char *file, const char *function, int line)
 }
 
 /**************************************************************************
-  Sanity checks on all units in the world.
+  Sanity checks on the units in the set 'pids' (NULL for all units in the
+  world).
 **************************************************************************/
-static void check_units(const char *file, const char *function, int line)
+static void check_units(const bv_sanity_ids *pids, const char *file,
+                        const char *function, int line)
 {
   players_iterate(pplayer) {
     unit_list_iterate(pplayer->units, punit) {
@@ -354,6 +409,10 @@ static void check_units(const char *file, const char *function, int line)
       struct city *phome;
       struct unit *ptrans = unit_transport_get(punit);
 
+      if (!SANITY_ID_WANTED(pids, punit->id)) {
+        continue;
+      }
+
       SANITY_CHECK(unit_owner(punit) == pplayer);
 
       if (IDENTITY_NUMBER_ZERO != punit->homecity) {
@@ -575,18 +634,103 @@ void real_sanity_check(const char *file, const char *function, int line)
   if (!map_is_empty()) {
     /* Don't sanity-check the map if it hasn't been created yet (this
      * happens when loading scenarios). */
-    check_specials(file, function, line);
-    check_map(file, function, line);
-    check_cities(file, function, line);
-    check_units(file, function, line);
-    check_fow(file, function, line);
+    check_specials(NULL, file, function, line);
+    check_map(NULL, file, function, line);
+    check_cities(NULL, file, function, line);
+    check_units(NULL, file, function, line);
+    check_fow(NULL, file, function, line);
+
+    /* Start tracking the changes from here. */
+    dbv_resize(&dirty.tiles, MAP_INDEX_SIZE);
   }
+  BV_CLR_ALL(dirty.units);
+  BV_CLR_ALL(dirty.cities);
+  dirty.full_check_turn = game.info.turn;
+
   check_misc(file, function, line);
   check_players(file, function, line);
   check_teams(file, function, line);
   check_connections(file, function, line);
 }
 
+/**************************************************************************
+  Like real_sanity_check(), but with --checkturns only check the tiles,
+  units and cities which changed since the last check, as marked by
+  sanity_mark_tile(), sanity_mark_unit() and sanity_mark_city(). The
+  whole world is still checked every --checkturns turns, which catches
+  the changes that were not marked.
+
+  The checks of the players, teams and connections are always done, they
+  don't depend on the size of the world.
+**************************************************************************/
+void real_sanity_check_changed(const char *file, const char *function,
+                               int line)
+{
+  if (0 >= srvarg.sanity_check_turns
+      || map_is_empty()
+      || dbv_bits(&dirty.tiles) != MAP_INDEX_SIZE
+      || game.info.turn < dirty.full_check_turn
+      || game.info.turn >= dirty.full_check_turn
+                           + srvarg.sanity_check_turns) {
+    real_sanity_check(file, function, line);
+    return;
+  }
+
+  check_specials(&dirty.tiles, file, function, line);
+  check_map(&dirty.tiles, file, function, line);
+  check_cities(&dirty.cities, file, function, line);
+  check_units(&dirty.units, file, function, line);
+  check_fow(&dirty.tiles, file, function, line);
+
+  dbv_clr_all(&dirty.tiles);
+  BV_CLR_ALL(dirty.units);
+  BV_CLR_ALL(dirty.cities);
+
+  check_misc(file, function, line);
+  check_players(file, function, line);
+  check_teams(file, function, line);
+  check_connections(file, function, line);
+}
+
+/**************************************************************************
+  Note that the tile changed, for sanity_check_changed().
+**************************************************************************/
+void sanity_mark_tile(const struct tile *ptile)
+{
+  if (0 < srvarg.sanity_check_turns
+      && tile_index(ptile) < dbv_bits(&dirty.tiles)) {
+    dbv_set(&dirty.tiles, tile_index(ptile));
+  }
+}
+
+/**************************************************************************
+  Note that the unit changed, for sanity_check_changed(). Its tile is
+  marked too.
+**************************************************************************/
+void sanity_mark_unit(const struct unit *punit)
+{
+  if (0 < srvarg.sanity_check_turns) {
+    BV_SET(dirty.units, punit->id);
+    if (NULL != unit_tile(punit)) {
+      sanity_mark_tile(unit_tile(punit));
+    }
+  }
+}
+
+/**************************************************************************
+  Note that the city changed, for sanity_check_changed(). Its tile is
+  marked too.
+**************************************************************************/
+void sanity_mark_city(const struct city *pcity)
+{
+  if (0 < srvarg.sanity_check_turns) {
+    BV_SET(dirty.cities, pcity->id);
+    if (NULL != city_tile(pcity)) {
+      sanity_mark_tile(city_tile(pcity));
+    }
+  }
+}
+
 /*****************************************************************************
   Verify that the tile has sane values. This should be called after the
   terrain is changed.
@@ -609,4 +753,17 @@ void real_sanity_check_tile(struct tile *ptile, const char *file,
   } unit_list_iterate_end;
 }
 
+/**************************************************************************
+  Free the record of the changes since the last check. The next
+  sanity_check_changed() does a full check, which records the changes
+  for the size of the map it finds.
+**************************************************************************/
+void sanity_check_free(void)
+{
+  dbv_free(&dirty.tiles);
+  BV_CLR_ALL(dirty.units);
+  BV_CLR_ALL(dirty.cities);
+  dirty.full_check_turn = 0;
+}
+
 #endif /* SANITY_CHECKING */
@@ -36,11 +36,27 @@ void real_sanity_check_tile(struct tile *ptile, const char *file,
   real_sanity_check(__FILE__, __FUNCTION__, __FC_LINE__)
 void real_sanity_check( const char *file, const char *function, int line);
 
+#  define sanity_check_changed() \
+  real_sanity_check_changed(__FILE__, __FUNCTION__, __FC_LINE__)
+void real_sanity_check_changed(const char *file, const char *function,
+                               int line);
+
+void sanity_mark_tile(const struct tile *ptile);
+void sanity_mark_unit(const struct unit *punit);
+void sanity_mark_city(const struct city *pcity);
+
+void sanity_check_free(void);
+
 #else /* SANITY_CHECKING */
 
 #  define sanity_check_city(x) (void)0
 #  define sanity_check_tile(x) (void)0
 #  define sanity_check() (void)0
+#  define sanity_check_changed() (void)0
+#  define sanity_mark_tile(x) (void)0
+#  define sanity_mark_unit(x) (void)0
+#  define sanity_mark_city(x) (void)0
+#  define sanity_check_free() (void)0
 
 #endif /* SANITY_CHECKING */
 
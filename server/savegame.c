@@ -680,8 +680,8 @@ static void map_load_tiles(struct section_file *file)
     label = secfile_lookup_str_default(file, NULL, "map.label_%d_%d", nat_x,
                                        nat_y);
 
-    if (NULL != ptile->spec_sprite) {
-      ptile->spec_sprite = fc_strdup(spec_sprite);
+    if (NULL != tile_spec_sprite(ptile)) {
+      tile_set_spec_sprite(ptile, spec_sprite);
     }
     if (label != NULL) {
       tile_set_label(ptile, label);
@@ -1837,7 +1837,7 @@ static void player_load_units(struct player *plr, int plrno,
 
     unit_list_append(plr->units, punit);
 
-    unit_list_prepend(ptile->units, punit);
+    tile_add_unit(ptile, punit);
 
     /* Claim ownership of fortress? */
     if ((!base_owner(ptile)
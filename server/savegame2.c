@@ -2604,8 +2604,8 @@ static void sg_load_map_tiles(struct loaddata *loading)
                                      nat_x, nat_y);
     label = secfile_lookup_str_default(loading->file, NULL, "map.label_%d_%d",
                                        nat_x, nat_y);
-    if (NULL != ptile->spec_sprite) {
-      ptile->spec_sprite = fc_strdup(spec_sprite);
+    if (NULL != tile_spec_sprite(ptile)) {
+      tile_set_spec_sprite(ptile, spec_sprite);
     }
     if (label != NULL) {
       tile_set_label(ptile, label);
@@ -2630,12 +2630,12 @@ static void sg_save_map_tiles(struct savedata *saving)
     int nat_x, nat_y;
 
     index_to_native_pos(&nat_x, &nat_y, tile_index(ptile));
-    if (ptile->spec_sprite) {
-      secfile_insert_str(saving->file, ptile->spec_sprite,
+    if (tile_spec_sprite(ptile)) {
+      secfile_insert_str(saving->file, tile_spec_sprite(ptile),
                          "map.spec_sprite_%d_%d", nat_x, nat_y);
     }
-    if (ptile->label != NULL) {
-      secfile_insert_str(saving->file, ptile->label,
+    if (tile_label(ptile) != NULL) {
+      secfile_insert_str(saving->file, tile_label(ptile),
                          "map.label_%d_%d", nat_x, nat_y);
     }
   } whole_map_iterate_end;
@@ -4865,7 +4865,7 @@ static void sg_load_player_units(struct loaddata *loading,
      * automatically reveal that tile. */
 
     unit_list_append(plr->units, punit);
-    unit_list_prepend(unit_tile(punit)->units, punit);
+    tile_add_unit(unit_tile(punit), punit);
 
     /* Claim ownership of fortress? */
     if ((!base_owner(ptile)
@@ -61,6 +61,11 @@ static struct fc_lua *fcl = NULL;
 *****************************************************************************/
 static char *script_server_code = NULL;
 
+/*****************************************************************************
+  Ids of the server signals in the Lua state.
+*****************************************************************************/
+static int script_server_signal_ids[SIGNAL_COUNT];
+
 static void script_server_vars_init(void);
 static void script_server_vars_free(void);
 static void script_server_vars_load(struct section_file *file);
@@ -298,73 +303,118 @@ void script_server_state_save(struct section_file *file)
 }
 
 /*****************************************************************************
-  Invoke all the callback functions attached to a given signal.
+  Returns whether any callback is connected to the signal.
+*****************************************************************************/
+bool script_server_signal_connected(enum script_signal sig)
+{
+  return luascript_signal_connected(fcl, script_server_signal_ids[sig]);
+}
+
+/*****************************************************************************
+  Invoke all the callback functions attached to a given signal. Use
+  script_server_signal_emit().
 *****************************************************************************/
-void script_server_signal_emit(const char *signal_name, int nargs, ...)
+void real_script_server_signal_emit(enum script_signal sig, int nargs, ...)
 {
   va_list args;
 
   va_start(args, nargs);
-  luascript_signal_emit_valist(fcl, signal_name, nargs, args);
+  luascript_signal_emit_by_id_valist(fcl, script_server_signal_ids[sig],
+                                     nargs, args);
   va_end(args);
 }
 
+/*****************************************************************************
+  Report the time spent in the signal callbacks to 'caller'.
+*****************************************************************************/
+void script_server_signal_profile(struct connection *caller)
+{
+  struct connection *save_caller;
+  luascript_log_func_t save_output_fct;
+
+  save_caller = fcl->caller;
+  save_output_fct = fcl->output_fct;
+  fcl->output_fct = script_server_cmd_reply;
+  fcl->caller = caller;
+
+  luascript_signal_profile_report(fcl);
+
+  fcl->caller = save_caller;
+  fcl->output_fct = save_output_fct;
+}
+
 /*****************************************************************************
   Declare any new signal types you need here.
 *****************************************************************************/
 static void script_server_signal_create(void)
 {
-  luascript_signal_create(fcl, "turn_started", 2,
-                          API_TYPE_INT, API_TYPE_INT);
-  luascript_signal_create(fcl, "unit_moved", 3,
-                          API_TYPE_UNIT, API_TYPE_TILE, API_TYPE_TILE);
+  script_server_signal_ids[SIGNAL_TURN_STARTED]
+    = luascript_signal_create(fcl, "turn_started", 2,
+                              API_TYPE_INT, API_TYPE_INT);
+  script_server_signal_ids[SIGNAL_UNIT_MOVED]
+    = luascript_signal_create(fcl, "unit_moved", 3,
+                              API_TYPE_UNIT, API_TYPE_TILE, API_TYPE_TILE);
 
   /* Includes all newly-built cities. */
-  luascript_signal_create(fcl, "city_built", 1,
-                          API_TYPE_CITY);
+  script_server_signal_ids[SIGNAL_CITY_BUILT]
+    = luascript_signal_create(fcl, "city_built", 1,
+                              API_TYPE_CITY);
 
-  luascript_signal_create(fcl, "city_growth", 2,
-                          API_TYPE_CITY, API_TYPE_INT);
+  script_server_signal_ids[SIGNAL_CITY_GROWTH]
+    = luascript_signal_create(fcl, "city_growth", 2,
+                              API_TYPE_CITY, API_TYPE_INT);
 
   /* Only includes units built in cities, for now. */
-  luascript_signal_create(fcl, "unit_built", 2,
-                          API_TYPE_UNIT, API_TYPE_CITY);
-  luascript_signal_create(fcl, "building_built", 2,
-                          API_TYPE_BUILDING_TYPE, API_TYPE_CITY);
+  script_server_signal_ids[SIGNAL_UNIT_BUILT]
+    = luascript_signal_create(fcl, "unit_built", 2,
+                              API_TYPE_UNIT, API_TYPE_CITY);
+  script_server_signal_ids[SIGNAL_BUILDING_BUILT]
+    = luascript_signal_create(fcl, "building_built", 2,
+                              API_TYPE_BUILDING_TYPE, API_TYPE_CITY);
 
   /* These can happen for various reasons; the third argument gives the
    * reason (a simple string identifier).  Example identifiers:
    * "pop_cost", "need_tech", "need_building", "need_special",
    * "need_terrain", "need_government", "need_nation", "never",
    * "unavailable". */
-  luascript_signal_create(fcl, "unit_cant_be_built", 3,
-                          API_TYPE_UNIT_TYPE, API_TYPE_CITY, API_TYPE_STRING);
-  luascript_signal_create(fcl, "building_cant_be_built", 3,
-                          API_TYPE_BUILDING_TYPE, API_TYPE_CITY,
-                          API_TYPE_STRING);
+  script_server_signal_ids[SIGNAL_UNIT_CANT_BE_BUILT]
+    = luascript_signal_create(fcl, "unit_cant_be_built", 3,
+                              API_TYPE_UNIT_TYPE, API_TYPE_CITY,
+                              API_TYPE_STRING);
+  script_server_signal_ids[SIGNAL_BUILDING_CANT_BE_BUILT]
+    = luascript_signal_create(fcl, "building_cant_be_built", 3,
+                              API_TYPE_BUILDING_TYPE, API_TYPE_CITY,
+                              API_TYPE_STRING);
 
   /* The third argument contains the source: "researched", "traded",
    * "stolen", "hut". */
-  luascript_signal_create(fcl, "tech_researched", 3,
-                          API_TYPE_TECH_TYPE, API_TYPE_PLAYER,
-                          API_TYPE_STRING);
+  script_server_signal_ids[SIGNAL_TECH_RESEARCHED]
+    = luascript_signal_create(fcl, "tech_researched", 3,
+                              API_TYPE_TECH_TYPE, API_TYPE_PLAYER,
+                              API_TYPE_STRING);
 
   /* First player is city owner, second is enemy. */
-  luascript_signal_create(fcl, "city_destroyed", 3,
-                          API_TYPE_CITY, API_TYPE_PLAYER, API_TYPE_PLAYER);
-  luascript_signal_create(fcl, "city_lost", 3,
-                          API_TYPE_CITY, API_TYPE_PLAYER, API_TYPE_PLAYER);
-
-  luascript_signal_create(fcl, "hut_enter", 1,
-                          API_TYPE_UNIT);
-
-  luascript_signal_create(fcl, "unit_lost", 3,
-                          API_TYPE_UNIT, API_TYPE_PLAYER, API_TYPE_STRING);
-
-  luascript_signal_create(fcl, "disaster", 2,
-                          API_TYPE_DISASTER, API_TYPE_CITY);
-
-  luascript_signal_create(fcl, "map_generated", 0);
+  script_server_signal_ids[SIGNAL_CITY_DESTROYED]
+    = luascript_signal_create(fcl, "city_destroyed", 3,
+                              API_TYPE_CITY, API_TYPE_PLAYER, API_TYPE_PLAYER);
+  script_server_signal_ids[SIGNAL_CITY_LOST]
+    = luascript_signal_create(fcl, "city_lost", 3,
+                              API_TYPE_CITY, API_TYPE_PLAYER, API_TYPE_PLAYER);
+
+  script_server_signal_ids[SIGNAL_HUT_ENTER]
+    = luascript_signal_create(fcl, "hut_enter", 1,
+                              API_TYPE_UNIT);
+
+  script_server_signal_ids[SIGNAL_UNIT_LOST]
+    = luascript_signal_create(fcl, "unit_lost", 3,
+                              API_TYPE_UNIT, API_TYPE_PLAYER, API_TYPE_STRING);
+
+  script_server_signal_ids[SIGNAL_DISASTER]
+    = luascript_signal_create(fcl, "disaster", 2,
+                              API_TYPE_DISASTER, API_TYPE_CITY);
+
+  script_server_signal_ids[SIGNAL_MAP_GENERATED]
+    = luascript_signal_create(fcl, "map_generated", 0);
 }
 
 /*****************************************************************************
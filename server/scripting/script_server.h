@@ -39,8 +39,38 @@ bool script_server_do_file(struct connection *caller, const char *filename);
 void script_server_state_load(struct section_file *file);
 void script_server_state_save(struct section_file *file);
 
-/* Signals. */
-void script_server_signal_emit(const char *signal_name, int nargs, ...);
+/* Signals emitted by the server, see script_server_signal_create(). */
+enum script_signal {
+  SIGNAL_TURN_STARTED,
+  SIGNAL_UNIT_MOVED,
+  SIGNAL_CITY_BUILT,
+  SIGNAL_CITY_GROWTH,
+  SIGNAL_UNIT_BUILT,
+  SIGNAL_BUILDING_BUILT,
+  SIGNAL_UNIT_CANT_BE_BUILT,
+  SIGNAL_BUILDING_CANT_BE_BUILT,
+  SIGNAL_TECH_RESEARCHED,
+  SIGNAL_CITY_DESTROYED,
+  SIGNAL_CITY_LOST,
+  SIGNAL_HUT_ENTER,
+  SIGNAL_UNIT_LOST,
+  SIGNAL_DISASTER,
+  SIGNAL_MAP_GENERATED,
+  SIGNAL_COUNT
+};
+
+/* Signals. Nothing is done, not even the evaluation of the arguments, if
+ * no callback is connected to the signal. */
+#define script_server_signal_emit(sig, nargs, ...)                          \
+  do {                                                                      \
+    if (script_server_signal_connected(sig)) {                              \
+      real_script_server_signal_emit(sig, nargs, ## __VA_ARGS__);           \
+    }                                                                       \
+  } while (FALSE)
+
+bool script_server_signal_connected(enum script_signal sig);
+void real_script_server_signal_emit(enum script_signal sig, int nargs, ...);
+void script_server_signal_profile(struct connection *caller);
 
 /* Functions */
 bool script_server_call(const char *func_name, int nargs, ...);
@@ -108,6 +108,12 @@ static int listen_count;
 static int socklan;
 #endif
 
+/* Sockets to wait on in server_sniff_all_input() and flush_packets(),
+ * kept between calls to reuse their memory. They are separate since
+ * flush_packets() may be called while handling the sniffed input. */
+static struct fc_sockwait *sniff_wait = NULL;
+static struct fc_sockwait *flush_wait = NULL;
+
 #if defined(__VMS)
 #  if defined(_VAX_)
 #    define lib$stop LIB$STOP
@@ -248,12 +254,18 @@ void close_connections_and_socket(void)
   /* Remove the game connection lists and make sure they are empty. */
   conn_list_destroy(game.all_connections);
   conn_list_destroy(game.est_connections);
+  packet_compression_free();
 
   for (i = 0; i < listen_count; i++) {
     fc_closesocket(listen_socks[i]);
   }
   FC_FREE(listen_socks);
 
+  fc_sockwait_destroy(sniff_wait);
+  sniff_wait = NULL;
+  fc_sockwait_destroy(flush_wait);
+  flush_wait = NULL;
+
   if (srvarg.announce != ANNOUNCE_NONE) {
     fc_closesocket(socklan);
   }
@@ -352,24 +364,26 @@ static void cut_lagging_connection(struct connection *pconn)
 void flush_packets(void)
 {
   int i;
-  int max_desc;
-  fd_set writefs, exceptfs;
-  fc_timeval tv;
+  bool pending;
+  int timeout;
   time_t start;
 
   (void) time(&start);
 
+  if (NULL == flush_wait) {
+    flush_wait = fc_sockwait_new();
+  }
+
   for(;;) {
-    tv.tv_sec = (game.server.netwait - (time(NULL) - start));
-    tv.tv_usec = 0;
+    timeout = (game.server.netwait - (time(NULL) - start));
 
-    if (tv.tv_sec < 0) {
+    if (timeout < 0) {
       return;
     }
 
-    FC_FD_ZERO(&writefs);
-    FC_FD_ZERO(&exceptfs);
-    max_desc = -1;
+    /* Only the connections with pending output are waited on. */
+    fc_sockwait_clear(flush_wait);
+    pending = FALSE;
 
     for (i = 0; i < MAX_NUM_CONNECTIONS; i++) {
       struct connection *pconn = &connections[i];
@@ -377,17 +391,17 @@ void flush_packets(void)
       if (pconn->used
           && !pconn->server.is_closing
           && 0 < pconn->send_buffer->ndata) {
-	FD_SET(pconn->sock, &writefs);
-	FD_SET(pconn->sock, &exceptfs);
-	max_desc = MAX(pconn->sock, max_desc);
+        fc_sockwait_add(flush_wait, pconn->sock,
+                        FC_SW_WRITE | FC_SW_EXCEPT);
+        pending = TRUE;
       }
     }
 
-    if (max_desc == -1) {
+    if (!pending) {
       return;
     }
 
-    if (fc_select(max_desc + 1, NULL, &writefs, &exceptfs, &tv) <= 0) {
+    if (fc_sockwait_run(flush_wait, timeout * 1000) <= 0) {
       return;
     }
 
@@ -395,13 +409,13 @@ void flush_packets(void)
       struct connection *pconn = &connections[i];
 
       if (pconn->used && !pconn->server.is_closing) {
-        if (FD_ISSET(pconn->sock, &exceptfs)) {
+        if (fc_sockwait_isset(flush_wait, pconn->sock, FC_SW_EXCEPT)) {
           log_verbose("connection (%s) cut due to exception data",
                       conn_description(pconn));
           connection_close_server(pconn, _("network exception"));
         } else {
 	  if(pconn->send_buffer && pconn->send_buffer->ndata > 0) {
-	    if(FD_ISSET(pconn->sock, &writefs)) {
+	    if (fc_sockwait_isset(flush_wait, pconn->sock, FC_SW_WRITE)) {
 	      flush_connection_send_buffer_all(pconn);
 	    } else {
 	      cut_lagging_connection(pconn);
@@ -495,10 +509,7 @@ functions.  That is, other functions should not need to do so.  --dwp
 enum server_events server_sniff_all_input(void)
 {
   int i, s;
-  int max_desc;
   bool excepting;
-  fd_set readfs, writefs, exceptfs;
-  fc_timeval tv;
 #ifdef SOCKET_ZERO_ISNT_STDIN
   char *bufptr;    
 #endif
@@ -646,53 +657,47 @@ enum server_events server_sniff_all_input(void)
       return S_E_END_OF_TURN_TIMEOUT;
     }
 
-    tv.tv_sec = 1;
-    tv.tv_usec = 0;
-
-    FC_FD_ZERO(&readfs);
-    FC_FD_ZERO(&writefs);
-    FC_FD_ZERO(&exceptfs);
+    if (NULL == sniff_wait) {
+      sniff_wait = fc_sockwait_new();
+    }
+    fc_sockwait_clear(sniff_wait);
 
     if (!no_input) {
 #ifdef SOCKET_ZERO_ISNT_STDIN
       fc_init_console();
 #else /* SOCKET_ZERO_ISNT_STDIN */
 #   if !defined(__VMS)
-      FD_SET(0, &readfs);
+      fc_sockwait_add(sniff_wait, 0, FC_SW_READ);
 #   endif /* VMS */	
 #endif /* SOCKET_ZERO_ISNT_STDIN */
     }
 
-    max_desc = 0;
     for (i = 0; i < listen_count; i++) {
-      FD_SET(listen_socks[i], &readfs);
-      FD_SET(listen_socks[i], &exceptfs);
-      max_desc = MAX(max_desc, listen_socks[i]);
+      fc_sockwait_add(sniff_wait, listen_socks[i],
+                      FC_SW_READ | FC_SW_EXCEPT);
     }
 
     if (with_ggz) {
 #ifdef GGZ_SERVER
       int ggz_sock = get_ggz_socket();
 
-      FD_SET(ggz_sock, &readfs);
-      max_desc = MAX(max_desc, ggz_sock);
+      fc_sockwait_add(sniff_wait, ggz_sock, FC_SW_READ);
 #endif /* GGZ_SERVER */
     }
 
     for (i = 0; i < MAX_NUM_CONNECTIONS; i++) {
       struct connection *pconn = connections + i;
       if (pconn->used && !pconn->server.is_closing) {
-        FD_SET(pconn->sock, &readfs);
-        if (0 < pconn->send_buffer->ndata) {
-          FD_SET(pconn->sock, &writefs);
-        }
-        FD_SET(pconn->sock, &exceptfs);
-        max_desc = MAX(pconn->sock, max_desc);
+        /* Ask for write readiness only when there is output pending. */
+        fc_sockwait_add(sniff_wait, pconn->sock,
+                        0 < pconn->send_buffer->ndata
+                        ? FC_SW_READ | FC_SW_WRITE | FC_SW_EXCEPT
+                        : FC_SW_READ | FC_SW_EXCEPT);
       }
     }
     con_prompt_off();		/* output doesn't generate a new prompt */
 
-    if (fc_select(max_desc + 1, &readfs, &writefs, &exceptfs, &tv) == 0) {
+    if (fc_sockwait_run(sniff_wait, 1000) == 0) {
       /* timeout */
       call_ai_refresh();
       (void) send_server_info_to_metaserver(META_REFRESH);
@@ -723,7 +728,7 @@ enum server_events server_sniff_all_input(void)
 	    lib$stop(status);
 	  }
 	  if (ttchar.numchars) {
-	    FD_SET(0, &readfs);
+	    fc_sockwait_set_ready(sniff_wait, 0, FC_SW_READ);
 	  } else {
 	    continue;
 	  }
@@ -740,7 +745,7 @@ enum server_events server_sniff_all_input(void)
     if (!with_ggz) { /* No listening socket when using GGZ. */
       excepting = FALSE;
       for (i = 0; i < listen_count; i++) {
-        if (FD_ISSET(listen_socks[i], &exceptfs)) {
+        if (fc_sockwait_isset(sniff_wait, listen_socks[i], FC_SW_EXCEPT)) {
           excepting = TRUE;
           break;
         }
@@ -750,7 +755,8 @@ enum server_events server_sniff_all_input(void)
       }
       for (i = 0; i < listen_count; i++) {
         s = listen_socks[i];
-        if (FD_ISSET(s, &readfs)) {     /* new players connects */
+        if (fc_sockwait_isset(sniff_wait, s, FC_SW_READ)) {
+          /* new players connects */
           log_verbose("got new connection");
           if (-1 == server_accept_connection(s)) {
             /* There will be a log_error() message from
@@ -768,7 +774,7 @@ enum server_events server_sniff_all_input(void)
 
       if (pconn->used
           && !pconn->server.is_closing
-          && FD_ISSET(pconn->sock, &exceptfs)) {
+          && fc_sockwait_isset(sniff_wait, pconn->sock, FC_SW_EXCEPT)) {
         log_verbose("connection (%s) cut due to exception data",
                     conn_description(pconn));
         connection_close_server(pconn, _("network exception"));
@@ -780,7 +786,7 @@ enum server_events server_sniff_all_input(void)
        * it may cut a client. */
       int ggz_sock = get_ggz_socket();
 
-      if (FD_ISSET(ggz_sock, &readfs)) {
+      if (fc_sockwait_isset(sniff_wait, ggz_sock, FC_SW_READ)) {
 	input_from_ggz(ggz_sock);
       }
     }
@@ -795,7 +801,8 @@ enum server_events server_sniff_all_input(void)
       free(bufptr_internal);
     }
 #else  /* !SOCKET_ZERO_ISNT_STDIN */
-    if(!no_input && FD_ISSET(0, &readfs)) {    /* input from server operator */
+    if (!no_input && fc_sockwait_isset(sniff_wait, 0, FC_SW_READ)) {
+      /* input from server operator */
 #ifdef HAVE_LIBREADLINE
       rl_callback_read_char();
       if (readline_handled_input) {
@@ -851,7 +858,7 @@ enum server_events server_sniff_all_input(void)
 
         if (!pconn->used
             || pconn->server.is_closing
-            || !FD_ISSET(pconn->sock, &readfs)) {
+            || !fc_sockwait_isset(sniff_wait, pconn->sock, FC_SW_READ)) {
           continue;
 	}
 
@@ -874,7 +881,7 @@ enum server_events server_sniff_all_input(void)
             && !pconn->server.is_closing
             && pconn->send_buffer
 	    && pconn->send_buffer->ndata > 0) {
-	  if (FD_ISSET(pconn->sock, &writefs)) {
+	  if (fc_sockwait_isset(sniff_wait, pconn->sock, FC_SW_WRITE)) {
 	    flush_connection_send_buffer_all(pconn);
 	  } else {
 	    cut_lagging_connection(pconn);
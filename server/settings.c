@@ -501,6 +501,18 @@ static void scorelog_action(const struct setting *pset)
   }
 }
 
+/*************************************************************************
+  (De)initialze the performance log.
+*************************************************************************/
+static void perflog_action(const struct setting *pset)
+{
+  if (*pset->boolean.pvalue) {
+    log_perf_init();
+  } else {
+    log_perf_free();
+  }
+}
+
 /*************************************************************************
   Create the selected number of AI's.
 *************************************************************************/
@@ -681,6 +693,21 @@ static bool scorefile_validate(const char *value, struct connection *caller,
   return TRUE;
 }
 
+/****************************************************************************
+  Verify the name for the performance log file.
+****************************************************************************/
+static bool perffile_validate(const char *value, struct connection *caller,
+                              char *reject_msg, size_t reject_msg_len)
+{
+  if (!is_safe_filename(value)) {
+    settings_snprintf(reject_msg, reject_msg_len,
+                      _("Invalid perflog name definition: '%s'."), value);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
 /*************************************************************************
   Verify that a given demography string is valid. See
   game.demography.
@@ -2485,6 +2512,28 @@ static struct setting settings[] = {
               "'freeciv-score.log'."),
              scorefile_validate, NULL, GAME_DEFAULT_SCOREFILE)
 
+  GEN_BOOL("perflog", game.server.perflog,
+           SSET_META, SSET_INTERNAL, SSET_RARE, SSET_SERVER_ONLY,
+           N_("Whether to log server performance"),
+           /* TRANS: The string between single quotes is a setting name and
+            * should not be translated. */
+           N_("If this is turned on, the time spent in each step of the "
+              "turn and by each AI player, together with counts of "
+              "pathfinding maps, CM queries, packets and memory "
+              "allocations, is appended to the file defined by the option "
+              "'perffile' every turn, one CSV line per turn. The time of "
+              "each AI player goes to a second file with '-ai' added to "
+              "that name, one CSV line per turn and player."),
+           NULL, perflog_action, GAME_DEFAULT_PERFLOG)
+
+  GEN_STRING("perffile", game.server.perffile,
+             SSET_META, SSET_INTERNAL, SSET_RARE, SSET_SERVER_ONLY,
+             N_("Name for the performance log file"),
+             /* TRANS: Don't translate the string in single quotes. */
+             N_("The default name for the performance log file is "
+              "'freeciv-perf.csv'."),
+             perffile_validate, NULL, GAME_DEFAULT_PERFFILE)
+
   GEN_INT("maxconnectionsperhost", game.server.maxconnectionsperhost,
           SSET_RULES_FLEXIBLE, SSET_NETWORK, SSET_RARE, SSET_TO_CLIENT,
           N_("Maximum number of connections to the server per host"),
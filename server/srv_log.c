@@ -41,6 +41,16 @@
 static struct timer *aitimer[AIT_LAST][2];
 static int recursion[AIT_LAST];
 
+/* Profiler zone names of the timers, in enum ai_timer order. */
+static const char *ait_zone_name[] = {
+  "ai", "movemap", "units", "settlers", "workers", "aidata",
+  "government", "taxes", "cities", "citizen_arrange", "buildings",
+  "danger", "tech", "fstk", "defenders", "caravan", "hunter", "airlift",
+  "diplomat", "airunit", "explorer", "emergency", "city_military",
+  "city_terrain", "city_settlers", "attack", "military", "recover",
+  "bodyguard", "ferry", "rampage"
+};
+
 /* General AI logging functions */
 
 /**************************************************************************
@@ -154,12 +164,21 @@ void real_unit_log(const char *file, const char *function, int line,
 
 /**************************************************************************
   Measure the time between the calls.  Used to see where in the AI too
-  much CPU is being used.
+  much CPU is being used.  When the profiler is running, the timers are
+  also recorded as profiler zones.
 **************************************************************************/
 void timing_log_real(enum ai_timer timer, enum ai_timer_activity activity)
 {
   static int turn = -1;
 
+  if (profile_enabled) {
+    if (activity == TIMER_START) {
+      profile_zone_start(ait_zone_name[timer]);
+    } else {
+      profile_zone_stop(ait_zone_name[timer]);
+    }
+  }
+
   if (game.info.turn != turn) {
     int i;
 
@@ -249,6 +268,9 @@ void timing_log_init(void)
 {
   int i;
 
+  FC_STATIC_ASSERT(ARRAY_SIZE(ait_zone_name) == AIT_LAST,
+                   ait_zone_name_mismatch);
+
   for (i = 0; i < AIT_LAST; i++) {
     aitimer[i][0] = timer_new(TIMER_CPU, TIMER_ACTIVE);
     aitimer[i][1] = timer_new(TIMER_CPU, TIMER_ACTIVE);
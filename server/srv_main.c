@@ -36,6 +36,9 @@
 #ifdef HAVE_TERMIOS_H
 #include <termios.h>
 #endif
+#ifdef HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
@@ -261,6 +264,11 @@ void srv_init(void)
   srvarg.auth_allow_guests = FALSE;
   srvarg.auth_allow_newusers = FALSE;
 
+  srvarg.genmaps = 0;
+  srvarg.genmaps_workers = 1;
+
+  srvarg.sanity_check_turns = 0;
+
   /* mark as initialized */
   has_been_srv_init = TRUE;
 
@@ -891,7 +899,11 @@ static void ai_start_phase(void)
 	//TODO: Remove this printf
 	//printf("%s\n", pplayer->name);
     if (pplayer->ai_controlled) {
+      PROFILE_ZONE_START(pplayer->name);
+      log_perf_ai_start(pplayer);
       CALL_PLR_AI_FUNC(first_activities, pplayer, pplayer);
+      log_perf_ai_stop(pplayer);
+      PROFILE_ZONE_STOP(pplayer->name);
     }
   } phase_players_iterate_end;
   kill_dying_players();
@@ -933,7 +945,7 @@ static void begin_turn(bool is_new_turn)
   send_game_info(NULL);
 
   if (is_new_turn) {
-    script_server_signal_emit("turn_started", 2,
+    script_server_signal_emit(SIGNAL_TURN_STARTED, 2,
                               API_TYPE_INT, game.info.turn,
                               API_TYPE_INT, game.info.year);
   }
@@ -979,7 +991,7 @@ static void begin_turn(bool is_new_turn)
     game.info.phase = 0;
   }
 
-  sanity_check();
+  sanity_check_changed();
 }
 
 /**************************************************************************
@@ -1057,7 +1069,7 @@ static void begin_phase(bool is_new_phase)
     ai_start_phase();
   }
 
-  sanity_check();
+  sanity_check_changed();
 
   game.info.seconds_to_phasedone = (double)current_turn_timeout();
   game.server.phase_timer = timer_renew(game.server.phase_timer,
@@ -1120,6 +1132,8 @@ static void end_phase(void)
     } unit_list_iterate_end;
   } players_iterate_end;
   phase_players_iterate(pplayer) {
+    PROFILE_ZONE_START(pplayer->name);
+    log_perf_ai_start(pplayer);
     auto_settlers_player(pplayer);
     advance_index_iterate(A_FIRST, i) {
       pplayer->ai_common.tech_want[i] = 0;
@@ -1127,6 +1141,8 @@ static void end_phase(void)
     if (pplayer->ai_controlled) {
       CALL_PLR_AI_FUNC(last_activities, pplayer, pplayer);
     }
+    log_perf_ai_stop(pplayer);
+    PROFILE_ZONE_STOP(pplayer->name);
   } phase_players_iterate_end;
 
   /* Refresh cities */
@@ -1517,7 +1533,6 @@ void server_clear(void)
   server_game_free();
   diplhand_free();
   voting_free();
-  adv_settlers_free();
   ai_timer_free();
   if (game.server.phase_timer != NULL) {
     timer_destroy(game.server.phase_timer);
@@ -1540,6 +1555,7 @@ void server_clear(void)
   rulesets_deinit();
   ruleset_choices_free();
   timing_log_free();
+  profile_free();
   registry_module_close();
   fc_destroy_mutex(&game.server.mutexes.city_list);
   free_libfreeciv();
@@ -1571,7 +1587,6 @@ void server_quit(void)
   server_game_free();
   diplhand_free();
   voting_free();
-  adv_settlers_free();
   ai_timer_free();
   if (game.server.phase_timer != NULL) {
     timer_destroy(game.server.phase_timer);
@@ -1594,9 +1609,12 @@ void server_quit(void)
   rulesets_deinit();
   ruleset_choices_free();
   timing_log_free();
+  profile_free();
   registry_module_close();
   fc_destroy_mutex(&game.server.mutexes.city_list);
   free_libfreeciv();
+  fc_mem_pools_log(LOG_VERBOSE);
+  fc_mem_pools_free();
   free_nls();
   con_log_close();
   exit(EXIT_SUCCESS);
@@ -2519,7 +2537,11 @@ static void srv_running(void)
      * We have to initialize data as well as do some actions.  However when
      * loading a game we don't want to do these actions (like AI unit
      * movement and AI diplomacy). */
+    PROFILE_ZONE_START("begin_turn");
+    log_perf_step_start(PERF_STEP_BEGIN_TURN);
     begin_turn(is_new_turn);
+    log_perf_step_stop(PERF_STEP_BEGIN_TURN);
+    PROFILE_ZONE_STOP("begin_turn");
 
     if (game.server.num_phases != 1) {
       /* We allow everyone to begin adjusting cities and such
@@ -2532,7 +2554,11 @@ static void srv_running(void)
     for (; game.info.phase < game.server.num_phases; game.info.phase++) {
       log_debug("Starting phase %d/%d.", game.info.phase,
                 game.server.num_phases);
+      PROFILE_ZONE_START("begin_phase");
+      log_perf_step_start(PERF_STEP_BEGIN_PHASE);
       begin_phase(is_new_turn);
+      log_perf_step_stop(PERF_STEP_BEGIN_PHASE);
+      PROFILE_ZONE_STOP("begin_phase");
       if (need_send_pending_events) {
         /* When loading a savegame, we need to send loaded events, after
          * the clients switched to the game page (after the first
@@ -2592,9 +2618,11 @@ static void srv_running(void)
 
       log_debug("sniffingpackets");
       check_for_full_turn_done(); /* HACK: don't wait during AI phases */
+      log_perf_step_start(PERF_STEP_SNIFF);
       while (server_sniff_all_input() == S_E_OTHERWISE) {
         /* nothing */
       }
+      log_perf_step_stop(PERF_STEP_SNIFF);
 
       /* After sniff, re-zero the timer: (read-out above on next loop) */
       timer_clear(eot_timer);
@@ -2602,14 +2630,18 @@ static void srv_running(void)
 
       conn_list_do_buffer(game.est_connections);
 
-      sanity_check();
+      sanity_check_changed();
 
       /* 
        * This will freeze the reports and agents at the client.
        */
       lsend_packet_freeze_client(game.est_connections);
 
+      PROFILE_ZONE_START("end_phase");
+      log_perf_step_start(PERF_STEP_END_PHASE);
       end_phase();
+      log_perf_step_stop(PERF_STEP_END_PHASE);
+      PROFILE_ZONE_STOP("end_phase");
 
       conn_list_do_unbuffer(game.est_connections);
 
@@ -2617,7 +2649,19 @@ static void srv_running(void)
 	break;
       }
     }
+    PROFILE_ZONE_START("end_turn");
+    log_perf_step_start(PERF_STEP_END_TURN);
     end_turn();
+    log_perf_step_stop(PERF_STEP_END_TURN);
+    PROFILE_ZONE_STOP("end_turn");
+    /* end_turn() has already advanced the turn counter. */
+    log_perf_now(game.info.turn - 1);
+    if (profile_enabled) {
+      char frame[32];
+
+      fc_snprintf(frame, sizeof(frame), "T%d", game.info.turn - 1);
+      profile_flush(frame);
+    }
     log_debug("Sendinfotometaserver");
     (void) send_server_info_to_metaserver(META_REFRESH);
 
@@ -2917,7 +2961,7 @@ static void srv_ready(void)
     }
 
     if (map.server.generator != MAPGEN_SCENARIO) {
-      script_server_signal_emit("map_generated", 0);
+      script_server_signal_emit(SIGNAL_MAP_GENERATED, 0);
     }
     game_map_init();
 
@@ -3102,9 +3146,11 @@ void server_game_free(void)
 
   event_cache_free();
   log_civ_score_free();
+  log_perf_free();
   playercolor_free();
   citymap_free();
   game_free();
+  sanity_check_free();
 }
 
 void srv_reload_setup(void){
@@ -3118,6 +3164,154 @@ void srv_reload_run(void){
 	srv_scores();
 }
 
+/**************************************************************************
+  Generate and save the maps of the pool with index 'first', 'first + step',
+  ... below srvarg.genmaps. Map n uses the map seed 'base_seed + n'.
+  Returns the number of maps which could not be generated.
+**************************************************************************/
+static int srv_genmaps_range(int first, int step, int base_seed,
+                             struct unit_type *utype)
+{
+  const enum map_generator generator = map.server.generator;
+  const enum map_startpos startpos = map.server.startpos;
+  const enum team_placement team_placement = map.server.team_placement;
+  int n, failed = 0;
+
+  for (n = first; n < srvarg.genmaps; n += step) {
+    char filename[MAX_LEN_PATH];
+    struct timer *map_timer = timer_new(TIMER_USER, TIMER_ACTIVE);
+
+    timer_start(map_timer);
+
+    /* The generator may fall back to other settings; every map of the
+     * pool starts from the same ones. */
+    map_free();
+    map.server.generator = generator;
+    map.server.startpos = startpos;
+    map.server.team_placement = team_placement;
+    map.server.have_resources = FALSE;
+    map.server.seed = base_seed + n;
+    /* Start positions are placed with the game random state; reseed it so
+     * the map depends only on its seed, not on the order of the jobs. */
+    fc_srand(base_seed + n);
+
+    if (!map_fractal_generate(TRUE, utype)) {
+      log_error(_("Failed to generate map with mapseed %d."),
+                base_seed + n);
+      failed++;
+    } else {
+      /* Save the map only, without the players used for generating it. */
+      game.scenario.is_scenario = TRUE;
+      game.scenario.players = FALSE;
+      fc_snprintf(game.scenario.name, sizeof(game.scenario.name),
+                  _("Generated map %d"), base_seed + n);
+      fc_snprintf(filename, sizeof(filename), "%s-seed%d",
+                  game.server.save_name, base_seed + n);
+      save_game(filename, "Generated map", TRUE);
+    }
+
+    timer_stop(map_timer);
+    log_verbose("Map %d/%d (mapseed %d) done in %.3f seconds.",
+                n + 1, srvarg.genmaps, base_seed + n,
+                timer_read_seconds(map_timer));
+    timer_destroy(map_timer);
+  }
+
+  return failed;
+}
+
+/**************************************************************************
+  Batch map generation mode (--genmaps). The rulesets and the startup
+  script are loaded once, then srvarg.genmaps maps are generated with
+  consecutive map seeds and saved as scenarios. The map generator works
+  on global state, so the work is split between forked worker processes
+  rather than threads.
+**************************************************************************/
+static void srv_genmaps(void)
+{
+  struct unit_type *utype = NULL;
+  struct timer *pool_timer;
+  int base_seed = map.server.seed;
+  int workers = CLIP(1, srvarg.genmaps_workers,
+                     MIN(srvarg.genmaps, GENMAPS_MAX_WORKERS));
+  int sucount = strlen(game.server.start_units);
+  int failed = 0;
+  int i;
+
+  for (i = 0; utype == NULL && i < sucount; i++) {
+    utype = crole_to_unit_type(game.server.start_units[i], NULL);
+  }
+  fc_assert_ret(utype != NULL);
+
+  init_game_seed();
+  if (base_seed == 0) {
+    /* Keep the whole seed range positive. */
+    base_seed = 1 + fc_rand(MAX_UINT32 >> 2);
+  }
+
+  log_normal(_("Generating %d maps (mapseed %d to %d) with %d worker(s)."),
+             srvarg.genmaps, base_seed, base_seed + srvarg.genmaps - 1,
+             workers);
+
+  pool_timer = timer_new(TIMER_USER, TIMER_ACTIVE);
+  timer_start(pool_timer);
+
+#ifdef HAVE_WORKING_FORK
+  if (workers > 1) {
+    pid_t *pids = fc_malloc(workers * sizeof(*pids));
+    int started;
+
+    /* Don't let the workers inherit buffered output of the parent. */
+    fflush(NULL);
+
+    for (started = 1; started < workers; started++) {
+      pids[started] = fork();
+      if (pids[started] == 0) {
+        /* Worker process. It must not run the atexit() handlers of the
+         * parent, so it leaves with _exit() after flushing its own
+         * output. */
+        int result = srv_genmaps_range(started, workers, base_seed, utype);
+
+        fflush(NULL);
+        _exit(result == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+      } else if (pids[started] < 0) {
+        log_error(_("Failed to start map generation worker: %s"),
+                  fc_strerror(fc_get_errno()));
+        break;
+      }
+    }
+
+    /* Do the share of the workers which could not be started, too. */
+    failed += srv_genmaps_range(0, workers, base_seed, utype);
+    for (i = started; i < workers; i++) {
+      failed += srv_genmaps_range(i, workers, base_seed, utype);
+    }
+
+    for (i = 1; i < started; i++) {
+      int status;
+
+      if (waitpid(pids[i], &status, 0) < 0
+          || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+        failed++;
+      }
+    }
+    free(pids);
+  } else
+#endif /* HAVE_WORKING_FORK */
+  {
+    failed += srv_genmaps_range(0, 1, base_seed, utype);
+  }
+
+  timer_stop(pool_timer);
+  log_normal(_("Map pool generated in %.3f seconds."),
+             timer_read_seconds(pool_timer));
+  timer_destroy(pool_timer);
+
+  if (failed > 0) {
+    log_error(_("%d map generation job(s) failed."), failed);
+  }
+}
+
 /**************************************************************************
   Server main loop.
 **************************************************************************/
@@ -3144,6 +3338,11 @@ void srv_main(void)
       event_cache_clear();
     }
 
+    if (srvarg.genmaps > 0) {
+      srv_genmaps();
+      server_quit();
+    }
+
     log_normal(_("Now accepting new client connections on port %d."),
                srvarg.port);
 
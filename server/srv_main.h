@@ -58,8 +58,17 @@ struct server_arguments {
   bool auth_allow_newusers;     /* defaults to FALSE */
   enum announce_type announce;
   int fatal_assertions;         /* default to -1 (disabled). */
+  /* batch map generation */
+  int genmaps;                  /* number of maps; 0 (disabled) by default */
+  int genmaps_workers;          /* worker processes for genmaps, at most
+                                 * GENMAPS_MAX_WORKERS */
+  /* full sanity check every that many turns, only of the changes in
+   * between; 0 (always full) by default */
+  int sanity_check_turns;
 };
 
+#define GENMAPS_MAX_WORKERS 256
+
 /* used in savegame values */
 #define SPECENUM_NAME server_states
 #define SPECENUM_VALUE0 S_S_INITIAL
@@ -2857,6 +2857,7 @@ static bool debug_command(struct connection *caller, char *str,
     notify_conn(game.est_connections, NULL, E_AI_DEBUG, ftc_log,
                 _("players=%d cities=%d citizens=%d units=%d"),
                 players, cities, citizens, units);
+    fc_mem_pools_log(LOG_NORMAL);
   } else if (ntokens > 0 && strcmp(arg[0], "city") == 0) {
     int x, y;
     struct tile *ptile;
@@ -2922,6 +2923,23 @@ static bool debug_command(struct connection *caller, char *str,
     } unit_list_iterate_end;
   } else if (ntokens > 0 && strcmp(arg[0], "timing") == 0) {
     TIMING_RESULTS();
+  } else if (ntokens > 0 && strcmp(arg[0], "profile") == 0) {
+    const char *filename = (ntokens > 1 ? arg[1] : "freeciv-profile.txt");
+
+    if (profile_running()) {
+      profile_stop();
+      cmd_reply(CMD_DEBUG, caller, C_OK, _("Profiler stopped."));
+    } else if (!is_safe_filename(filename) && is_restricted(caller)) {
+      cmd_reply(CMD_DEBUG, caller, C_FAIL,
+                _("Name \"%s\" disallowed for security reasons."),
+                filename);
+    } else if (!profile_start(filename)) {
+      cmd_reply(CMD_DEBUG, caller, C_FAIL,
+                _("Could not open \"%s\" for the profile."), filename);
+    } else {
+      cmd_reply(CMD_DEBUG, caller, C_OK,
+                _("Profiling to \"%s\", once per turn."), filename);
+    }
   } else if (ntokens > 0 && strcmp(arg[0], "ferries") == 0) {
     if (game.server.debug[DEBUG_FERRIES]) {
       game.server.debug[DEBUG_FERRIES] = FALSE;
@@ -4730,6 +4748,8 @@ static bool reset_command(struct connection *caller, char *arg, bool check,
 #define SPECENUM_VALUE0NAME "cmd"
 #define SPECENUM_VALUE1     LUA_FILE
 #define SPECENUM_VALUE1NAME "file"
+#define SPECENUM_VALUE2     LUA_PROFILE
+#define SPECENUM_VALUE2NAME "profile"
 #include "specenum_gen.h"
 
 /*****************************************************************************
@@ -4795,6 +4815,7 @@ static bool lua_command(struct connection *caller, char *arg, bool check)
 
   switch (ind) {
   case LUA_CMD:
+  case LUA_PROFILE:
     /* Nothing to check. */
     break;
   case LUA_FILE:
@@ -4858,6 +4879,10 @@ static bool lua_command(struct connection *caller, char *arg, bool check)
       ret = FALSE;
       goto cleanup;
     }
+  case LUA_PROFILE:
+    script_server_signal_profile(caller);
+    ret = TRUE;
+    break;
   }
 
  cleanup:
@@ -6296,6 +6321,47 @@ static void show_connections(struct connection *caller)
   cmd_reply(CMD_LIST, caller, C_COMMENT, horiz_line);
 }
 
+/****************************************************************************
+  Show the packet compression statistics.
+****************************************************************************/
+static void show_compression(struct connection *caller)
+{
+  struct packet_compression_stats stats;
+  unsigned long total, sent;
+
+  packet_compression_stats_get(&stats);
+  total = stats.size_alone + stats.size_no_compression
+          + stats.size_uncompressed;
+  sent = total - stats.size_uncompressed + stats.size_compressed;
+
+  cmd_reply(CMD_LIST, caller, C_COMMENT,
+            _("Packet compression (level %d):"), stats.level);
+  cmd_reply(CMD_LIST, caller, C_COMMENT, horiz_line);
+  cmd_reply(CMD_LIST, caller, C_COMMENT,
+            _("Sent uncompressed:   %lu bytes (+%lu not worth compressing)"),
+            stats.size_alone, stats.size_no_compression);
+  cmd_reply(CMD_LIST, caller, C_COMMENT,
+            _("Compressed:          %lu bytes to %lu (%.1f%%)"),
+            stats.size_uncompressed, stats.size_compressed,
+            0 < stats.size_uncompressed
+            ? 100.0 * stats.size_compressed / stats.size_uncompressed
+            : 100.0);
+  cmd_reply(CMD_LIST, caller, C_COMMENT,
+            _("Total on the wire:   %lu bytes of %lu (%.1f%%)"),
+            sent, total, 0 < total ? 100.0 * sent / total : 100.0);
+  cmd_reply(CMD_LIST, caller, C_COMMENT,
+            _("Compressed queues:   %lu (%lu reused)"),
+            stats.flushes, stats.cache_hits);
+  cmd_reply(CMD_LIST, caller, C_COMMENT,
+            _("Compression time:    %.3f seconds (%.1f MB/s)"),
+            stats.seconds,
+            0.0 < stats.seconds
+            ? (stats.size_uncompressed + stats.size_no_compression)
+              / stats.seconds / (1024 * 1024)
+            : 0.0);
+  cmd_reply(CMD_LIST, caller, C_COMMENT, horiz_line);
+}
+
 /*****************************************************************************
   List all delegations of the current game.
 *****************************************************************************/
@@ -6607,6 +6673,8 @@ static void show_colors(struct connection *caller)
 #define SPECENUM_VALUE8NAME "teams"
 #define SPECENUM_VALUE9     LIST_VOTES
 #define SPECENUM_VALUE9NAME "votes"
+#define SPECENUM_VALUE10    LIST_COMPRESSION
+#define SPECENUM_VALUE10NAME "compression"
 #include "specenum_gen.h"
 
 /**************************************************************************
@@ -6647,6 +6715,9 @@ static bool show_list(struct connection *caller, char *arg)
   case LIST_COLORS:
     show_colors(caller);
     return TRUE;
+  case LIST_COMPRESSION:
+    show_compression(caller);
+    return TRUE;
   case LIST_CONNECTIONS:
     show_connections(caller);
     return TRUE;
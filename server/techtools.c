@@ -103,7 +103,7 @@ void script_tech_learned(struct player *plr, struct advance *tech,
 {
   /* Emit signal for individual player whose action triggered the
    * tech first */
-  script_server_signal_emit("tech_researched", 3,
+  script_server_signal_emit(SIGNAL_TECH_RESEARCHED, 3,
                             API_TYPE_TECH_TYPE, tech,
                             API_TYPE_PLAYER, plr,
                             API_TYPE_STRING, reason);
@@ -112,7 +112,7 @@ void script_tech_learned(struct player *plr, struct advance *tech,
   players_iterate(aplayer) {
     if (aplayer != plr
         && player_research_get(plr) == player_research_get(aplayer)) {
-      script_server_signal_emit("tech_researched", 3,
+      script_server_signal_emit(SIGNAL_TECH_RESEARCHED, 3,
                                 API_TYPE_TECH_TYPE, tech,
                                 API_TYPE_PLAYER, aplayer,
                                 API_TYPE_STRING, reason);
@@ -1588,7 +1588,7 @@ struct unit *create_unit_full(struct player *pplayer, struct tile *ptile,
   punit->moved = (moves_left >= 0);
 
   unit_list_prepend(pplayer->units, punit);
-  unit_list_prepend(ptile->units, punit);
+  tile_add_unit(ptile, punit);
   if (pcity && !utype_has_flag(type, UTYF_NOHOME)) {
     fc_assert(city_owner(pcity) == pplayer);
     unit_list_prepend(pcity->units_supported, punit);
@@ -1632,6 +1632,7 @@ static void server_remove_unit_full(struct unit *punit, bool transported,
 
   /* The unit is doomed. */
   punit->server.dying = TRUE;
+  sanity_mark_tile(ptile);
 
 #ifdef DEBUG
   unit_list_iterate(ptile->units, pcargo) {
@@ -1691,7 +1692,7 @@ static void server_remove_unit_full(struct unit *punit, bool transported,
     player_status_add(unit_owner(punit), PSTATUS_DYING);
   }
 
-  script_server_signal_emit("unit_lost", 3,
+  script_server_signal_emit(SIGNAL_UNIT_LOST, 3,
                             API_TYPE_UNIT, punit,
                             API_TYPE_PLAYER, unit_owner(punit),
                             API_TYPE_STRING, unit_loss_reason_name(reason));
@@ -2497,6 +2498,7 @@ void send_unit_info(struct conn_list *dest, struct unit *punit)
   }
 
   CHECK_UNIT(punit);
+  sanity_mark_unit(punit);
 
   powner = unit_owner(punit);
   package_unit(punit, &info[0]);
@@ -2511,6 +2513,7 @@ void send_unit_info(struct conn_list *dest, struct unit *punit)
   package_short_unit(punit, &sinfo, UNIT_INFO_IDENTITY, 0, FALSE);
   pdata = punit->server.moving;
 
+  packet_broadcast_begin(dest);
   conn_list_iterate(dest, pconn) {
     struct player *pplayer = conn_get_player(pconn);
 
@@ -2535,6 +2538,7 @@ void send_unit_info(struct conn_list *dest, struct unit *punit)
       }
     }
   } conn_list_iterate_end;
+  packet_broadcast_end();
 }
 
 /**************************************************************************
@@ -2964,7 +2968,7 @@ static void unit_enter_hut(struct unit *punit)
     return;
   }
 
-  script_server_signal_emit("hut_enter", 1,
+  script_server_signal_emit(SIGNAL_HUT_ENTER, 1,
                             API_TYPE_UNIT, punit);
 
   send_player_info_c(pplayer, pplayer->connections); /* eg, gold */
@@ -3461,12 +3465,12 @@ static struct unit_move_data *unit_move_data(struct unit *punit,
 
   /* Remove unit from the source tile. */
   fc_assert(unit_tile(punit) == psrctile);
-  success = unit_list_remove(psrctile->units, punit);
+  success = tile_remove_unit(psrctile, punit);
   fc_assert(success == TRUE);
 
   /* Set new tile. */
   unit_tile_set(punit, pdesttile);
-  unit_list_prepend(pdesttile->units, punit);
+  tile_add_unit(pdesttile, punit);
 
   if (unit_transported(punit)) {
     /* Silently free orders since they won't be applicable anymore. */
@@ -3550,6 +3554,10 @@ bool unit_move(struct unit *punit, struct tile *pdesttile, int move_cost)
   psrctile = unit_tile(punit);
   adj = base_get_direction_for_step(psrctile, pdesttile, &facing);
 
+  /* Marks the source tile; the unit info sent below marks the
+   * destination. */
+  sanity_mark_unit(punit);
+
   conn_list_do_buffer(game.est_connections);
 
   /* Unload the unit if on a transport. */
@@ -3810,7 +3818,7 @@ bool unit_move(struct unit *punit, struct tile *pdesttile, int move_cost)
 
   if (unit_lives) {
     /* Let the scripts run ... */
-    script_server_signal_emit("unit_moved", 3,
+    script_server_signal_emit(SIGNAL_UNIT_MOVED, 3,
                               API_TYPE_UNIT, punit,
                               API_TYPE_TILE, psrctile,
                               API_TYPE_TILE, pdesttile);
@@ -0,0 +1,176 @@
+#!/bin/sh
+
+# Measure how fast the server plays AI-only turns.
+#
+# Usage: benchmark.sh <top_srcdir> <top_builddir> [turns] [savegame...]
+#
+# Every savegame is loaded and played for 'turns' more turns (default 10)
+# without any client, twice. Savegames must contain the random state
+# (the default for normal and auto saves) to be replayed identically.
+# Without savegames a reference game is first played from fixed seeds.
+#
+# For every game the number of turns, the time spent in the turns (as
+# reported by the 'perflog' setting), turns per second, the time of each
+# step of the turn and a hash of the final state are printed. The script
+# fails if the two runs of a game end in different states.
+
+top_srcdir=$1
+top_builddir=$2
+turns=${3:-10}
+if test $# -gt 3; then
+  shift 3
+  saves="$*"
+else
+  saves=""
+fi
+
+# The server runs in the directory of each game.
+top_srcdir=`cd "$top_srcdir" && pwd`
+top_builddir=`cd "$top_builddir" && pwd`
+
+server="$top_builddir/server/freeciv-server"
+port=${BENCHMARK_PORT:-5599}
+workdir=`pwd`/benchmark-out
+
+FREECIV_DATA_PATH="$top_builddir/data:$top_srcdir/data"
+export FREECIV_DATA_PATH
+
+if test ! -x "$server"; then
+  echo "$server not found; build the server first." >&2
+  exit 1
+fi
+
+if which md5sum >/dev/null 2>&1; then
+  hash_cmd=md5sum
+elif which sha1sum >/dev/null 2>&1; then
+  hash_cmd=sha1sum
+else
+  hash_cmd=cksum
+fi
+
+# Write the uncompressed savegame $1 to stdout.
+cat_save() {
+  case "$1" in
+    *.gz) gzip -dc "$1" ;;
+    *.bz2) bzip2 -dc "$1" ;;
+    *.xz) xz -dc "$1" ;;
+    *) cat "$1" ;;
+  esac
+}
+
+# Print the newest autosave in directory $1.
+last_save() {
+  ls -t "$1"/freeciv-T*.sav 2>/dev/null | head -n 1
+}
+
+# Hash of the game state in savegame $1. The time stamps of the event
+# cache are the only part that changes between identical games.
+state_hash() {
+  cat_save "$1" \
+    | sed -e 's/^\([0-9]*\),[0-9]*,\(-*[0-9]*,-*[0-9]*,"S_S_\)/\1,T,\2/' \
+    | $hash_cmd | cut -d' ' -f1
+}
+
+# Run the server in directory $1 on the script $2, loading savegame $3
+# if given.
+run_server() {
+  if test -n "$3"; then
+    load="-f $3"
+  else
+    load=""
+  fi
+  (cd "$1" && "$server" -p $port -e $load -r "$2" \
+     </dev/null >server.log 2>&1)
+}
+
+# Settings common to all benchmark games.
+write_settings() {
+  echo "set timeout -1"
+  echo "set compresstype PLAIN"
+  echo "set saveturns 1"
+  echo "set autosaves TURN"
+  echo "set perflog enabled"
+  echo "set perffile perf.csv"
+}
+
+rm -rf "$workdir"
+mkdir -p "$workdir" || exit 1
+
+if test -z "$saves"; then
+  dir="$workdir/reference"
+  mkdir -p "$dir"
+  (echo "set gameseed 42"
+   echo "set mapseed 42"
+   echo "set size 4"
+   echo "set minplayers 0"
+   echo "set aifill 10"
+   echo "set endturn ${BENCHMARK_REF_TURNS:-60}"
+   write_settings
+   echo "hard"
+   echo "start") > "$dir/bench.serv"
+  echo "Playing the reference game..."
+  run_server "$dir" bench.serv
+  saves=`last_save "$dir"`
+  if test -z "$saves"; then
+    echo "The reference game failed; see $dir/server.log." >&2
+    exit 1
+  fi
+fi
+
+printf "%-24s %5s %8s %9s %10s %10s %10s %10s %10s  %s\n" \
+       game turns seconds turns/sec begin_turn begin_phase end_phase \
+       end_turn ai hash
+status=0
+for save in $saves; do
+  case "$save" in
+    /*) ;;
+    *) save="`pwd`/$save" ;;
+  esac
+  name=`basename "$save" | sed 's/\.sav.*$//'`
+  start=`cat_save "$save" | sed -n 's/^turn=\([0-9]*\)$/\1/p' | head -n 1`
+  if test -z "$start"; then
+    echo "$save: not a savegame." >&2
+    status=1
+    continue
+  fi
+
+  hashes=""
+  for run in 1 2; do
+    dir="$workdir/$name-$run"
+    mkdir -p "$dir"
+    # The autosave at the start of the last turn holds the final state.
+    (echo "set endturn `expr $start + $turns`"
+     write_settings
+     echo "start") > "$dir/bench.serv"
+    run_server "$dir" bench.serv "$save"
+    final=`last_save "$dir"`
+    if test -z "$final" || test ! -f "$dir/perf.csv"; then
+      echo "$name: the game failed; see $dir/server.log." >&2
+      status=1
+      continue 2
+    fi
+    hashes="$hashes `state_hash "$final"`"
+  done
+
+  set -- $hashes
+  if test "$1" != "$2"; then
+    echo "$name: the two runs ended differently ($1 $2)." >&2
+    status=1
+  fi
+
+  # perf.csv columns: game, turn, begin_turn, begin_phase, sniff,
+  # end_phase, end_turn, ai, ...
+  awk -F, -v name="$name" -v hash="$1" -v last=`expr $start + $turns` '
+    NR > 1 && $2 < last {
+      n++
+      bt += $3; bp += $4; sn += $5; ep += $6; et += $7; ai += $8
+    }
+    END {
+      total = bt + bp + sn + ep + et
+      rate = (total > 0 ? n / total : 0)
+      printf "%-24s %5d %8.2f %9.3f %10.2f %10.2f %10.2f %10.2f %10.2f  %s\n",
+             name, n, total, rate, bt, bp, ep, et, ai, hash
+    }' "$workdir/$name-2/perf.csv"
+done
+
+exit $status
@@ -0,0 +1,117 @@
+/**********************************************************************
+ Freeciv - Copyright (C) 1996 - A Kjeldberg, L Gregersen, P Unold
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+***********************************************************************/
+
+/* Micro-benchmark of win_chance(), run by "make benchmark".
+
+   QUERIES fights are drawn from a number of distinct matchups, the way
+   the AI asks for the same odds over and over while it evaluates its
+   targets. The strengths are those of a few unit types with veteran and
+   terrain bonuses, with 10, 20 or 30 hit points and firepower 1 or 2.
+   For each number of matchups the time of one call in nanoseconds is
+   printed, as the fastest of BATCHES batches. With more matchups than
+   win_chance() remembers, most calls compute the odds from scratch. */
+
+#ifdef HAVE_CONFIG_H
+#include <fc_config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* utility */
+#include "rand.h"
+#include "shared.h"
+#include "timing.h"
+
+/* common */
+#include "combat.h"
+
+#define BATCHES 100
+#define QUERIES 4096
+#define REPEAT 10
+
+struct fight {
+  int as, ahp, afp;
+  int ds, dhp, dfp;
+};
+
+static struct fight fights[QUERIES];
+
+/**********************************************************************
+  Fill 'fights' from 'matchups' distinct random fights.
+***********************************************************************/
+static void fights_init(int matchups)
+{
+  const int power[] = { 10, 20, 30, 40, 60, 80, 120, 180 };
+  int i;
+
+  for (i = 0; i < matchups; i++) {
+    fights[i].as = power[fc_rand(ARRAY_SIZE(power))] * (10 + 5 * fc_rand(3));
+    fights[i].ahp = 10 * (1 + fc_rand(3));
+    fights[i].afp = 1 + fc_rand(2);
+    fights[i].ds = power[fc_rand(ARRAY_SIZE(power))] * (10 + 5 * fc_rand(3));
+    fights[i].dhp = 10 * (1 + fc_rand(3));
+    fights[i].dfp = 1 + fc_rand(2);
+  }
+  for (; i < QUERIES; i++) {
+    fights[i] = fights[fc_rand(matchups)];
+  }
+}
+
+/**********************************************************************
+  Entry point.
+***********************************************************************/
+int main(int argc, char **argv)
+{
+  const int matchups[] = { 64, 256, 1024, QUERIES };
+  struct timer *t = timer_new(TIMER_USER, TIMER_ACTIVE);
+  double sum = 0.0;
+  int i;
+
+  fc_srand(1);
+
+  printf("win_chance(), nanoseconds per call\n");
+  printf("%8s %8s\n", "matchups", "call");
+  for (i = 0; i < ARRAY_SIZE(matchups); i++) {
+    double best = -1.0;
+    int batch;
+
+    fights_init(matchups[i]);
+    for (batch = 0; batch < BATCHES; batch++) {
+      double ns;
+      int r, j;
+
+      timer_clear(t);
+      timer_start(t);
+      for (r = 0; r < REPEAT; r++) {
+        for (j = 0; j < QUERIES; j++) {
+          const struct fight *pfight = fights + j;
+
+          sum += win_chance(pfight->as, pfight->ahp, pfight->afp,
+                            pfight->ds, pfight->dhp, pfight->dfp);
+        }
+      }
+      timer_stop(t);
+      ns = timer_read_seconds(t) * 1e9 / (REPEAT * QUERIES);
+      if (0 > best || ns < best) {
+        best = ns;
+      }
+    }
+    printf("%8d %8.1f\n", matchups[i], best);
+  }
+
+  timer_destroy(t);
+
+  /* Use the results, so that the calls are not optimized away. */
+  return 0.0 < sum ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,160 @@
+/**********************************************************************
+ Freeciv - Copyright (C) 1996 - A Kjeldberg, L Gregersen, P Unold
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+***********************************************************************/
+
+/* Micro-benchmark of the generic hash table, run by "make benchmark".
+
+   For tables of several sizes, with pointer keys (addresses of
+   allocated blocks) and with small integer keys (like unit and city
+   ids), it prints the time of a successful lookup, of a failed lookup
+   and of inserting and removing a key again, in nanoseconds. Each time
+   is the fastest of BATCHES batches of LOOKUPS operations. */
+
+#ifdef HAVE_CONFIG_H
+#include <fc_config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* utility */
+#include "genhash.h"
+#include "mem.h"
+#include "rand.h"
+#include "shared.h"
+#include "timing.h"
+
+#define BATCHES 20
+#define LOOKUPS 200000
+
+/**********************************************************************
+  Return the time of 'count' operations in the batch measured by 't' in
+  nanoseconds per operation.
+***********************************************************************/
+static double ns_per_op(struct timer *t, int count)
+{
+  return timer_read_seconds(t) * 1e9 / count;
+}
+
+/**********************************************************************
+  Measure a table of 'num' keys, either pointers or small integers.
+  Returns the number of keys found, so that the lookups are not
+  optimized away.
+***********************************************************************/
+static unsigned long bench_table(int num, bool ptr_keys)
+{
+  void **keys = fc_malloc(num * sizeof(*keys));
+  int *order = fc_malloc(num * sizeof(*order));
+  struct genhash *hash = genhash_new(NULL, NULL);
+  struct timer *t = timer_new(TIMER_USER, TIMER_ACTIVE);
+  double hit = -1.0, miss = -1.0, change = -1.0;
+  unsigned long found = 0;
+  int rounds = MAX(1, LOOKUPS / num);
+  int batch, i, j;
+
+  for (i = 0; i < num; i++) {
+    keys[i] = ptr_keys ? fc_malloc(24 + fc_rand(40))
+                       : FC_INT_TO_PTR(3 * i + 3);
+    order[i] = i;
+  }
+  /* Look the keys up in random order. */
+  for (i = num - 1; i > 0; i--) {
+    int k = fc_rand(i + 1), tmp = order[i];
+
+    order[i] = order[k];
+    order[k] = tmp;
+  }
+  for (i = 0; i < num; i++) {
+    genhash_insert(hash, keys[i], order + i);
+  }
+
+  for (batch = 0; batch < BATCHES; batch++) {
+    void *data;
+
+    timer_clear(t);
+    timer_start(t);
+    for (j = 0; j < LOOKUPS; j++) {
+      found += genhash_lookup(hash, keys[order[j % num]], &data);
+    }
+    timer_stop(t);
+    if (0 > hit || ns_per_op(t, LOOKUPS) < hit) {
+      hit = ns_per_op(t, LOOKUPS);
+    }
+
+    /* Neither key + 1 of a block nor 3 * i + 4 is a key. */
+    timer_clear(t);
+    timer_start(t);
+    for (j = 0; j < LOOKUPS; j++) {
+      found += genhash_lookup(hash, (char *) keys[order[j % num]] + 1,
+                              &data);
+    }
+    timer_stop(t);
+    if (0 > miss || ns_per_op(t, LOOKUPS) < miss) {
+      miss = ns_per_op(t, LOOKUPS);
+    }
+
+    timer_clear(t);
+    timer_start(t);
+    for (j = 0; j < rounds; j++) {
+      struct genhash *other = genhash_new(NULL, NULL);
+
+      for (i = 0; i < num; i++) {
+        genhash_insert(other, keys[i], NULL);
+      }
+      for (i = 0; i < num; i++) {
+        genhash_remove(other, keys[i]);
+      }
+      genhash_destroy(other);
+    }
+    timer_stop(t);
+    if (0 > change || ns_per_op(t, rounds * num) < change) {
+      change = ns_per_op(t, rounds * num);
+    }
+  }
+
+  printf("%7d %-8s %8.1f %8.1f %14.1f\n", num,
+         ptr_keys ? "pointer" : "integer", hit, miss, change);
+
+  timer_destroy(t);
+  genhash_destroy(hash);
+  if (ptr_keys) {
+    for (i = 0; i < num; i++) {
+      free(keys[i]);
+    }
+  }
+  free(order);
+  free(keys);
+
+  return found;
+}
+
+/**********************************************************************
+  Entry point.
+***********************************************************************/
+int main(int argc, char **argv)
+{
+  const int sizes[] = { 10, 100, 1000, 20000 };
+  unsigned long found = 0;
+  int i;
+
+  fc_srand(1);
+
+  printf("genhash, nanoseconds per operation\n");
+  printf("%7s %-8s %8s %8s %14s\n", "keys", "type", "hit", "miss",
+         "insert+remove");
+  for (i = 0; i < ARRAY_SIZE(sizes); i++) {
+    found += bench_table(sizes[i], TRUE);
+    found += bench_table(sizes[i], FALSE);
+  }
+
+  return 0 < found ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,209 @@
+#!/bin/bash
+
+# Measure how the server copes with many connected observers.
+#
+# Usage: loadtest.sh <top_srcdir> <top_builddir> [clients] [turns]
+#
+# An AI-only game is played for 'turns' turns (default 10) twice from
+# the same seeds: once without clients and once with 'clients' observer
+# connections (default 100). The observers are simulated by this script:
+# each one opens a TCP connection, sends the join request and the
+# "/observe" command and then only reads what the server sends. They
+# never answer pings, so 'pingtimeout' is raised for the game, and all
+# connect from localhost, so 'maxconnectionsperhost' is lifted. The
+# server takes at most 256 connections. Like any game without human
+# players it runs with 'timeout' -1, so the server only waits for the
+# network when its send buffers are full.
+#
+# For every game the time spent in the turns (as reported by the
+# 'perflog' setting) and the number of packets and bytes sent per turn
+# are printed. Everything the server sent to the first observer is kept
+# in observer0.stream in the directory of the game, to be replayed by
+# the stub client (see replay_benchmark.sh).
+#
+# The observers are written to bash's /dev/tcp, so this needs bash.
+
+top_srcdir=$1
+top_builddir=$2
+clients=${3:-100}
+turns=${4:-10}
+
+# The server runs in the directory of each game.
+top_srcdir=`cd "$top_srcdir" && pwd`
+top_builddir=`cd "$top_builddir" && pwd`
+
+server="$top_builddir/server/freeciv-server"
+port=${LOADTEST_PORT:-5598}
+workdir=`pwd`/loadtest-out
+
+FREECIV_DATA_PATH="$top_builddir/data:$top_srcdir/data"
+export FREECIV_DATA_PATH
+
+if test ! -x "$server"; then
+  echo "$server not found; build the server first." >&2
+  exit 1
+fi
+
+# The capability string the server accepts, from fc_version.
+capstr=`. "$top_srcdir/fc_version" >/dev/null 2>&1;
+        echo "$NETWORK_CAPSTRING_MANDATORY $NETWORK_CAPSTRING_OPTIONAL"`
+version=`. "$top_srcdir/fc_version" >/dev/null 2>&1;
+         echo "$MAJOR_VERSION $MINOR_VERSION $PATCH_VERSION"`
+if test -z "$version"; then
+  echo "$top_srcdir/fc_version not found." >&2
+  exit 1
+fi
+
+# Print the bytes of the packet of type $1 with the body read from
+# stdin, as printf escapes. The header is the 16 bit length (including
+# the header) and the 8 bit type.
+packet() {
+  od -An -v -tx1 | awk -v type=$1 '
+    { for (i = 1; i <= NF; i++) { body = body "\\x" $i; n++ } }
+    END {
+      len = n + 3
+      printf "\\x%02x\\x%02x\\x%02x%s", int(len / 256), len % 256, type, body
+    }'
+}
+
+# Print the body of a 32 bit unsigned integer $1.
+uint32() {
+  printf '\\x%02x\\x%02x\\x%02x\\x%02x' \
+         $(($1 >> 24 & 255)) $(($1 >> 16 & 255)) $(($1 >> 8 & 255)) \
+         $(($1 & 255))
+}
+
+# Connect observer number $1 on file descriptor $2. What the server
+# sends is written to the file $3.
+observer() {
+  stream=$3
+  set -- $1 $2 $version
+  # PACKET_SERVER_JOIN_REQ: username, capability, version label,
+  # major, minor and patch version.
+  join=$({ printf "obs%d\0%s\0\0" $1 "$capstr"
+           printf "$(uint32 $3)$(uint32 $4)$(uint32 $5)"; } | packet 4)
+  # PACKET_CHAT_MSG_REQ: delta bit vector with the message field set.
+  chat=`printf "\001/observe\0" | packet 26`
+
+  eval "exec $2<>/dev/tcp/localhost/$port" || return 1
+  printf "$join$chat" >&$2
+  eval "cat <&$2 >\"\$stream\" 2>/dev/null &"
+  readers="$readers $!"
+}
+
+# Play the game in directory $1 with $2 observers.
+run_game() {
+  dir=$1
+  mkdir -p "$dir"
+  (echo "set gameseed 42"
+   echo "set mapseed 42"
+   echo "set size 4"
+   echo "set minplayers 0"
+   echo "set aifill 10"
+   echo "set endturn $turns"
+   echo "set timeout -1"
+   echo "set pingtimeout 1800"
+   echo "set maxconnectionsperhost 0"
+   echo "set perflog enabled"
+   echo "set perffile perf.csv"
+   echo "set autosaves \"\""
+   echo "hard") > "$dir/load.serv"
+
+  rm -f "$dir/input"
+  mkfifo "$dir/input" || return 1
+  (cd "$dir" && "$server" -p $port -e -r load.serv \
+     <input >server.log 2>&1) &
+  srv=$!
+  exec 9>"$dir/input"
+
+  # Wait for the server to listen.
+  tries=0
+  while ! (exec 8<>/dev/tcp/localhost/$port) 2>/dev/null; do
+    tries=`expr $tries + 1`
+    if test $tries -gt 100 || ! kill -0 $srv 2>/dev/null; then
+      echo "The server didn't start; see $dir/server.log." >&2
+      exec 9>&-
+      kill $srv 2>/dev/null
+      return 1
+    fi
+    sleep 0.1
+  done
+
+  fd=10
+  i=0
+  readers=""
+  while test $i -lt $2; do
+    if test $i -eq 0; then
+      out="$dir/observer0.stream"
+    else
+      out=/dev/null
+    fi
+    observer $i $fd "$out" || break
+    fd=`expr $fd + 1`
+    i=`expr $i + 1`
+  done
+  if test $i -lt $2; then
+    echo "Only $i of $2 observers could connect." >&2
+  fi
+  # Each join sends the rulesets, so give the server time to catch up.
+  tries=0
+  while observing=`grep -c "now observes" "$dir/server.log"`; \
+        test $observing -lt $i && test $tries -lt 600; do
+    tries=`expr $tries + 1`
+    sleep 0.1
+  done
+  if test $observing -lt $i; then
+    echo "Only $observing of $i observers were accepted." >&2
+  fi
+
+  echo "start" >&9
+
+  # The server waits for the observers to leave after the game; perflog
+  # writes one row per turn, from turn 0 to the end turn.
+  while kill -0 $srv 2>/dev/null \
+        && test `cat "$dir/perf.csv" 2>/dev/null | wc -l` -le `expr $turns + 1`; do
+    sleep 1
+  done
+  exec 9>&-
+  fd=10
+  while test $fd -lt `expr 10 + $i`; do
+    eval "exec $fd>&-"
+    fd=`expr $fd + 1`
+  done
+  kill $readers 2>/dev/null
+  wait
+
+  if test ! -f "$dir/perf.csv"; then
+    echo "The game failed; see $dir/server.log." >&2
+    return 1
+  fi
+
+  # perf.csv columns: game, turn, begin_turn, begin_phase, sniff,
+  # end_phase, end_turn, ai, allocs, cm_queries, cm_cache_hits, pf_maps,
+  # packets, packet_bytes, ...
+  awk -F, -v obs=$observing '
+    NR > 1 {
+      n++
+      total += $3 + $4 + $5 + $6 + $7; sn += $5
+      packets += $13; bytes += $14
+    }
+    END {
+      if (n == 0) {
+        exit 1
+      }
+      printf "%9d %5d %8.2f %8.3f %8.2f %10d %12d\n",
+             obs, n, total, total / n, sn, packets / n, bytes / n
+    }' "$dir/perf.csv"
+}
+
+rm -rf "$workdir"
+mkdir -p "$workdir" || exit 1
+
+printf "%9s %5s %8s %8s %8s %10s %12s\n" \
+       observers turns seconds sec/turn sniff packets/t bytes/t
+status=0
+for n in 0 $clients; do
+  run_game "$workdir/obs-$n" $n || status=1
+done
+
+exit $status
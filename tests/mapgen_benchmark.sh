@@ -0,0 +1,96 @@
+#!/bin/sh
+
+# Measure how fast the server generates maps.
+#
+# Usage: mapgen_benchmark.sh <top_srcdir> <top_builddir> [maps] [size]
+#                            [generator...]
+#
+# For every generator (default RANDOM and FRACTAL) 'maps' maps (default
+# 10) of 'size' thousand tiles (default 16) are generated from fixed map
+# seeds with the server's --genmaps mode, in a single process.
+#
+# For every generator the number of maps, the map size, the total, the
+# fastest and the mean time of map_fractal_generate() and a hash of all
+# generated maps are printed. The hash only depends on the seeds, so it
+# must not change when the generator is only made faster.
+
+top_srcdir=$1
+top_builddir=$2
+maps=${3:-10}
+size=${4:-16}
+if test $# -gt 4; then
+  shift 4
+  generators="$*"
+else
+  generators="RANDOM FRACTAL"
+fi
+
+# The server runs in the directory of each generator.
+top_srcdir=`cd "$top_srcdir" && pwd`
+top_builddir=`cd "$top_builddir" && pwd`
+
+server="$top_builddir/server/freeciv-server"
+workdir=`pwd`/mapgen-benchmark-out
+
+FREECIV_DATA_PATH="$top_builddir/data:$top_srcdir/data"
+export FREECIV_DATA_PATH
+
+if test ! -x "$server"; then
+  echo "$server not found; build the server first." >&2
+  exit 1
+fi
+
+if which md5sum >/dev/null 2>&1; then
+  hash_cmd=md5sum
+elif which sha1sum >/dev/null 2>&1; then
+  hash_cmd=sha1sum
+else
+  hash_cmd=cksum
+fi
+
+rm -rf "$workdir"
+mkdir -p "$workdir" || exit 1
+
+printf "%-10s %5s %6s %8s %8s %8s  %s\n" \
+       generator maps tiles seconds fastest mean hash
+status=0
+for generator in $generators; do
+  dir="$workdir/$generator"
+  mkdir -p "$dir"
+  (echo "set mapseed 42"
+   echo "set size $size"
+   echo "set generator $generator"
+   echo "set compresstype PLAIN"
+   echo "set savename map") > "$dir/mapgen.serv"
+  # The time of every map is logged at verbose level.
+  if ! (cd "$dir" && "$server" -d 3 -r mapgen.serv --genmaps $maps \
+          </dev/null >server.log 2>&1); then
+    echo "$generator: map generation failed; see $dir/server.log." >&2
+    status=1
+    continue
+  fi
+
+  # The saves hold the time of saving, so hash only the map sections.
+  hash=`for save in "$dir"/map-seed*.sav; do
+          sed -n '/^\[map\]/,/^\[/p' "$save"
+        done | $hash_cmd | cut -d' ' -f1`
+
+  sed -n 's/.*Map generation (\([0-9]*\)x\([0-9]*\)) took \([0-9.]*\) seconds.*/\1 \2 \3/p' \
+      "$dir/server.log" \
+    | awk -v gen=$generator -v hash=$hash '
+        {
+          n++; total += $3; tiles = $1 * $2
+          if (n == 1 || $3 < fastest) {
+            fastest = $3
+          }
+        }
+        END {
+          if (n == 0) {
+            exit 1
+          }
+          printf "%-10s %5d %6d %8.3f %8.3f %8.3f  %s\n",
+                 gen, n, tiles, total, fastest, total / n, hash
+        }' || status=1
+done
+
+exit $status
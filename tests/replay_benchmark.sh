@@ -0,0 +1,75 @@
+#!/bin/sh
+
+# Measure how fast the client handles what the server sends.
+#
+# Usage: replay_benchmark.sh <top_srcdir> <top_builddir> [turns] [replays]
+#
+# loadtest.sh plays an AI-only game of 'turns' turns (default 20) with
+# one observer and keeps everything the server sent to it. The stub
+# client (configure --enable-client=stub) then handles this packet
+# stream 'replays' times (default 3) with its --replay option, without a
+# server. The map view is drawn as usual, but to no canvas.
+#
+# For every replay the size of the stream, the CPU time the client took,
+# the number of memory allocations and of the sprites put on the map
+# view are printed, and at the end the fastest replay. The stream only depends on the seeds, so the same
+# stream is replayed before and after a change of the client.
+
+top_srcdir=$1
+top_builddir=$2
+turns=${3:-20}
+replays=${4:-3}
+
+# The client runs in the output directory.
+top_srcdir=`cd "$top_srcdir" && pwd`
+top_builddir=`cd "$top_builddir" && pwd`
+testdir=`dirname "$0"`
+testdir=`cd "$testdir" && pwd`
+
+client="$top_builddir/client/freeciv-stub"
+workdir=`pwd`/replay-benchmark-out
+stream="$workdir/loadtest-out/obs-1/observer0.stream"
+
+FREECIV_DATA_PATH="$top_builddir/data:$top_srcdir/data"
+export FREECIV_DATA_PATH
+
+if test ! -x "$client"; then
+  echo "$client not found; configure with --enable-client=stub." >&2
+  exit 1
+fi
+
+rm -rf "$workdir"
+mkdir -p "$workdir" || exit 1
+
+if ! (cd "$workdir" \
+      && "$testdir/loadtest.sh" "$top_srcdir" "$top_builddir" 1 $turns \
+           >loadtest.log 2>&1) \
+   || test ! -s "$stream"; then
+  echo "The game failed; see $workdir/loadtest.log." >&2
+  exit 1
+fi
+
+printf "%6s %10s %8s %12s %10s\n" replay bytes seconds allocations sprites
+status=0
+i=1
+while test $i -le $replays; do
+  # The client keeps its options in the home directory.
+  if ! (cd "$workdir" && HOME="$workdir" \
+          "$client" -- --replay "$stream" >replay-$i.log 2>&1); then
+    echo "Replay $i failed; see $workdir/replay-$i.log." >&2
+    status=1
+    break
+  fi
+  # "<stream>: <bytes> bytes in <seconds> seconds, <allocations>
+  # allocations, <sprites> sprites drawn"
+  awk -v i=$i '/ bytes in / {
+      printf "%6d %10d %8.3f %12d %10d\n", i, $2, $5, $7, $9
+    }' "$workdir/replay-$i.log"
+  i=`expr $i + 1`
+done
+
+awk '/ bytes in / { if (n++ == 0 || $5 < best) { best = $5 } }
+     END { if (n > 0) { printf "fastest %.3f seconds\n", best } }' \
+    "$workdir"/replay-*.log
+
+exit $status
@@ -30,9 +30,10 @@
    a key type.  See further comments below.)
 
    User-supplied functions required are:
-   key_val_func: map key to bucket number given number of buckets; should
-                 map keys fairly evenly to range 0 to (num_buckets - 1)
-                 inclusive.
+   key_val_func: map key to a hash value; keys which are different should
+                 map to different values as much as possible. The value
+                 is mixed before being used, so it does not need to be
+                 evenly distributed.
 
    key_comp_func: compare keys for equality, necessary for lookups for keys
                   which map to the same genhash value. Keys which compare
@@ -50,9 +51,16 @@
    data_copy_func: same as 'key_copy_func', but for data.
    data_free_func: same as 'key_free_func', but for data.
 
-   Implementation uses open hashing. Collision resolution is done by
-   separate chaining with linked lists. Resize hash table when deemed
-   necessary by making and populating a new table.
+   Implementation uses open addressing: the entries are stored directly in
+   the bucket array, so no memory is allocated per entry. Next to the
+   buckets, a control byte per bucket tells whether it is empty, was
+   deleted, or holds an entry, in which case it also stores 7 bits of the
+   (mixed) hash value of the entry. Buckets are probed by groups of 8: the
+   8 control bytes of a group are tested at once as a 64 bit word, and the
+   keys are only compared for buckets whose control byte matches. Probing
+   goes on with the next group until a group with an empty bucket is
+   found. The number of buckets is a power of 2. Resize hash table when
+   deemed necessary by making and populating a new table.
 ****************************************************************************/
 
 #ifdef HAVE_CONFIG_H
@@ -72,30 +80,45 @@
 #define FULL_RATIO 0.75         /* consider expanding when above this */
 #define MIN_RATIO 0.24          /* shrink when below this */
 
+/* Values of the control byte of a bucket. A bucket holding an entry has
+ * the top bit clear, and the low 7 bits of the mixed hash value in the
+ * others. */
+#define CTRL_EMPTY      0x80
+#define CTRL_DELETED    0xfe
+#define CTRL_IS_FULL(c) (0 == ((c) & 0x80))
+
+/* Control bytes of a group of buckets, tested together. */
+typedef uint64_t genhash_group_t;
+#define GROUP_SIZE 8
+#define GROUP_LSBS 0x0101010101010101ULL
+#define GROUP_MSBS 0x8080808080808080ULL
+
 struct genhash_entry {
   void *key;
   void *data;
   genhash_val_t hash_val;
-  struct genhash_entry *next;
 };
 
 /* Contents of the opaque type: */
 struct genhash {
-  struct genhash_entry **buckets;
+  unsigned char *ctrl;          /* One control byte per bucket. */
+  struct genhash_entry *buckets;
   genhash_val_fn_t key_val_func;
   genhash_comp_fn_t key_comp_func;
   genhash_copy_fn_t key_copy_func;
   genhash_free_fn_t key_free_func;
   genhash_copy_fn_t data_copy_func;
   genhash_free_fn_t data_free_func;
-  size_t num_buckets;
+  size_t num_buckets;           /* Always a power of 2... */
+  unsigned int shift;           /* ...2 ^ (32 - shift). */
   size_t num_entries;
+  size_t num_deleted;           /* Buckets marked CTRL_DELETED. */
   bool no_shrink;               /* Do not auto-shrink when set. */
 };
 
 struct genhash_iter {
   struct iterator vtable;
-  struct genhash_entry *const *bucket, *const *end;
+  const unsigned char *ctrl, *end;
   const struct genhash_entry *iterator;
 };
 
@@ -104,7 +127,6 @@ struct genhash_iter {
 
 /****************************************************************************
   A supplied genhash function appropriate to nul-terminated strings.
-  Prefers table sizes that are prime numbers.
 ****************************************************************************/
 genhash_val_t genhash_str_val_func(const void *vkey)
 {
@@ -146,11 +168,10 @@ void genhash_str_free_func(void *vkey)
   free(vkey);
 }
 
-
 /****************************************************************************
   Calculate a "reasonable" number of buckets for a given number of entries.
-  Gives a prime number far from powers of 2, allowing at least a factor of
-  2 from the given number of entries for breathing room.
+  Gives a power of 2, allowing at least a factor of 2 from the given number
+  of entries for breathing room.
 
   Generalized restrictions on the behavior of this function:
   * MIN_BUCKETS <= genhash_calc_num_buckets(x)
@@ -160,35 +181,33 @@ void genhash_str_free_func(void *vkey)
   This one is more of a recommendation, to ensure enough free space:
   * genhash_calc_num_buckets(x) >= 2 * x.
 ****************************************************************************/
-#define MIN_BUCKETS 29  /* Historical purposes. */
+#define MIN_BUCKETS 16  /* At least one group. */
 static size_t genhash_calc_num_buckets(size_t num_entries)
 {
-  /* A bunch of prime numbers close to successive elements of the sequence
-   * A_n = 3 * 2 ^ n; to be used for table sizes. */
-  static const size_t sizes[] = {
-    MIN_BUCKETS,          53,         97,           193,
-    389,       769,       1543,       3079,         6151,
-    12289,     24593,     49157,      98317,        196613,
-    393241,    786433,    1572869,    3145739,      6291469,
-    12582917,  25165843,  50331653,   100663319,    201326611,
-    402653189, 805306457, 1610612741, 3221225473ul, 4294967291ul
-  };
-  const size_t *pframe = sizes, *pmid;
-  int fsize = ARRAY_SIZE(sizes) - 1, lpart;
+  size_t num_buckets = MIN_BUCKETS;
 
   num_entries <<= 1; /* breathing room */
 
-  while (fsize > 0) {
-    lpart = fsize >> 1;
-    pmid = pframe + lpart;
-    if (*pmid < num_entries) {
-      pframe = pmid + 1;
-      fsize = fsize - lpart - 1;
-    } else {
-      fsize = lpart;
-    }
+  while (num_buckets < num_entries) {
+    num_buckets <<= 1;
+  }
+  return num_buckets;
+}
+
+/****************************************************************************
+  Allocate the buckets of a table, all empty.
+****************************************************************************/
+static void genhash_alloc_buckets(struct genhash *pgenhash,
+                                  size_t num_buckets)
+{
+  pgenhash->ctrl = fc_malloc(num_buckets);
+  memset(pgenhash->ctrl, CTRL_EMPTY, num_buckets);
+  pgenhash->buckets = fc_malloc(num_buckets * sizeof(*pgenhash->buckets));
+  pgenhash->num_buckets = num_buckets;
+  pgenhash->num_deleted = 0;
+  for (pgenhash->shift = 32; num_buckets > 1; num_buckets >>= 1) {
+    pgenhash->shift--;
   }
-  return *pframe;
 }
 
 /****************************************************************************
@@ -214,14 +233,13 @@ genhash_new_nbuckets(genhash_val_fn_t key_val_func,
   log_debug("New genhash table with %lu buckets",
             (long unsigned) num_buckets);
 
-  pgenhash->buckets = fc_calloc(num_buckets, sizeof(*pgenhash->buckets));
+  genhash_alloc_buckets(pgenhash, num_buckets);
   pgenhash->key_val_func = key_val_func;
   pgenhash->key_comp_func = key_comp_func;
   pgenhash->key_copy_func = key_copy_func;
   pgenhash->key_free_func = key_free_func;
   pgenhash->data_copy_func = data_copy_func;
   pgenhash->data_free_func = data_free_func;
-  pgenhash->num_buckets = num_buckets;
   pgenhash->num_entries = 0;
   pgenhash->no_shrink = FALSE;
 
@@ -297,38 +315,160 @@ void genhash_destroy(struct genhash *pgenhash)
   fc_assert_ret(NULL != pgenhash);
   pgenhash->no_shrink = TRUE;
   genhash_clear(pgenhash);
+  free(pgenhash->ctrl);
   free(pgenhash->buckets);
   free(pgenhash);
 }
 
 
 /****************************************************************************
-  Resize the genhash table: relink entries.
+  Mix the bits of a hash value (Fibonacci hashing), so that its high bits
+  depend on all the bits of the value. Hash values of pointers or small
+  integers are far from evenly distributed otherwise.
+****************************************************************************/
+static inline uint32_t genhash_mix(genhash_val_t hash_val)
+{
+  return (uint32_t) hash_val * 0x9e3779b9u;
+}
+
+/****************************************************************************
+  Control byte of the buckets holding an entry with this (mixed) hash
+  value: the 7 bits just below the ones used for the bucket index.
+****************************************************************************/
+static inline unsigned char genhash_ctrl(const struct genhash *pgenhash,
+                                         uint32_t mixed)
+{
+  return (pgenhash->shift >= 7
+          ? mixed >> (pgenhash->shift - 7) : mixed) & 0x7f;
+}
+
+/****************************************************************************
+  Load the control bytes of the group starting at bucket 'i', the first
+  bucket being in the lowest byte.
+****************************************************************************/
+static inline genhash_group_t genhash_group_load(const struct genhash *pgenhash,
+                                                 size_t i)
+{
+  genhash_group_t group;
+
+  memcpy(&group, pgenhash->ctrl + i, sizeof(group));
+#ifdef WORDS_BIGENDIAN
+  group = ((group & 0x00000000ffffffffULL) << 32)
+          | ((group & 0xffffffff00000000ULL) >> 32);
+  group = ((group & 0x0000ffff0000ffffULL) << 16)
+          | ((group & 0xffff0000ffff0000ULL) >> 16);
+  group = ((group & 0x00ff00ff00ff00ffULL) << 8)
+          | ((group & 0xff00ff00ff00ff00ULL) >> 8);
+#endif /* WORDS_BIGENDIAN */
+  return group;
+}
+
+/****************************************************************************
+  Returns a mask with the top bit set in the bytes of the group equal to
+  'ctrl'. It may also have false positives, just above a true match, so
+  the entries must still be checked.
+****************************************************************************/
+static inline genhash_group_t genhash_group_match(genhash_group_t group,
+                                                  unsigned char ctrl)
+{
+  genhash_group_t cmp = group ^ (GROUP_LSBS * ctrl);
+
+  return (cmp - GROUP_LSBS) & ~cmp & GROUP_MSBS;
+}
+
+/****************************************************************************
+  Returns a mask with the top bit set in the bytes of the group which are
+  CTRL_EMPTY.
+****************************************************************************/
+static inline genhash_group_t genhash_group_match_empty(genhash_group_t group)
+{
+  return group & ~(group << 6) & GROUP_MSBS;
+}
+
+/****************************************************************************
+  Returns a mask with the top bit set in the bytes of the group which do
+  not hold an entry.
+****************************************************************************/
+static inline genhash_group_t genhash_group_match_free(genhash_group_t group)
+{
+  return group & GROUP_MSBS;
+}
+
+/****************************************************************************
+  Index in the group of the first bucket set in a non-empty mask.
+****************************************************************************/
+static inline size_t genhash_group_first(genhash_group_t mask)
+{
+#ifdef __GNUC__
+  return __builtin_ctzll(mask) >> 3;
+#else
+  size_t i = 0;
+
+  while (0 == (mask & 0x80)) {
+    mask >>= 8;
+    i++;
+  }
+  return i;
+#endif /* __GNUC__ */
+}
+
+/****************************************************************************
+  Index of the first group to probe for this (mixed) hash value. The next
+  ones follow, wrapping around at the end of the table.
+****************************************************************************/
+static inline size_t genhash_group_start(const struct genhash *pgenhash,
+                                         uint32_t mixed)
+{
+  return (mixed >> pgenhash->shift) & ~(size_t) (GROUP_SIZE - 1);
+}
+
+/****************************************************************************
+  Return the index of the first bucket which is not used by an entry
+  (empty or deleted) in the probe sequence of this hash value.
+****************************************************************************/
+static inline size_t genhash_free_slot(const struct genhash *pgenhash,
+                                       genhash_val_t hash_val)
+{
+  const size_t mask = pgenhash->num_buckets - 1;
+  size_t i = genhash_group_start(pgenhash, genhash_mix(hash_val));
+  genhash_group_t free_mask;
+
+  for (;;) {
+    free_mask = genhash_group_match_free(genhash_group_load(pgenhash, i));
+    if (0 != free_mask) {
+      return i + genhash_group_first(free_mask);
+    }
+    i = (i + GROUP_SIZE) & mask;
+  }
+}
+
+/****************************************************************************
+  Resize the genhash table: reinsert entries. The deleted buckets are
+  dropped in the process.
 ****************************************************************************/
 static void genhash_resize_table(struct genhash *pgenhash,
                                  size_t new_nbuckets)
 {
-  struct genhash_entry **new_buckets, **bucket, **end, **slot;
-  struct genhash_entry *iter, *next;
+  unsigned char *old_ctrl = pgenhash->ctrl;
+  struct genhash_entry *old_buckets = pgenhash->buckets;
+  size_t old_nbuckets = pgenhash->num_buckets;
+  size_t i, slot;
 
   fc_assert(new_nbuckets >= pgenhash->num_entries);
 
-  new_buckets = fc_calloc(new_nbuckets, sizeof(*pgenhash->buckets));
+  genhash_alloc_buckets(pgenhash, new_nbuckets);
 
-  bucket = pgenhash->buckets;
-  end = bucket + pgenhash->num_buckets;
-  for (; bucket < end; bucket++) {
-    for (iter = *bucket; NULL != iter; iter = next) {
-      slot = new_buckets + (iter->hash_val % new_nbuckets);
-      next = iter->next;
-      iter->next = *slot;
-      *slot = iter;
+  for (i = 0; i < old_nbuckets; i++) {
+    if (CTRL_IS_FULL(old_ctrl[i])) {
+      slot = genhash_free_slot(pgenhash, old_buckets[i].hash_val);
+      pgenhash->ctrl[slot] =
+          genhash_ctrl(pgenhash, genhash_mix(old_buckets[i].hash_val));
+      pgenhash->buckets[slot] = old_buckets[i];
     }
   }
 
-  free(pgenhash->buckets);
-  pgenhash->buckets = new_buckets;
-  pgenhash->num_buckets = new_nbuckets;
+  free(old_ctrl);
+  free(old_buckets);
 }
 
 /****************************************************************************
@@ -349,7 +489,7 @@ static bool genhash_maybe_resize(struct genhash *pgenhash, bool expandingp)
   }
   if (expandingp) {
     limit = FULL_RATIO * pgenhash->num_buckets;
-    if (pgenhash->num_entries < limit) {
+    if (pgenhash->num_entries + pgenhash->num_deleted < limit) {
       return FALSE;
     }
   } else {
@@ -392,33 +532,48 @@ static inline genhash_val_t genhash_val_calc(const struct genhash *pgenhash,
 }
 
 /****************************************************************************
-  Return slot (entry pointer) in genhash table where key resides, or where
-  it should go if it is to be a new key.
+  Return the entry in genhash table where key resides, or NULL if the key
+  is not in the table.
 ****************************************************************************/
-static inline struct genhash_entry **
+static inline struct genhash_entry *
 genhash_slot_lookup(const struct genhash *pgenhash,
                     const void *key,
                     genhash_val_t hash_val)
 {
-  struct genhash_entry **slot;
   genhash_comp_fn_t key_comp_func = pgenhash->key_comp_func;
-
-  slot = pgenhash->buckets + (hash_val % pgenhash->num_buckets);
-  if (NULL != key_comp_func) {
-    for (; NULL != *slot; slot = &(*slot)->next) {
-      if (hash_val == (*slot)->hash_val
-          && key_comp_func((*slot)->key, key)) {
-        return slot;
+  const size_t mask = pgenhash->num_buckets - 1;
+  const uint32_t mixed = genhash_mix(hash_val);
+  const unsigned char ctrl = genhash_ctrl(pgenhash, mixed);
+  size_t i = genhash_group_start(pgenhash, mixed);
+  genhash_group_t group, match;
+  struct genhash_entry *entry;
+
+  /* There is always at least one empty bucket, see
+   * genhash_maybe_resize(). */
+  for (;;) {
+    group = genhash_group_load(pgenhash, i);
+    match = genhash_group_match(group, ctrl);
+    if (NULL == key_comp_func) {
+      for (; 0 != match; match &= match - 1) {
+        entry = pgenhash->buckets + i + genhash_group_first(match);
+        if (key == entry->key) {
+          return entry;
+        }
       }
-    }
-  } else {
-    for (; NULL != *slot; slot = &(*slot)->next) {
-      if (key == (*slot)->key) {
-        return slot;
+    } else {
+      for (; 0 != match; match &= match - 1) {
+        entry = pgenhash->buckets + i + genhash_group_first(match);
+        if (hash_val == entry->hash_val
+            && key_comp_func(entry->key, key)) {
+          return entry;
+        }
       }
     }
+    if (0 != genhash_group_match_empty(group)) {
+      return NULL;
+    }
+    i = (i + GROUP_SIZE) & mask;
   }
-  return slot;
 }
 
 /****************************************************************************
@@ -437,11 +592,9 @@ static inline void genhash_default_get(void **pkey, void **data)
 /****************************************************************************
   Function to store data.
 ****************************************************************************/
-static inline void genhash_slot_get(struct genhash_entry *const *slot,
+static inline void genhash_slot_get(const struct genhash_entry *entry,
                                     void **pkey, void **data)
 {
-  const struct genhash_entry *entry = *slot;
-
   if (NULL != pkey) {
     *pkey = entry->key;
   }
@@ -451,57 +604,70 @@ static inline void genhash_slot_get(struct genhash_entry *const *slot,
 }
 
 /****************************************************************************
-  Create the entry and call the copy callbacks.
+  Create the entry and call the copy callbacks. The key must not be in the
+  table yet.
 ****************************************************************************/
 static inline void genhash_slot_create(struct genhash *pgenhash,
-                                       struct genhash_entry **slot,
                                        const void *key, const void *data,
                                        genhash_val_t hash_val)
 {
-  struct genhash_entry *entry = fc_malloc(sizeof(*entry));
+  size_t slot = genhash_free_slot(pgenhash, hash_val);
+  struct genhash_entry *entry = pgenhash->buckets + slot;
 
+  if (CTRL_DELETED == pgenhash->ctrl[slot]) {
+    pgenhash->num_deleted--;
+  }
+  pgenhash->ctrl[slot] = genhash_ctrl(pgenhash, genhash_mix(hash_val));
   entry->key = (NULL != pgenhash->key_copy_func
                 ? pgenhash->key_copy_func(key) : (void *) key);
   entry->data = (NULL != pgenhash->data_copy_func
                  ? pgenhash->data_copy_func(data) : (void *) data);
   entry->hash_val = hash_val;
-  entry->next = *slot;
-  *slot = entry;
 }
 
 /****************************************************************************
-  Free the entry slot and call the free callbacks.
+  Call the free callbacks on the entry.
 ****************************************************************************/
-static inline void genhash_slot_free(struct genhash *pgenhash,
-                                     struct genhash_entry **slot)
+static inline void genhash_entry_free(struct genhash *pgenhash,
+                                      struct genhash_entry *entry)
 {
-  struct genhash_entry *entry = *slot;
-
   if (NULL != pgenhash->key_free_func) {
     pgenhash->key_free_func(entry->key);
   }
   if (NULL != pgenhash->data_free_func) {
     pgenhash->data_free_func(entry->data);
   }
-  *slot = entry->next;
-  free(entry);
+}
+
+/****************************************************************************
+  Free the entry slot and call the free callbacks.
+****************************************************************************/
+static inline void genhash_slot_free(struct genhash *pgenhash,
+                                     struct genhash_entry *entry)
+{
+  size_t slot = entry - pgenhash->buckets;
+  size_t group = slot & ~(size_t) (GROUP_SIZE - 1);
+
+  genhash_entry_free(pgenhash, entry);
+
+  /* If the group has an empty bucket, probing never goes past it, so this
+   * one can be empty too. */
+  if (0 != genhash_group_match_empty(genhash_group_load(pgenhash, group))) {
+    pgenhash->ctrl[slot] = CTRL_EMPTY;
+  } else {
+    pgenhash->ctrl[slot] = CTRL_DELETED;
+    pgenhash->num_deleted++;
+  }
 }
 
 /****************************************************************************
   Clear previous values (with free callback) and call the copy callbacks.
 ****************************************************************************/
 static inline void genhash_slot_set(struct genhash *pgenhash,
-                                    struct genhash_entry **slot,
+                                    struct genhash_entry *entry,
                                     const void *key, const void *data)
 {
-  struct genhash_entry *entry = *slot;
-
-  if (NULL != pgenhash->key_free_func) {
-    pgenhash->key_free_func(entry->key);
-  }
-  if (NULL != pgenhash->data_free_func) {
-    pgenhash->data_free_func(entry->data);
-  }
+  genhash_entry_free(pgenhash, entry);
   entry->key = (NULL != pgenhash->key_copy_func
                 ? pgenhash->key_copy_func(key) : (void *) key);
   entry->data = (NULL != pgenhash->data_copy_func
@@ -547,9 +713,8 @@ size_t genhash_capacity(const struct genhash *pgenhash)
 struct genhash *genhash_copy(const struct genhash *pgenhash)
 {
   struct genhash *new_genhash;
-  struct genhash_entry *const *src_bucket, *const *end;
-  const struct genhash_entry *src_iter;
-  struct genhash_entry **dest_slot, **dest_bucket;
+  struct genhash_entry *entry;
+  size_t i;
 
   fc_assert_ret_val(NULL != pgenhash, NULL);
 
@@ -558,22 +723,27 @@ struct genhash *genhash_copy(const struct genhash *pgenhash)
   /* Copy fields. */
   *new_genhash = *pgenhash;
 
-  /* But make fresh buckets. */
-  new_genhash->buckets = fc_calloc(new_genhash->num_buckets,
-                                   sizeof(*new_genhash->buckets));
-
-  /* Let's re-insert all data */
-  src_bucket = pgenhash->buckets;
-  end = src_bucket + pgenhash->num_buckets;
-  dest_bucket = new_genhash->buckets;
-
-  for (; src_bucket < end; src_bucket++, dest_bucket++) {
-    dest_slot = dest_bucket;
-    for (src_iter = *src_bucket; NULL != src_iter;
-         src_iter = src_iter->next) {
-      genhash_slot_create(new_genhash, dest_slot, src_iter->key,
-                          src_iter->data, src_iter->hash_val);
-      dest_slot = &(*dest_slot)->next;
+  /* But make fresh buckets, at the same places. */
+  new_genhash->ctrl = fc_malloc(pgenhash->num_buckets);
+  memcpy(new_genhash->ctrl, pgenhash->ctrl, pgenhash->num_buckets);
+  new_genhash->buckets = fc_malloc(pgenhash->num_buckets
+                                   * sizeof(*new_genhash->buckets));
+  memcpy(new_genhash->buckets, pgenhash->buckets,
+         pgenhash->num_buckets * sizeof(*new_genhash->buckets));
+
+  if (NULL != new_genhash->key_copy_func
+      || NULL != new_genhash->data_copy_func) {
+    for (i = 0; i < new_genhash->num_buckets; i++) {
+      if (!CTRL_IS_FULL(new_genhash->ctrl[i])) {
+        continue;
+      }
+      entry = new_genhash->buckets + i;
+      if (NULL != new_genhash->key_copy_func) {
+        entry->key = new_genhash->key_copy_func(entry->key);
+      }
+      if (NULL != new_genhash->data_copy_func) {
+        entry->data = new_genhash->data_copy_func(entry->data);
+      }
     }
   }
 
@@ -585,19 +755,21 @@ struct genhash *genhash_copy(const struct genhash *pgenhash)
 ****************************************************************************/
 void genhash_clear(struct genhash *pgenhash)
 {
-  struct genhash_entry **bucket, **end;
+  size_t i;
 
   fc_assert_ret(NULL != pgenhash);
 
-  bucket = pgenhash->buckets;
-  end = bucket + pgenhash->num_buckets;
-  for (; bucket < end; bucket++) {
-    while (NULL != *bucket) {
-      genhash_slot_free(pgenhash, bucket);
+  if (NULL != pgenhash->key_free_func || NULL != pgenhash->data_free_func) {
+    for (i = 0; i < pgenhash->num_buckets; i++) {
+      if (CTRL_IS_FULL(pgenhash->ctrl[i])) {
+        genhash_entry_free(pgenhash, pgenhash->buckets + i);
+      }
     }
   }
+  memset(pgenhash->ctrl, CTRL_EMPTY, pgenhash->num_buckets);
 
   pgenhash->num_entries = 0;
+  pgenhash->num_deleted = 0;
   genhash_maybe_shrink(pgenhash);
 }
 
@@ -608,21 +780,16 @@ void genhash_clear(struct genhash *pgenhash)
 bool genhash_insert(struct genhash *pgenhash, const void *key,
                     const void *data)
 {
-  struct genhash_entry **slot;
   genhash_val_t hash_val;
 
   fc_assert_ret_val(NULL != pgenhash, FALSE);
 
   hash_val = genhash_val_calc(pgenhash, key);
-  slot = genhash_slot_lookup(pgenhash, key, hash_val);
-  if (NULL != *slot) {
+  if (NULL != genhash_slot_lookup(pgenhash, key, hash_val)) {
     return FALSE;
   } else {
-    if (genhash_maybe_expand(pgenhash)) {
-      /* Recalculate slot. */
-      slot = pgenhash->buckets + (hash_val % pgenhash->num_buckets);
-    }
-    genhash_slot_create(pgenhash, slot, key, data, hash_val);
+    genhash_maybe_expand(pgenhash);
+    genhash_slot_create(pgenhash, key, data, hash_val);
     pgenhash->num_entries++;
     return TRUE;
   }
@@ -652,27 +819,24 @@ bool genhash_replace_full(struct genhash *pgenhash, const void *key,
                           const void *data, void **old_pkey,
                           void **old_pdata)
 {
-  struct genhash_entry **slot;
+  struct genhash_entry *entry;
   genhash_val_t hash_val;
 
   fc_assert_action(NULL != pgenhash,
                    genhash_default_get(old_pkey, old_pdata); return FALSE);
 
   hash_val = genhash_val_calc(pgenhash, key);
-  slot = genhash_slot_lookup(pgenhash, key, hash_val);
-  if (NULL != *slot) {
+  entry = genhash_slot_lookup(pgenhash, key, hash_val);
+  if (NULL != entry) {
     /* Replace. */
-    genhash_slot_get(slot, old_pkey, old_pdata);
-    genhash_slot_set(pgenhash, slot, key, data);
+    genhash_slot_get(entry, old_pkey, old_pdata);
+    genhash_slot_set(pgenhash, entry, key, data);
     return TRUE;
   } else {
     /* Insert. */
-    if (genhash_maybe_expand(pgenhash)) {
-      /* Recalculate slot. */
-      slot = pgenhash->buckets + (hash_val % pgenhash->num_buckets);
-    }
+    genhash_maybe_expand(pgenhash);
     genhash_default_get(old_pkey, old_pdata);
-    genhash_slot_create(pgenhash, slot, key, data, hash_val);
+    genhash_slot_create(pgenhash, key, data, hash_val);
     pgenhash->num_entries++;
     return FALSE;
   }
@@ -685,14 +849,15 @@ bool genhash_replace_full(struct genhash *pgenhash, const void *key,
 bool genhash_lookup(const struct genhash *pgenhash, const void *key,
                     void **pdata)
 {
-  struct genhash_entry **slot;
+  const struct genhash_entry *entry;
 
   fc_assert_action(NULL != pgenhash,
                    genhash_default_get(NULL, pdata); return FALSE);
 
-  slot = genhash_slot_lookup(pgenhash, key, genhash_val_calc(pgenhash, key));
-  if (NULL != *slot) {
-    genhash_slot_get(slot, NULL, pdata);
+  entry = genhash_slot_lookup(pgenhash, key,
+                              genhash_val_calc(pgenhash, key));
+  if (NULL != entry) {
+    genhash_slot_get(entry, NULL, pdata);
     return TRUE;
   } else {
     genhash_default_get(NULL, pdata);
@@ -718,19 +883,20 @@ bool genhash_remove(struct genhash *pgenhash, const void *key)
 bool genhash_remove_full(struct genhash *pgenhash, const void *key,
                          void **deleted_pkey, void **deleted_pdata)
 {
-  struct genhash_entry **slot;
+  struct genhash_entry *entry;
 
   fc_assert_action(NULL != pgenhash,
                    genhash_default_get(deleted_pkey, deleted_pdata);
                    return FALSE);
 
-  slot = genhash_slot_lookup(pgenhash, key, genhash_val_calc(pgenhash, key));
-  if (NULL != *slot) {
-    genhash_slot_get(slot, deleted_pkey, deleted_pdata);
-    genhash_slot_free(pgenhash, slot);
-    genhash_maybe_shrink(pgenhash);
+  entry = genhash_slot_lookup(pgenhash, key,
+                              genhash_val_calc(pgenhash, key));
+  if (NULL != entry) {
+    genhash_slot_get(entry, deleted_pkey, deleted_pdata);
+    genhash_slot_free(pgenhash, entry);
     fc_assert(0 < pgenhash->num_entries);
     pgenhash->num_entries--;
+    genhash_maybe_shrink(pgenhash);
     return TRUE;
   } else {
     genhash_default_get(deleted_pkey, deleted_pdata);
@@ -755,8 +921,8 @@ bool genhashs_are_equal_full(const struct genhash *pgenhash1,
                              const struct genhash *pgenhash2,
                              genhash_comp_fn_t data_comp_func)
 {
-  struct genhash_entry *const *bucket1, *const *max1, *const *slot2;
-  const struct genhash_entry *iter1;
+  const struct genhash_entry *iter1, *entry2;
+  size_t i;
 
   /* Check pointers. */
   if (pgenhash1 == pgenhash2) {
@@ -775,17 +941,17 @@ bool genhashs_are_equal_full(const struct genhash *pgenhash1,
   }
 
   /* Compare buckets. */
-  bucket1 = pgenhash1->buckets;
-  max1 = bucket1 + pgenhash1->num_buckets;
-  for (; bucket1 < max1; bucket1++) {
-    for (iter1 = *bucket1; NULL != iter1; iter1 = iter1->next) {
-      slot2 = genhash_slot_lookup(pgenhash2, iter1->key, iter1->hash_val);
-      if (NULL == *slot2
-          || (iter1->data != (*slot2)->data
-              && (NULL == data_comp_func
-                  || !data_comp_func(iter1->data, (*slot2)->data)))) {
-        return FALSE;
-      }
+  for (i = 0; i < pgenhash1->num_buckets; i++) {
+    if (!CTRL_IS_FULL(pgenhash1->ctrl[i])) {
+      continue;
+    }
+    iter1 = pgenhash1->buckets + i;
+    entry2 = genhash_slot_lookup(pgenhash2, iter1->key, iter1->hash_val);
+    if (NULL == entry2
+        || (iter1->data != entry2->data
+            && (NULL == data_comp_func
+                || !data_comp_func(iter1->data, entry2->data)))) {
+      return FALSE;
     }
   }
 
@@ -826,14 +992,9 @@ static void genhash_iter_next(struct iterator *genhash_iter)
 {
   struct genhash_iter *iter = GENHASH_ITER(genhash_iter);
 
-  iter->iterator = iter->iterator->next;
-  if (NULL != iter->iterator) {
-    return;
-  }
-
-  for (iter->bucket++; iter->bucket < iter->end; iter->bucket++) {
-    if (NULL != *iter->bucket) {
-      iter->iterator = *iter->bucket;
+  for (iter->ctrl++, iter->iterator++; iter->ctrl < iter->end;
+       iter->ctrl++, iter->iterator++) {
+    if (CTRL_IS_FULL(*iter->ctrl)) {
       return;
     }
   }
@@ -855,7 +1016,7 @@ static void *genhash_iter_get(const struct iterator *genhash_iter)
 static bool genhash_iter_valid(const struct iterator *genhash_iter)
 {
   struct genhash_iter *iter = GENHASH_ITER(genhash_iter);
-  return iter->bucket < iter->end;
+  return iter->ctrl < iter->end;
 }
 
 /****************************************************************************
@@ -873,13 +1034,13 @@ genhash_iter_init_common(struct genhash_iter *iter,
   iter->vtable.next = genhash_iter_next;
   iter->vtable.get = get;
   iter->vtable.valid = genhash_iter_valid;
-  iter->bucket = pgenhash->buckets;
-  iter->end = pgenhash->buckets + pgenhash->num_buckets;
+  iter->ctrl = pgenhash->ctrl;
+  iter->end = pgenhash->ctrl + pgenhash->num_buckets;
+  iter->iterator = pgenhash->buckets;
 
   /* Seek to the first used bucket. */
-  for (; iter->bucket < iter->end; iter->bucket++) {
-    if (NULL != *iter->bucket) {
-      iter->iterator = *iter->bucket;
+  for (; iter->ctrl < iter->end; iter->ctrl++, iter->iterator++) {
+    if (CTRL_IS_FULL(*iter->ctrl)) {
       break;
     }
   }
@@ -25,6 +25,18 @@
 
 #include "genlist.h"
 
+/* Number of links kept inside a list made by genlist_new_small_full(). */
+#define GENLIST_SMALL_LINKS 4
+
+/* A genlist which keeps its first links inside, so that short lists need
+ * no allocation per element and their links share the cache lines of the
+ * list. */
+struct genlist_small {
+  struct genlist list;          /* must be first */
+  unsigned int used;            /* bit i set: links[i] in use */
+  struct genlist_link links[GENLIST_SMALL_LINKS];
+};
+
 /****************************************************************************
   Create a new empty genlist.
 ****************************************************************************/
@@ -51,6 +63,30 @@ struct genlist *genlist_new_full(genlist_free_fn_t free_data_func)
   return pgenlist;
 }
 
+/****************************************************************************
+  Create a new empty genlist with a free data function, for a list which
+  is usually short: its first GENLIST_SMALL_LINKS links are kept inside
+  it. This makes the list larger, so it is only worth it for lists which
+  often get elements, like the units on a tile.
+****************************************************************************/
+struct genlist *genlist_new_small_full(genlist_free_fn_t free_data_func)
+{
+  struct genlist_small *psmall = fc_calloc(1, sizeof(*psmall));
+  struct genlist *pgenlist = &psmall->list;
+
+#ifdef ZERO_VARIABLES_FOR_SEARCHING
+  pgenlist->nelements = 0;
+  pgenlist->head_link = NULL;
+  pgenlist->tail_link = NULL;
+  psmall->used = 0;
+#endif /* ZERO_VARIABLES_FOR_SEARCHING */
+  pgenlist->small_list = TRUE;
+  fc_init_mutex(&pgenlist->mutex);
+  pgenlist->free_data_func = free_data_func;
+
+  return pgenlist;
+}
+
 /****************************************************************************
   Destroys the genlist.
 ****************************************************************************/
@@ -65,6 +101,24 @@ void genlist_destroy(struct genlist *pgenlist)
   free(pgenlist);
 }
 
+/****************************************************************************
+  Give the memory of the link back, to the list or to the system.
+****************************************************************************/
+static inline void genlist_link_free(struct genlist *pgenlist,
+                                     struct genlist_link *plink)
+{
+  if (pgenlist->small_list) {
+    struct genlist_small *psmall = (struct genlist_small *) pgenlist;
+
+    if (plink >= psmall->links
+        && plink < psmall->links + GENLIST_SMALL_LINKS) {
+      psmall->used &= ~(1u << (plink - psmall->links));
+      return;
+    }
+  }
+  free(plink);
+}
+
 /****************************************************************************
   Create a new link.
 ****************************************************************************/
@@ -72,7 +126,21 @@ static void genlist_link_new(struct genlist *pgenlist, void *dataptr,
                              struct genlist_link *prev,
                              struct genlist_link *next)
 {
-  struct genlist_link *plink = fc_malloc(sizeof(*plink));
+  struct genlist_small *psmall = (struct genlist_small *) pgenlist;
+  struct genlist_link *plink;
+
+  if (pgenlist->small_list
+      && psmall->used != (1u << GENLIST_SMALL_LINKS) - 1) {
+    int i = 0;
+
+    while (psmall->used & (1u << i)) {
+      i++;
+    }
+    psmall->used |= 1u << i;
+    plink = psmall->links + i;
+  } else {
+    plink = fc_malloc(sizeof(*plink));
+  }
 
   plink->dataptr = dataptr;
   plink->prev = prev;
@@ -115,7 +183,7 @@ static void genlist_link_destroy(struct genlist *pgenlist,
   if (NULL != pgenlist->free_data_func) {
     pgenlist->free_data_func(plink->dataptr);
   }
-  free(plink);
+  genlist_link_free(pgenlist, plink);
 }
 
 /****************************************************************************
@@ -166,7 +234,9 @@ struct genlist *genlist_copy_full(const struct genlist *pgenlist,
                                   genlist_copy_fn_t copy_data_func,
                                   genlist_free_fn_t free_data_func)
 {
-  struct genlist *pcopy = genlist_new_full(free_data_func);
+  struct genlist *pcopy = (NULL != pgenlist && pgenlist->small_list
+                           ? genlist_new_small_full(free_data_func)
+                           : genlist_new_full(free_data_func));
 
   if (pgenlist) {
     struct genlist_link *plink;
@@ -263,12 +333,12 @@ void genlist_clear(struct genlist *pgenlist)
       do {
         plink2 = plink->next;
         free_data_func(plink->dataptr);
-        free(plink);
+        genlist_link_free(pgenlist, plink);
       } while (NULL != (plink = plink2));
     } else {
       do {
         plink2 = plink->next;
-        free(plink);
+        genlist_link_free(pgenlist, plink);
       } while (NULL != (plink = plink2));
     }
   }
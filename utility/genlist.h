@@ -58,6 +58,7 @@ typedef bool (*genlist_comp_fn_t) (const void *, const void *);
  * of the list. */
 struct genlist {
   int nelements;
+  bool small_list;              /* see genlist_new_small_full() */
   fc_mutex mutex;
   struct genlist_link *head_link;
   struct genlist_link *tail_link;
@@ -67,6 +68,8 @@ struct genlist {
 struct genlist *genlist_new(void) fc__warn_unused_result;
 struct genlist *genlist_new_full(genlist_free_fn_t free_data_func)
                 fc__warn_unused_result;
+struct genlist *genlist_new_small_full(genlist_free_fn_t free_data_func)
+                fc__warn_unused_result;
 void genlist_destroy(struct genlist *pgenlist);
 
 struct genlist *genlist_copy(const struct genlist *pgenlist)
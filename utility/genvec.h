@@ -0,0 +1,241 @@
+/**********************************************************************
+ Freeciv - Copyright (C) 1996 - A Kjeldberg, L Gregersen, P Unold
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+***********************************************************************/
+#ifndef FC__GENVEC_H
+#define FC__GENVEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/****************************************************************************
+  MODULE: genvec
+
+  A "genvec" is a generic resizable array of (void*) pointers to arbitrary
+  user data. It offers the same basic operations as a genlist, but the
+  elements are stored contiguously, so accessing an element by its
+  position is O(1) instead of a walk through the links.
+
+  Use it instead of a genlist for sequences which are mostly appended to
+  and then indexed, such as move lists. Removing an element from the
+  middle keeps the order of the others and costs a memmove().
+
+  Positions are specified starting from 0, up to n - 1 for a vector with
+  n elements. The position -1 can be used to refer to the last element.
+
+  As for genlists, the vector must not be modified while it is iterated
+  with genvec_iterate().
+****************************************************************************/
+
+#include <string.h>     /* memmove */
+
+/* utility */
+#include "log.h"
+#include "mem.h"
+#include "shared.h"     /* MAX */
+#include "support.h"    /* bool, fc__warn_unused_result */
+
+typedef void (*genvec_free_fn_t) (void *);
+
+struct genvec {
+  int size;
+  int size_alloc;
+  void **data;
+  genvec_free_fn_t free_data_func;
+};
+
+/****************************************************************************
+  Create a new empty genvec with a free data function.
+****************************************************************************/
+fc__warn_unused_result
+static inline struct genvec *genvec_new_full(genvec_free_fn_t free_data_func)
+{
+  struct genvec *pgenvec = fc_calloc(1, sizeof(*pgenvec));
+
+  pgenvec->free_data_func = free_data_func;
+
+  return pgenvec;
+}
+
+/****************************************************************************
+  Create a new empty genvec.
+****************************************************************************/
+fc__warn_unused_result
+static inline struct genvec *genvec_new(void)
+{
+  return genvec_new_full(NULL);
+}
+
+/****************************************************************************
+  Remove all elements, calling the free data function on each of them.
+  The storage is kept for reuse.
+****************************************************************************/
+static inline void genvec_clear(struct genvec *pgenvec)
+{
+  if (NULL != pgenvec->free_data_func) {
+    int i;
+
+    for (i = 0; i < pgenvec->size; i++) {
+      pgenvec->free_data_func(pgenvec->data[i]);
+    }
+  }
+  pgenvec->size = 0;
+}
+
+/****************************************************************************
+  Destroys the genvec.
+****************************************************************************/
+static inline void genvec_destroy(struct genvec *pgenvec)
+{
+  if (NULL == pgenvec) {
+    return;
+  }
+
+  genvec_clear(pgenvec);
+  free(pgenvec->data);
+  free(pgenvec);
+}
+
+/****************************************************************************
+  Make room for at least 'size' elements.
+****************************************************************************/
+static inline void genvec_reserve(struct genvec *pgenvec, int size)
+{
+  if (size > pgenvec->size_alloc) {
+    pgenvec->size_alloc = MAX(size, 2 * pgenvec->size_alloc);
+    pgenvec->data = fc_realloc(pgenvec->data,
+                               pgenvec->size_alloc * sizeof(*pgenvec->data));
+  }
+}
+
+/****************************************************************************
+  Returns the number of elements stored in the genvec.
+****************************************************************************/
+static inline int genvec_size(const struct genvec *pgenvec)
+{
+  return (NULL != pgenvec ? pgenvec->size : 0);
+}
+
+/****************************************************************************
+  Returns the user-data pointer stored in the genvec at the position 'idx'
+  (-1 for the last element), or NULL if there is no such element.
+****************************************************************************/
+static inline void *genvec_get(const struct genvec *pgenvec, int idx)
+{
+  if (NULL == pgenvec || 0 == pgenvec->size) {
+    return NULL;
+  }
+  if (-1 == idx) {
+    idx = pgenvec->size - 1;
+  }
+  fc_assert_ret_val(0 <= idx && idx < pgenvec->size, NULL);
+
+  return pgenvec->data[idx];
+}
+
+/****************************************************************************
+  Returns the last user-data pointer, or NULL if the genvec is empty.
+****************************************************************************/
+static inline void *genvec_back(const struct genvec *pgenvec)
+{
+  return genvec_get(pgenvec, -1);
+}
+
+/****************************************************************************
+  Insert a new element at the end of the genvec.
+****************************************************************************/
+static inline void genvec_append(struct genvec *pgenvec, void *data)
+{
+  genvec_reserve(pgenvec, pgenvec->size + 1);
+  pgenvec->data[pgenvec->size++] = data;
+}
+
+/****************************************************************************
+  Remove the element at the position 'idx' (-1 for the last one) and
+  return it. The free data function is not called, and the order of the
+  remaining elements is kept.
+****************************************************************************/
+static inline void *genvec_remove_index(struct genvec *pgenvec, int idx)
+{
+  void *data;
+
+  if (-1 == idx) {
+    idx = pgenvec->size - 1;
+  }
+  fc_assert_ret_val(0 <= idx && idx < pgenvec->size, NULL);
+
+  data = pgenvec->data[idx];
+  pgenvec->size--;
+  memmove(pgenvec->data + idx, pgenvec->data + idx + 1,
+          (pgenvec->size - idx) * sizeof(*pgenvec->data));
+
+  return data;
+}
+
+/****************************************************************************
+  Remove the last element, calling the free data function on it.
+****************************************************************************/
+static inline void genvec_pop_back(struct genvec *pgenvec)
+{
+  if (0 < pgenvec->size) {
+    void *data = genvec_remove_index(pgenvec, -1);
+
+    if (NULL != pgenvec->free_data_func) {
+      pgenvec->free_data_func(data);
+    }
+  }
+}
+
+/****************************************************************************
+  Remove the first element which holds the pointer 'data', calling the
+  free data function on it. Returns TRUE if one was found.
+****************************************************************************/
+static inline bool genvec_remove(struct genvec *pgenvec, const void *data)
+{
+  int i;
+
+  for (i = 0; i < pgenvec->size; i++) {
+    if (pgenvec->data[i] == data) {
+      void *removed = genvec_remove_index(pgenvec, i);
+
+      if (NULL != pgenvec->free_data_func) {
+        pgenvec->free_data_func(removed);
+      }
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/* Iterate over the elements of a genvec. The vector must not be modified
+ * in the body. */
+#define genvec_iterate(pgenvec, type_t, var)                                \
+{                                                                           \
+  const struct genvec *_gv_##var = (pgenvec);                               \
+  int _gv_##var##_index;                                                    \
+  type_t var;                                                               \
+                                                                            \
+  for (_gv_##var##_index = 0;                                               \
+       _gv_##var##_index < genvec_size(_gv_##var);                          \
+       _gv_##var##_index++) {                                               \
+    var = (type_t) _gv_##var->data[_gv_##var##_index];
+
+#define genvec_iterate_end                                                  \
+  }                                                                         \
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif  /* FC__GENVEC_H */
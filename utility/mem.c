@@ -26,8 +26,10 @@
 
 /* utility */
 #include "fcintl.h"
+#include "fcthread.h"
 #include "log.h"
 #include "shared.h"		/* TRUE, FALSE */
+#include "timing.h"
 
 #include "mem.h"
 
@@ -80,6 +82,7 @@ void *fc_real_malloc(size_t size,
    * According to ANSI C, the return is implementation-specific, 
    * this is a safe guard. Having the extra byte is, of course, harmless. */
   size = MAX(size, 1);
+  PERF_COUNT(PERF_ALLOCS, 1);
     
   ptr = malloc(size);
   if (!ptr) {
@@ -102,6 +105,7 @@ void *fc_real_realloc(void *ptr, size_t size,
   }
 
   sanity_check_size(size, called_as, line, file);
+  PERF_COUNT(PERF_ALLOCS, 1);
 
   new_ptr = realloc(ptr, size);
   if (!new_ptr) {
@@ -131,6 +135,153 @@ void *fc_real_calloc(size_t nelem, size_t elsize,
   return ptr;
 }
 
+/* Objects per slab of a memory pool. */
+#define MEM_POOL_SLAB_SIZE 64
+
+static struct fc_mem_pool *mem_pools = NULL;
+
+/* Units and cities are also created and freed by threads (e.g. the
+ * threaded AI), so all pools are used under this lock. */
+static fc_mutex mem_pools_mutex;
+static bool mem_pools_initialized = FALSE;
+
+/*******************************************************************************
+  Prepare the memory pools for use. Must be called before any thread
+  other than the main one is started.
+*******************************************************************************/
+void fc_mem_pools_init(void)
+{
+  if (!mem_pools_initialized) {
+    fc_init_mutex(&mem_pools_mutex);
+    mem_pools_initialized = TRUE;
+  }
+}
+
+/*******************************************************************************
+  Return a zeroed object from the pool, like fc_calloc(1, pool->size) would.
+  Freed objects are used again first; otherwise objects are taken from
+  slabs of MEM_POOL_SLAB_SIZE objects.
+*******************************************************************************/
+void *fc_mem_pool_alloc(struct fc_mem_pool *pool)
+{
+  void *ptr;
+
+  fc_assert(mem_pools_initialized);
+  fc_allocate_mutex(&mem_pools_mutex);
+
+  if (NULL != pool->free_list) {
+    ptr = pool->free_list;
+    pool->free_list = *(void **) ptr;
+    pool->reused++;
+  } else {
+    if (0 == pool->fresh_left) {
+      if (!pool->used) {
+        /* First use; keep the objects aligned for any member type and
+         * large enough to link them. */
+        pool->size = MAX(pool->size, sizeof(void *));
+        pool->size = (pool->size + sizeof(double) - 1)
+                     / sizeof(double) * sizeof(double);
+        pool->used = TRUE;
+        pool->next = mem_pools;
+        mem_pools = pool;
+      }
+
+      pool->fresh = fc_malloc(pool->size * MEM_POOL_SLAB_SIZE);
+      pool->fresh_left = MEM_POOL_SLAB_SIZE;
+      pool->slabs = fc_realloc(pool->slabs,
+                               (pool->num_slabs + 1) * sizeof(*pool->slabs));
+      pool->slabs[pool->num_slabs++] = pool->fresh;
+    }
+
+    ptr = pool->fresh;
+    pool->fresh += pool->size;
+    pool->fresh_left--;
+  }
+
+  memset(ptr, 0, pool->size);
+
+  pool->allocs++;
+  pool->in_use++;
+  pool->peak = MAX(pool->peak, pool->in_use);
+
+  fc_release_mutex(&mem_pools_mutex);
+
+  return ptr;
+}
+
+/*******************************************************************************
+  Give an object back to the pool it was allocated from.
+*******************************************************************************/
+void fc_mem_pool_free(struct fc_mem_pool *pool, void *ptr)
+{
+  if (NULL == ptr) {
+    return;
+  }
+
+#ifdef DEBUG
+  /* Make use after free show. */
+  memset(ptr, 0xdb, pool->size);
+#endif
+
+  fc_allocate_mutex(&mem_pools_mutex);
+  *(void **) ptr = pool->free_list;
+  pool->free_list = ptr;
+  pool->in_use--;
+  fc_release_mutex(&mem_pools_mutex);
+}
+
+/*******************************************************************************
+  Log the use of the memory pools.
+*******************************************************************************/
+void fc_mem_pools_log(enum log_level level)
+{
+  struct fc_mem_pool *pool;
+
+  if (!mem_pools_initialized) {
+    return;
+  }
+
+  fc_allocate_mutex(&mem_pools_mutex);
+  for (pool = mem_pools; NULL != pool; pool = pool->next) {
+    log_base(level, "Memory pool %s: %lu allocations, %lu reused, "
+             "%d in use, peak %d, %d kB",
+             pool->name, pool->allocs, pool->reused, pool->in_use,
+             pool->peak,
+             (int) (pool->num_slabs * MEM_POOL_SLAB_SIZE * pool->size
+                    / 1024));
+  }
+  fc_release_mutex(&mem_pools_mutex);
+}
+
+/*******************************************************************************
+  Give the memory of the pools with no objects in use back to the system.
+*******************************************************************************/
+void fc_mem_pools_free(void)
+{
+  struct fc_mem_pool *pool;
+
+  if (!mem_pools_initialized) {
+    return;
+  }
+
+  fc_allocate_mutex(&mem_pools_mutex);
+  for (pool = mem_pools; NULL != pool; pool = pool->next) {
+    if (0 == pool->in_use) {
+      int i;
+
+      for (i = 0; i < pool->num_slabs; i++) {
+        free(pool->slabs[i]);
+      }
+      FC_FREE(pool->slabs);
+      pool->num_slabs = 0;
+      pool->free_list = NULL;
+      pool->fresh = NULL;
+      pool->fresh_left = 0;
+    }
+  }
+  fc_release_mutex(&mem_pools_mutex);
+}
+
 /***************************************************************
  Function used by fc_strdup macro, strdup() replacement
  No need to check return value.
@@ -61,6 +61,37 @@ char *real_fc_strdup(const char *str,
                      const char *called_as, int line, const char *file)
                      fc__warn_unused_result;
 
+/* Pools of objects of one size, for objects that are created and freed
+ * all the time. Freed objects are kept for reuse instead of being given
+ * back to the C library. Define a pool statically with
+ * FC_MEM_POOL_INIT(); it is set up on first use. The pools may be used
+ * from any thread once fc_mem_pools_init() has been called. */
+struct fc_mem_pool {
+  const char *name;
+  size_t size;
+  void *free_list;              /* freed objects, linked through their
+                                 * first bytes */
+  char *fresh;                  /* never used objects of the last slab */
+  int fresh_left;
+  void **slabs;
+  int num_slabs;
+  unsigned long allocs;         /* fc_mem_pool_alloc() calls */
+  unsigned long reused;         /* ... served from the freed objects */
+  int in_use;
+  int peak;
+  bool used;
+  struct fc_mem_pool *next;     /* in the list of used pools */
+};
+
+#define FC_MEM_POOL_INIT(_name_, _size_)                                    \
+  { (_name_), (_size_), NULL, NULL, 0, NULL, 0, 0, 0, 0, 0, FALSE, NULL }
+
+void fc_mem_pools_init(void);
+void *fc_mem_pool_alloc(struct fc_mem_pool *pool) fc__warn_unused_result;
+void fc_mem_pool_free(struct fc_mem_pool *pool, void *ptr);
+void fc_mem_pools_log(enum log_level level);
+void fc_mem_pools_free(void);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -37,6 +37,9 @@
 #ifdef HAVE_NETDB_H
 #include <netdb.h>
 #endif 
+#ifdef HAVE_POLL_H
+#include <poll.h>
+#endif
 #ifdef HAVE_SYS_IOCTL_H
 #include <sys/ioctl.h>
 #endif
@@ -138,6 +141,212 @@ int fc_select(int n, fd_set *readfds, fd_set *writefds, fd_set *exceptfds,
   return result;
 }
 
+/* A set of sockets to wait on. With poll() there is no FD_SETSIZE limit
+ * and the cost of a wait depends only on the number of sockets in the set,
+ * not on the highest descriptor. */
+struct fc_sockwait {
+#ifdef HAVE_POLL_H
+  struct pollfd *fds;
+  int nfds;
+  int fds_alloc;
+  /* Socket -> index in 'fds'. Entries are not cleared between waits, so
+   * they are only valid if 'fds' at that index refers to the socket. */
+  int *slot;
+  int slot_alloc;
+#else  /* HAVE_POLL_H */
+  fd_set readfs, writefs, exceptfs;
+  int max_desc;
+#endif /* HAVE_POLL_H */
+};
+
+/***************************************************************
+  Create a new, empty, set of sockets to wait on.
+***************************************************************/
+struct fc_sockwait *fc_sockwait_new(void)
+{
+  struct fc_sockwait *sw = fc_calloc(1, sizeof(*sw));
+
+  fc_sockwait_clear(sw);
+
+  return sw;
+}
+
+/***************************************************************
+  Free a set of sockets.
+***************************************************************/
+void fc_sockwait_destroy(struct fc_sockwait *sw)
+{
+  if (NULL == sw) {
+    return;
+  }
+
+#ifdef HAVE_POLL_H
+  free(sw->fds);
+  free(sw->slot);
+#endif /* HAVE_POLL_H */
+  free(sw);
+}
+
+/***************************************************************
+  Remove all sockets from the set. Allocated memory is kept for the
+  next round.
+***************************************************************/
+void fc_sockwait_clear(struct fc_sockwait *sw)
+{
+#ifdef HAVE_POLL_H
+  sw->nfds = 0;
+#else  /* HAVE_POLL_H */
+  FC_FD_ZERO(&sw->readfs);
+  FC_FD_ZERO(&sw->writefs);
+  FC_FD_ZERO(&sw->exceptfs);
+  sw->max_desc = -1;
+#endif /* HAVE_POLL_H */
+}
+
+#ifdef HAVE_POLL_H
+/***************************************************************
+  Return the index of the socket in the poll set, or -1.
+***************************************************************/
+static int fc_sockwait_slot(const struct fc_sockwait *sw, int sock)
+{
+  int idx;
+
+  if (sock < 0 || sock >= sw->slot_alloc) {
+    return -1;
+  }
+  idx = sw->slot[sock];
+
+  return (0 <= idx && idx < sw->nfds && sw->fds[idx].fd == sock) ? idx : -1;
+}
+#endif /* HAVE_POLL_H */
+
+/***************************************************************
+  Add interest in the given FC_SW_* events of a socket to the set.
+  Adding the same socket again adds to its events.
+***************************************************************/
+void fc_sockwait_add(struct fc_sockwait *sw, int sock, int events)
+{
+#ifdef HAVE_POLL_H
+  int idx = fc_sockwait_slot(sw, sock);
+
+  fc_assert_ret(0 <= sock);
+
+  if (0 > idx) {
+    if (sw->nfds >= sw->fds_alloc) {
+      sw->fds_alloc = MAX(16, 2 * sw->fds_alloc);
+      sw->fds = fc_realloc(sw->fds, sw->fds_alloc * sizeof(*sw->fds));
+    }
+    if (sock >= sw->slot_alloc) {
+      sw->slot_alloc = MAX(sock + 1, 2 * sw->slot_alloc);
+      sw->slot = fc_realloc(sw->slot, sw->slot_alloc * sizeof(*sw->slot));
+    }
+    idx = sw->nfds++;
+    sw->slot[sock] = idx;
+    sw->fds[idx].fd = sock;
+    sw->fds[idx].events = 0;
+    sw->fds[idx].revents = 0;
+  }
+
+  if (events & FC_SW_READ) {
+    sw->fds[idx].events |= POLLIN;
+  }
+  if (events & FC_SW_WRITE) {
+    sw->fds[idx].events |= POLLOUT;
+  }
+  if (events & FC_SW_EXCEPT) {
+    sw->fds[idx].events |= POLLPRI;
+  }
+#else  /* HAVE_POLL_H */
+  if (events & FC_SW_READ) {
+    FD_SET(sock, &sw->readfs);
+  }
+  if (events & FC_SW_WRITE) {
+    FD_SET(sock, &sw->writefs);
+  }
+  if (events & FC_SW_EXCEPT) {
+    FD_SET(sock, &sw->exceptfs);
+  }
+  sw->max_desc = MAX(sw->max_desc, sock);
+#endif /* HAVE_POLL_H */
+}
+
+/***************************************************************
+  Wait up to 'timeout_ms' milliseconds (forever if negative) for any
+  of the sockets of the set to be ready. Returns the number of ready
+  sockets, 0 on timeout or -1 on error, like select().
+***************************************************************/
+int fc_sockwait_run(struct fc_sockwait *sw, int timeout_ms)
+{
+#ifdef HAVE_POLL_H
+  return poll(sw->fds, sw->nfds, timeout_ms);
+#else  /* HAVE_POLL_H */
+  fc_timeval tv;
+
+  tv.tv_sec = timeout_ms / 1000;
+  tv.tv_usec = (timeout_ms % 1000) * 1000;
+
+  return fc_select(sw->max_desc + 1, &sw->readfs, &sw->writefs,
+                   &sw->exceptfs, 0 <= timeout_ms ? &tv : NULL);
+#endif /* HAVE_POLL_H */
+}
+
+/***************************************************************
+  Return whether the socket was reported ready for any of the given
+  FC_SW_* events by the last fc_sockwait_run(). As with select(), a
+  socket in error or hung up state is reported readable, so the error
+  is seen by the next read.
+***************************************************************/
+bool fc_sockwait_isset(const struct fc_sockwait *sw, int sock, int events)
+{
+#ifdef HAVE_POLL_H
+  int idx = fc_sockwait_slot(sw, sock);
+  short revents;
+
+  if (0 > idx) {
+    return FALSE;
+  }
+  revents = sw->fds[idx].revents;
+
+  return (((events & FC_SW_READ)
+           && (revents & (POLLIN | POLLHUP | POLLERR)))
+          || ((events & FC_SW_WRITE) && (revents & (POLLOUT | POLLERR)))
+          || ((events & FC_SW_EXCEPT) && (revents & (POLLPRI | POLLNVAL))));
+#else  /* HAVE_POLL_H */
+  return (((events & FC_SW_READ) && FD_ISSET(sock, &sw->readfs))
+          || ((events & FC_SW_WRITE) && FD_ISSET(sock, &sw->writefs))
+          || ((events & FC_SW_EXCEPT) && FD_ISSET(sock, &sw->exceptfs)));
+#endif /* HAVE_POLL_H */
+}
+
+/***************************************************************
+  Mark the socket as ready for the given FC_SW_* events in the result
+  of the last fc_sockwait_run(), as if it had reported them. For input
+  which can't be waited on, like the VMS terminal.
+***************************************************************/
+void fc_sockwait_set_ready(struct fc_sockwait *sw, int sock, int events)
+{
+#ifdef HAVE_POLL_H
+  int idx;
+
+  fc_sockwait_add(sw, sock, events);
+  idx = fc_sockwait_slot(sw, sock);
+  fc_assert_ret(0 <= idx);
+
+  if (events & FC_SW_READ) {
+    sw->fds[idx].revents |= POLLIN;
+  }
+  if (events & FC_SW_WRITE) {
+    sw->fds[idx].revents |= POLLOUT;
+  }
+  if (events & FC_SW_EXCEPT) {
+    sw->fds[idx].revents |= POLLPRI;
+  }
+#else  /* HAVE_POLL_H */
+  /* After the wait, the sets hold the ready sockets. */
+  fc_sockwait_add(sw, sock, events);
+#endif /* HAVE_POLL_H */
+}
+
 /***************************************************************
   Read from a socket.
 ***************************************************************/
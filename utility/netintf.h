@@ -127,6 +127,22 @@ typedef struct timeval fc_timeval;
 int fc_connect(int sockfd, const struct sockaddr *serv_addr, socklen_t addrlen);
 int fc_select(int n, fd_set *readfds, fd_set *writefds, fd_set *exceptfds,
               fc_timeval *timeout);
+
+/* Events for fc_sockwait_add(), fc_sockwait_isset() and
+ * fc_sockwait_set_ready(). */
+#define FC_SW_READ   (1 << 0)
+#define FC_SW_WRITE  (1 << 1)
+#define FC_SW_EXCEPT (1 << 2)
+
+struct fc_sockwait;
+
+struct fc_sockwait *fc_sockwait_new(void);
+void fc_sockwait_destroy(struct fc_sockwait *sw);
+void fc_sockwait_clear(struct fc_sockwait *sw);
+void fc_sockwait_add(struct fc_sockwait *sw, int sock, int events);
+int fc_sockwait_run(struct fc_sockwait *sw, int timeout_ms);
+bool fc_sockwait_isset(const struct fc_sockwait *sw, int sock, int events);
+void fc_sockwait_set_ready(struct fc_sockwait *sw, int sock, int events);
 int fc_readsocket(int sock, void *buf, size_t size);
 int fc_writesocket(int sock, const void *buf, size_t size);
 void fc_closesocket(int sock);
@@ -24,6 +24,8 @@
  * You may also define:
  *   SPECLIST_TYPE - the typed genlist will contain pointers to this type;
  * If SPECLIST_TYPE is not defined, then 'struct SPECLIST_TAG' is used.
+ *   SPECLIST_SMALL - the lists are usually short; their first links are
+ *                    kept inside the list (see genlist_new_small_full()).
  * At the end of this file, these (and other defines) are undef-ed.
  *
  * Assuming SPECLIST_TAG were 'foo', and SPECLIST_TYPE were 'foo_t',
@@ -167,7 +169,11 @@ fc__warn_unused_result;
 
 static inline SPECLIST_LIST *SPECLIST_FOO(_list_new) (void)
 {
+#ifdef SPECLIST_SMALL
+  return (SPECLIST_LIST *) genlist_new_small_full(NULL);
+#else
   return (SPECLIST_LIST *) genlist_new();
+#endif
 }
 
 /****************************************************************************
@@ -180,8 +186,13 @@ fc__warn_unused_result;
 static inline SPECLIST_LIST *
 SPECLIST_FOO(_list_new_full) (SPECLIST_FOO(_list_free_fn_t) free_data_func)
 {
+#ifdef SPECLIST_SMALL
+  return ((SPECLIST_LIST *)
+          genlist_new_small_full((genlist_free_fn_t) free_data_func));
+#else
   return ((SPECLIST_LIST *)
           genlist_new_full((genlist_free_fn_t) free_data_func));
+#endif
 }
 
 /****************************************************************************
@@ -546,6 +557,7 @@ SPECLIST_FOO(_list_link_next) (const SPECLIST_LINK *plink)
 
 #undef SPECLIST_TAG
 #undef SPECLIST_TYPE
+#undef SPECLIST_SMALL
 #undef SPECLIST_PASTE_
 #undef SPECLIST_PASTE
 #undef SPECLIST_LIST
@@ -44,6 +44,7 @@
 #include <fc_config.h>
 #endif
 
+#include <string.h>
 #include <time.h>
 
 #ifdef HAVE_GETTIMEOFDAY
@@ -56,6 +57,7 @@
 #endif
 
 /* utility */
+#include "fcthread.h"
 #include "log.h"
 #include "mem.h"
 #include "shared.h"		/* TRUE, FALSE */
@@ -399,3 +401,471 @@ void timer_usleep_since_start(struct timer *t, long usec)
   fc_usleep(usec);
 #endif
 }
+
+/********************************************************************** 
+  Zone profiler.
+
+  Code marks zones with PROFILE_ZONE_START() / PROFILE_ZONE_STOP().
+  Zones nest, and each thread records the time spent in them into its
+  own tree of nodes, so the same zone reached through different callers
+  is accounted separately. The trees are written to a file in the
+  "folded stacks" format understood by flame graph tools (one line per
+  call stack: the zone names separated by ';', then the time spent in
+  the innermost zone itself, in microseconds) every time
+  profile_flush() is called, and then cleared.
+***********************************************************************/
+
+#define PROFILE_MAX_DEPTH 64
+
+struct profile_node {
+  char *name;
+  struct profile_node *parent;
+  struct profile_node *child;           /* first child */
+  struct profile_node *sibling;         /* next child of the parent */
+  double seconds;
+  unsigned int count;
+};
+
+struct profile_thread {
+  int id;
+  fc_mutex mutex;
+  struct profile_node root;
+  struct profile_node *current;
+  int depth;
+  double start[PROFILE_MAX_DEPTH];
+  struct profile_thread *next;
+};
+
+/********************************************************************** 
+  Event counters.
+
+  They are only updated while perf_counters_enabled is set, so the
+  callers on hot paths (every allocation) pay a single test otherwise.
+  With pthreads every thread adds to its own counters without a lock;
+  perf_counters_read() sums them. The counters of a thread which ends
+  are added to perf_counters_retired first.
+***********************************************************************/
+
+struct perf_counters_thread {
+  unsigned long counters[PERF_LAST];
+  struct perf_counters_thread *next;
+};
+
+bool perf_counters_enabled = FALSE;
+
+static unsigned long perf_counters_retired[PERF_LAST];
+static struct perf_counters_thread *perf_counters_threads = NULL;
+static fc_mutex perf_counters_mutex;
+static bool perf_counters_initialized = FALSE;
+
+#ifdef HAVE_PTHREAD
+static pthread_key_t perf_counters_key;
+
+/********************************************************************** 
+  Add the counters of an ending thread to the retired ones.
+***********************************************************************/
+static void perf_counters_thread_destroy(void *data)
+{
+  struct perf_counters_thread *pthr = data, **pprev;
+  int i;
+
+  fc_allocate_mutex(&perf_counters_mutex);
+  for (i = 0; i < PERF_LAST; i++) {
+    perf_counters_retired[i] += pthr->counters[i];
+  }
+  for (pprev = &perf_counters_threads; NULL != *pprev;
+       pprev = &(*pprev)->next) {
+    if (*pprev == pthr) {
+      *pprev = pthr->next;
+      break;
+    }
+  }
+  fc_release_mutex(&perf_counters_mutex);
+
+  free(pthr);
+}
+#endif /* HAVE_PTHREAD */
+
+/********************************************************************** 
+  Prepare the event counters for use from several threads. Must be
+  called before any thread is started.
+***********************************************************************/
+void perf_counters_init(void)
+{
+  if (!perf_counters_initialized) {
+    fc_init_mutex(&perf_counters_mutex);
+#ifdef HAVE_PTHREAD
+    pthread_key_create(&perf_counters_key, perf_counters_thread_destroy);
+#endif
+    perf_counters_initialized = TRUE;
+  }
+}
+
+/********************************************************************** 
+  Start or stop counting events.
+***********************************************************************/
+void perf_counters_enable(bool enable)
+{
+  perf_counters_enabled = enable;
+}
+
+/********************************************************************** 
+  Add n to the event counter 'which' of the running thread. Use
+  PERF_COUNT(), which only calls this while counting is enabled.
+***********************************************************************/
+void perf_count(enum perf_counter which, unsigned long n)
+{
+#ifdef HAVE_PTHREAD
+  struct perf_counters_thread *pthr;
+
+  if (!perf_counters_initialized) {
+    perf_counters_retired[which] += n;
+    return;
+  }
+
+  pthr = pthread_getspecific(perf_counters_key);
+  if (NULL == pthr) {
+    /* Not fc_calloc(), which would count itself. */
+    pthr = calloc(1, sizeof(*pthr));
+    if (NULL == pthr) {
+      return;
+    }
+    pthread_setspecific(perf_counters_key, pthr);
+    fc_allocate_mutex(&perf_counters_mutex);
+    pthr->next = perf_counters_threads;
+    perf_counters_threads = pthr;
+    fc_release_mutex(&perf_counters_mutex);
+  }
+  pthr->counters[which] += n;
+#else  /* HAVE_PTHREAD */
+  if (perf_counters_initialized) {
+    fc_allocate_mutex(&perf_counters_mutex);
+    perf_counters_retired[which] += n;
+    fc_release_mutex(&perf_counters_mutex);
+  } else {
+    perf_counters_retired[which] += n;
+  }
+#endif /* HAVE_PTHREAD */
+}
+
+/********************************************************************** 
+  Copy the PERF_LAST event counters, summed over all threads, to
+  'counters'. Counts of other threads being added at the same time may
+  be missed until the next call.
+***********************************************************************/
+void perf_counters_read(unsigned long *counters)
+{
+  struct perf_counters_thread *pthr;
+  int i;
+
+  if (perf_counters_initialized) {
+    fc_allocate_mutex(&perf_counters_mutex);
+  }
+  memcpy(counters, perf_counters_retired, sizeof(perf_counters_retired));
+  for (pthr = perf_counters_threads; NULL != pthr; pthr = pthr->next) {
+    for (i = 0; i < PERF_LAST; i++) {
+      counters[i] += pthr->counters[i];
+    }
+  }
+  if (perf_counters_initialized) {
+    fc_release_mutex(&perf_counters_mutex);
+  }
+}
+
+bool profile_enabled = FALSE;
+
+static FILE *profile_file = NULL;
+static struct profile_thread *profile_threads = NULL;
+static int profile_thread_count = 0;
+static fc_mutex profile_threads_mutex;
+
+#ifdef HAVE_PTHREAD
+static pthread_once_t profile_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t profile_key;
+
+/********************************************************************** 
+  Create the key used to find the profile of the running thread.
+***********************************************************************/
+static void profile_key_init(void)
+{
+  pthread_key_create(&profile_key, NULL);
+  fc_init_mutex(&profile_threads_mutex);
+}
+#endif /* HAVE_PTHREAD */
+
+/********************************************************************** 
+  Return the current time for the profiler, in seconds.
+***********************************************************************/
+static double profile_now(void)
+{
+#ifdef CLOCK_MONOTONIC
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+#elif defined(HAVE_GETTIMEOFDAY)
+  struct timeval tv;
+
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / (double)N_USEC_PER_SEC;
+#else
+  return clock() / (double)CLOCKS_PER_SEC;
+#endif
+}
+
+/********************************************************************** 
+  Return the profile of the running thread, creating it if needed.
+  Without pthreads all threads share one profile.
+***********************************************************************/
+static struct profile_thread *profile_thread_get(void)
+{
+  struct profile_thread *pthr;
+
+#ifdef HAVE_PTHREAD
+  pthread_once(&profile_key_once, profile_key_init);
+  pthr = pthread_getspecific(profile_key);
+#else
+  pthr = profile_threads;
+#endif
+
+  if (NULL == pthr) {
+    pthr = fc_calloc(1, sizeof(*pthr));
+    fc_init_mutex(&pthr->mutex);
+    pthr->current = &pthr->root;
+#ifdef HAVE_PTHREAD
+    pthread_setspecific(profile_key, pthr);
+    fc_allocate_mutex(&profile_threads_mutex);
+#endif
+    pthr->id = ++profile_thread_count;
+    pthr->next = profile_threads;
+    profile_threads = pthr;
+#ifdef HAVE_PTHREAD
+    fc_release_mutex(&profile_threads_mutex);
+#endif
+  }
+
+  return pthr;
+}
+
+/********************************************************************** 
+  Enter the zone 'name' in the running thread. Use PROFILE_ZONE_START().
+***********************************************************************/
+void profile_zone_start(const char *name)
+{
+  struct profile_thread *pthr = profile_thread_get();
+  struct profile_node *pnode;
+
+  fc_allocate_mutex(&pthr->mutex);
+  if (pthr->depth < PROFILE_MAX_DEPTH) {
+    for (pnode = pthr->current->child; NULL != pnode;
+         pnode = pnode->sibling) {
+      if (0 == strcmp(pnode->name, name)) {
+        break;
+      }
+    }
+    if (NULL == pnode) {
+      pnode = fc_calloc(1, sizeof(*pnode));
+      pnode->name = fc_strdup(name);
+      pnode->parent = pthr->current;
+      pnode->sibling = pthr->current->child;
+      pthr->current->child = pnode;
+    }
+    pthr->current = pnode;
+    pthr->start[pthr->depth] = profile_now();
+  }
+  pthr->depth++;
+  fc_release_mutex(&pthr->mutex);
+}
+
+/********************************************************************** 
+  Leave the zone 'name' in the running thread. Zones entered inside it
+  and not left yet are closed, too. Use PROFILE_ZONE_STOP().
+***********************************************************************/
+void profile_zone_stop(const char *name)
+{
+  struct profile_thread *pthr = profile_thread_get();
+  struct profile_node *pnode;
+  double now;
+
+  fc_allocate_mutex(&pthr->mutex);
+  if (pthr->depth > PROFILE_MAX_DEPTH) {
+    /* Too deep to be recorded. */
+    pthr->depth--;
+    fc_release_mutex(&pthr->mutex);
+    return;
+  }
+
+  for (pnode = pthr->current; NULL != pnode->parent;
+       pnode = pnode->parent) {
+    if (0 == strcmp(pnode->name, name)) {
+      break;
+    }
+  }
+  if (NULL == pnode->parent) {
+    /* Not open; the profiler was probably switched on inside it. */
+    fc_release_mutex(&pthr->mutex);
+    return;
+  }
+
+  now = profile_now();
+  do {
+    pthr->depth--;
+    pthr->current->seconds += now - pthr->start[pthr->depth];
+    pthr->current->count++;
+    pthr->current = pthr->current->parent;
+  } while (pthr->current != pnode->parent);
+  fc_release_mutex(&pthr->mutex);
+}
+
+/********************************************************************** 
+  Write the folded stacks of the subtree 'pnode' to the profile file and
+  clear its times. 'stack' holds the names of the parents.
+***********************************************************************/
+static void profile_node_write(struct profile_node *pnode,
+                               char *stack, size_t stack_size)
+{
+  struct profile_node *pchild;
+  size_t len = strlen(stack);
+  double self = pnode->seconds;
+  char *p;
+
+  cat_snprintf(stack, stack_size, ";%s", pnode->name);
+  /* Zone names may come from the game (e.g. player names); keep them
+   * from breaking the format. */
+  for (p = stack + len; '\0' != *p; p++) {
+    if (p > stack + len && (';' == *p || fc_isspace(*p))) {
+      *p = '_';
+    }
+  }
+  for (pchild = pnode->child; NULL != pchild; pchild = pchild->sibling) {
+    self -= pchild->seconds;
+    profile_node_write(pchild, stack, stack_size);
+  }
+  if (self * N_USEC_PER_SEC >= 1.0) {
+    fprintf(profile_file, "%s %.0f\n", stack, self * N_USEC_PER_SEC);
+  }
+  stack[len] = '\0';
+
+  pnode->seconds = 0.0;
+  pnode->count = 0;
+}
+
+/********************************************************************** 
+  Write what was recorded since the last call to the profile file, with
+  'frame' as the outermost frame of every stack (e.g. "T12" for turn 12),
+  and start over. Time spent in zones still open is written the next
+  time.
+***********************************************************************/
+void profile_flush(const char *frame)
+{
+  struct profile_thread *pthr;
+  char stack[4096];
+
+  if (NULL == profile_file) {
+    return;
+  }
+
+  for (pthr = profile_threads; NULL != pthr; pthr = pthr->next) {
+    struct profile_node *pnode;
+
+    fc_allocate_mutex(&pthr->mutex);
+    for (pnode = pthr->root.child; NULL != pnode; pnode = pnode->sibling) {
+      fc_snprintf(stack, sizeof(stack), "%s;thread%d", frame, pthr->id);
+      profile_node_write(pnode, stack, sizeof(stack));
+    }
+    fc_release_mutex(&pthr->mutex);
+  }
+  fflush(profile_file);
+}
+
+/********************************************************************** 
+  Switch the profiler on, writing to 'filename'. Returns FALSE if the
+  file cannot be opened.
+***********************************************************************/
+bool profile_start(const char *filename)
+{
+  struct profile_thread *pthr;
+
+  profile_stop();
+
+  profile_file = fc_fopen(filename, "w");
+  if (NULL == profile_file) {
+    return FALSE;
+  }
+
+  /* Forget the zones open in the threads; they will not be closed. */
+  for (pthr = profile_threads; NULL != pthr; pthr = pthr->next) {
+    fc_allocate_mutex(&pthr->mutex);
+    pthr->current = &pthr->root;
+    pthr->depth = 0;
+    fc_release_mutex(&pthr->mutex);
+  }
+
+  profile_enabled = TRUE;
+
+  return TRUE;
+}
+
+/********************************************************************** 
+  Switch the profiler off. Anything not flushed yet is lost.
+***********************************************************************/
+void profile_stop(void)
+{
+  profile_enabled = FALSE;
+
+  if (NULL != profile_file) {
+    fclose(profile_file);
+    profile_file = NULL;
+  }
+}
+
+/********************************************************************** 
+  Free the zones recorded below 'pnode', and 'pnode' itself unless it
+  is the root of a thread.
+***********************************************************************/
+static void profile_node_free(struct profile_node *pnode)
+{
+  while (NULL != pnode->child) {
+    struct profile_node *pchild = pnode->child;
+
+    pnode->child = pchild->sibling;
+    profile_node_free(pchild);
+  }
+
+  if (NULL != pnode->parent) {
+    free(pnode->name);
+    free(pnode);
+  }
+}
+
+/********************************************************************** 
+  Switch the profiler off and free everything it recorded. No other
+  thread may use the profiler any more.
+***********************************************************************/
+void profile_free(void)
+{
+  profile_stop();
+
+  while (NULL != profile_threads) {
+    struct profile_thread *pthr = profile_threads;
+
+    profile_threads = pthr->next;
+    profile_node_free(&pthr->root);
+    fc_destroy_mutex(&pthr->mutex);
+    free(pthr);
+  }
+  profile_thread_count = 0;
+
+#ifdef HAVE_PTHREAD
+  pthread_once(&profile_key_once, profile_key_init);
+  pthread_setspecific(profile_key, NULL);
+#endif
+}
+
+/********************************************************************** 
+  Returns whether the profiler is writing to a file.
+***********************************************************************/
+bool profile_running(void)
+{
+  return NULL != profile_file;
+}
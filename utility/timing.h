@@ -84,6 +84,59 @@ double timer_read_seconds(struct timer *t);
 
 void timer_usleep_since_start(struct timer *t, long usec);
 
+/* Event counters, read by the server's performance log. They are only
+   counted while enabled, and each thread counts on its own; see
+   timing.c. */
+enum perf_counter {
+  PERF_ALLOCS,                  /* fc_malloc() and friends */
+  PERF_CM_QUERIES,              /* cm_query_result() */
+  PERF_CM_CACHE_HITS,           /* ... answered from stored results */
+  PERF_PF_MAPS,                 /* pf_map_new() */
+  PERF_PACKETS,                 /* send_packet_data() */
+  PERF_PACKET_BYTES,
+  PERF_LAST
+};
+
+extern bool perf_counters_enabled;
+
+void perf_counters_init(void);
+void perf_counters_enable(bool enable);
+void perf_count(enum perf_counter which, unsigned long n);
+void perf_counters_read(unsigned long *counters);
+
+#define PERF_COUNT(_which_, _n_)                                           \
+  do {                                                                      \
+    if (perf_counters_enabled) {                                            \
+      perf_count(_which_, _n_);                                             \
+    }                                                                       \
+  } while (FALSE)
+
+/* Zone profiler, see timing.c */
+extern bool profile_enabled;
+
+#define PROFILE_ZONE_START(_name_)                                         \
+  do {                                                                      \
+    if (profile_enabled) {                                                  \
+      profile_zone_start(_name_);                                           \
+    }                                                                       \
+  } while (FALSE)
+
+#define PROFILE_ZONE_STOP(_name_)                                          \
+  do {                                                                      \
+    if (profile_enabled) {                                                  \
+      profile_zone_stop(_name_);                                            \
+    }                                                                       \
+  } while (FALSE)
+
+void profile_zone_start(const char *name);
+void profile_zone_stop(const char *name);
+
+bool profile_start(const char *filename);
+void profile_stop(void);
+bool profile_running(void);
+void profile_flush(const char *frame);
+void profile_free(void);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */